@@ -5,6 +5,7 @@ import io
 import collections
 import copy
 import functools
+import os
 import re
 import sys
 import copy
@@ -1100,3 +1101,46 @@ def python_interface(fn):
         results = fn(params, results)
         return results.return_direct_results_dict()
     return wrapper
+
+def run_persistent_driver(fn, fd=None):
+    """Serve evaluation requests from a Dakota fork interface with
+    persistent_driver.
+
+    Reads requests from Dakota until it closes the connection. For each
+    request, changes to the evaluation's working directory and calls
+    fn(parameters_file, results_file), which must write the results file.
+
+    Arguments:
+        fn: Callable taking the parameters and results file names. It may
+            return an integer status; None is treated as 0, and -1 aborts
+            Dakota.
+
+    Keyword Args:
+        fd: Descriptor of the connection to Dakota. If not provided, it is
+            read from the DAKOTA_PERSISTENT_DRIVER_FD environment variable.
+
+    Raises:
+        dakota.interfacing.MissingSourceError: No descriptor was provided and
+            DAKOTA_PERSISTENT_DRIVER_FD is not set.
+    """
+    if fd is None:
+        try:
+            fd = int(os.environ["DAKOTA_PERSISTENT_DRIVER_FD"])
+        except KeyError:
+            raise MissingSourceError("No connection descriptor provided and "
+                    "DAKOTA_PERSISTENT_DRIVER_FD is not set.")
+    startup_dir = os.getcwd()
+    conn = io.open(fd, "rb", buffering=0, closefd=False)
+    while True:
+        request = [conn.readline() for i in range(3)]
+        if not request[-1].endswith(b"\n"):
+            break # Dakota closed the connection
+        work_dir, parameters_file, results_file = \
+                [line[:-1].decode("utf-8") for line in request]
+        os.chdir(work_dir)
+        try:
+            status = fn(parameters_file, results_file)
+        finally:
+            os.chdir(startup_dir)
+        reply = "{0:d}\n".format(0 if status is None else status)
+        os.write(fd, reply.encode("utf-8"))
@@ -16,6 +16,13 @@
 #include "ParamResponsePair.hpp"
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <limits>
 
 //#define DEBUG
 
@@ -52,6 +59,8 @@ ApplicationInterface(const ProblemDescDB& problem_db):
   lenVarsMessage(0), lenVarsActSetMessage(0), lenResponseMessage(0),
   lenPRPairMessage(0),
   evalScheduling(problem_db.get_short("interface.evaluation_scheduling")),
+  evalPrefetchSpec(problem_db.get_int("interface.evaluation_prefetch")),
+  evalPrefetch(0),
   analysisScheduling(problem_db.get_short("interface.analysis_scheduling")),
   asynchLocalEvalStatic(
     problem_db.get_short("interface.local_evaluation_scheduling") ==
@@ -215,6 +224,21 @@ set_evaluation_communicators(const IntArray& message_lengths)
   // user spec > 1).
   asynchLocalEvalConcurrency = (ieMessagePass && asynchLocalEvalConcSpec == 0)
                              ? 1 : asynchLocalEvalConcSpec;
+
+  // The prefetch schedule requires a dedicated master.  Queued jobs are
+  // executed one at a time on multiprocessor servers, since asynchronous
+  // local evaluations cannot share an evalComm in this schedule.  Every
+  // processor resolves the same setting, so that master and servers agree
+  // on the message format.
+  evalPrefetch = 0;
+  if (evalPrefetchSpec && ieMessagePass) {
+    if (ieDedMasterFlag && !(multiProcEvalFlag && asynchLocalEvalConcurrency>1))
+      evalPrefetch = evalPrefetchSpec;
+    else if (iteratorCommRank == 0)
+      Cerr << "Warning: evaluation prefetch requires a dedicated master "
+	   << "schedule and is not supported for asynchronous "
+	   << "multiprocessor evaluations; ignoring prefetch." << std::endl;
+  }
 }
 
 
@@ -525,7 +549,8 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	  // manage shallow/deep copy of vars/response with evalCacheFlag
 	  ParamResponsePair prp(vars, interfaceId, core_resp, currEvalId,
 				evalCacheFlag);
-	  if (evalCacheFlag)   data_pairs.insert(prp);
+	  if (evalCacheFlag)
+	    { data_pairs.insert(prp); nearbyGrid.insert(prp); }
 	  if (restartFileFlag) parallelLib.write_restart(prp);
 	}
       }
@@ -612,15 +637,22 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
   //   requiring an additional test to prefer positive id's in some use cases).
   PRPCacheOIter ord_it; PRPCacheHIter hash_it;
   ParamResponsePair cache_pr; int cache_eval_id; bool cache_hit = false;
-  if (nearbyDuplicateDetect) { // slow but allows tolerance on equality
-    ord_it = lookup_by_nearby_val(data_pairs, interfaceId, vars,
-				  response.active_set(), nearbyTolerance);
+  if (nearbyDuplicateDetect) { // allows tolerance on equality
+    if (!nearbyGrid.built()) // deferred until tolerance lookups are needed
+      nearbyGrid.build(data_pairs, interfaceId, nearbyTolerance);
+    ord_it = nearbyGrid.lookup(data_pairs, interfaceId, vars,
+			       response.active_set());
     cache_hit = (ord_it != data_pairs.end());
+    ++nearbyLookupCntr;
     if (cache_hit) { // ordered-specific updates (shared updates below)
+      if (ord_it->variables() != vars)
+	++nearbyHitCntr;
       response.update(ord_it->response(), true); // update metadata
       cache_eval_id = ord_it->eval_id();
-      if (cache_eval_id <= 0)
-	{ cache_pr = *ord_it; data_pairs.erase(ord_it); }
+      if (cache_eval_id <= 0) {
+	cache_pr = *ord_it; data_pairs.erase(ord_it);
+	nearbyGrid.erase(cache_pr);
+      }
     }
   }
   else { // fast but requires exact binary match
@@ -635,10 +667,12 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
     }
   }
   if (cache_hit) { // updates shared among ordered/hashed lookups
+    ++cacheHitCntr;
     if (cache_eval_id <= 0) {
       // ordered key is const; must remove (above) & change/add (below)
       cache_pr.eval_id(evalIdCntr); // promote
       data_pairs.insert(cache_pr);  // shallow copy of previous vars/resp
+      nearbyGrid.insert(cache_pr);
     }
 
     if (asynch_flag) // asynch case: bookkeep
@@ -646,6 +680,7 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
 
     return true; // Duplication detected
   }
+  ++cacheMissCntr;
 
   // check beforeSynchCorePRPQueue as well (if asynchronous and no cache hit)
   if (asynch_flag) {
@@ -736,7 +771,10 @@ const IntResponseMap& ApplicationInterface::synchronize()
     // asynchronous case.
     if (core_prp_jobs) {
       if (ieMessagePass) { // single or multi-processor servers
-	if (ieDedMasterFlag) master_dynamic_schedule_evaluations();
+	if (ieDedMasterFlag) {
+	  if (evalPrefetch) master_dynamic_schedule_evaluations_prefetch();
+	  else              master_dynamic_schedule_evaluations();
+	}
 	else {
 	  // utilize asynch local evals to accomplish a dynamic peer schedule
 	  // (even if hybrid mode not specified) unless precluded by direct
@@ -846,8 +884,16 @@ const IntResponseMap& ApplicationInterface::synchronize_nowait()
     // Test nonduplicate evaluations and add completions to rawResponseMap
     if (core_prp_jobs) {
       if (ieMessagePass) { // single or multi-processor servers
-	if (ieDedMasterFlag)
+	if (ieDedMasterFlag) {
+	  // prefetch servers expect combined job messages, which are not
+	  // supported by the nonblocking scheduler
+	  if (evalPrefetch) {
+	    Cerr << "Error: evaluation prefetch is not supported for "
+		 << "nonblocking synchronization." << std::endl;
+	    abort_handler(-1);
+	  }
 	  master_dynamic_schedule_evaluations_nowait();
+	}
 	else {
 	  // prefer to use peer_dynamic to avoid blocking on local jobs, as
 	  // is consistent with nowait requirement; however, a fallback to
@@ -1044,6 +1090,135 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
   delete [] recvRequests; recvRequests = NULL;
 }
 
+/** This code is called from synchronize() in place of
+    master_dynamic_schedule_evaluations() when evaluation prefetch is
+    active, and matches serve_evaluations_prefetch() on the slave
+    servers.  It reduces the message traffic handled by the master in
+    two ways.  All jobs assigned to a server at one time are packed into
+    a single message, and each server returns its completed jobs
+    together.  In addition, each server holds a queue of jobs beyond its
+    concurrency, so that it can continue with queued jobs while the
+    master processes its previous results.  The queue depth adapts to
+    the remaining work: whenever a server is refilled, its queue is
+    extended beyond its concurrency by its share of the unassigned jobs,
+    up to the prefetch limit.  Queues are therefore deep while many jobs
+    remain and shrink to the server concurrency at the end of the
+    schedule, where deep queues would unbalance the servers.  Jobs are
+    dispatched in order of decreasing expected run time (see
+    longest_first_order()), which further reduces idle time at the end
+    of the schedule.  One receive per server is kept posted for its
+    results and at most one send per server is in flight, so that the
+    master only waits on message completions. */
+void ApplicationInterface::master_dynamic_schedule_evaluations_prefetch()
+{
+  int concurrency = std::max(1, asynchLocalEvalConcurrency),
+      num_jobs    = beforeSynchCorePRPQueue.size(), depth;
+
+  std::vector<PRPQueueIter> dispatch_order;
+  longest_first_order(dispatch_order);
+
+  Cout << "Master dynamic schedule: assigning " << num_jobs << " jobs among "
+       << numEvalServers << " servers with prefetch of up to " << evalPrefetch
+       << " jobs\n";
+
+  // recvRequests holds the result receives from each server, followed by
+  // the job sends to each server
+  int i, s, server_id, num_requests = 2*numEvalServers, len_jobs, len_results;
+  prefetch_message_lengths(len_jobs, len_results);
+  sendBuffers  = new MPIPackBuffer   [numEvalServers];
+  recvBuffers  = new MPIUnpackBuffer [numEvalServers];
+  recvRequests = new MPI_Request     [num_requests];
+  for (i=0; i<num_requests; ++i)
+    recvRequests[i] = MPI_REQUEST_NULL;
+  for (s=0; s<numEvalServers; ++s)
+    recvBuffers[s].resize(len_results);
+
+  // fill the queue of each server
+  IntArray server_load(numEvalServers, 0);
+  size_t next_job = 0;
+  int num_send;
+  for (s=0; s<numEvalServers && next_job < (size_t)num_jobs; ++s) {
+    server_id = s + 1; // from 1 to numEvalServers
+    depth     = concurrency +
+      std::min(evalPrefetch, (num_jobs - (int)next_job) / numEvalServers);
+    num_send  = std::min(depth, num_jobs - (int)next_job);
+    send_evaluations(dispatch_order, next_job, num_send, server_id,
+		     recvRequests[numEvalServers+s]);
+    server_load[s] = num_send;
+    parallelLib.irecv_ie(recvBuffers[s], server_id, MPI_ANY_TAG,
+			 recvRequests[s]);
+  }
+
+  // process returned results and refill server queues
+  MPI_Status* status_array = new MPI_Status [num_requests];
+  int* index_array = new int [num_requests];
+  int recv_cntr = 0, out_count, index, num_results, fn_eval_id;
+  Real run_time;
+  PRPQueueIter return_iter;
+  while (recv_cntr < num_jobs) {
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << "Master dynamic schedule: waiting on completed jobs"<<std::endl;
+    parallelLib.waitsome(num_requests, recvRequests, out_count, index_array,
+			 status_array);
+    for (i=0; i<out_count; ++i) {
+      index = index_array[i];
+      if (index < numEvalServers) { // combined results returned by server
+	s = index; server_id = s + 1;
+	MPIUnpackBuffer& recv_buffer = recvBuffers[s];
+	recv_buffer >> num_results;
+	for (int r=0; r<num_results; ++r) {
+	  recv_buffer >> fn_eval_id >> run_time;
+	  return_iter = lookup_by_eval_id(beforeSynchCorePRPQueue, fn_eval_id);
+	  if (return_iter == beforeSynchCorePRPQueue.end()) {
+	    Cerr << "Error: failure in queue lookup within ApplicationInterface"
+		 << "::master_dynamic_schedule_evaluations_prefetch()."
+		 << std::endl;
+	    abort_handler(-1);
+	  }
+	  update_runtime_history(return_iter->active_set(), run_time);
+	  receive_evaluation(return_iter, recv_buffer, server_id, false);//!peer
+	}
+	recv_buffer.reset();
+	recv_cntr += num_results; server_load[s] -= num_results;
+	// repost before any wait on the send to this server (the server may
+	// block in its send of further results)
+	if (server_load[s])
+	  parallelLib.irecv_ie(recv_buffer, server_id, MPI_ANY_TAG,
+			       recvRequests[s]);
+      }
+      else // send buffer of server s is free for reuse
+	{ s = index - numEvalServers; server_id = s + 1; }
+
+      // refill the queue of server s once its previous jobs have been sent
+      if (next_job == (size_t)num_jobs ||
+	  recvRequests[numEvalServers+s] != MPI_REQUEST_NULL)
+	continue;
+      depth = concurrency +
+	std::min(evalPrefetch, (num_jobs - (int)next_job) / numEvalServers);
+      if (server_load[s] < depth) {
+	num_send = std::min(depth - server_load[s], num_jobs - (int)next_job);
+	send_evaluations(dispatch_order, next_job, num_send, server_id,
+			 recvRequests[numEvalServers+s]);
+	if (!server_load[s])
+	  parallelLib.irecv_ie(recvBuffers[s], server_id, MPI_ANY_TAG,
+			       recvRequests[s]);
+	server_load[s] += num_send;
+      }
+    }
+  }
+  // all results have been received, so only completed sends that have not
+  // been reported by waitsome may remain prior to buffer deallocation
+  parallelLib.waitall(num_requests, recvRequests);
+  delete [] status_array;
+  delete [] index_array;
+
+  // deallocate MPI & buffer arrays
+  delete [] sendBuffers;   sendBuffers = NULL;
+  delete [] recvBuffers;   recvBuffers = NULL;
+  delete [] recvRequests; recvRequests = NULL;
+}
+
+
 
 /** This code runs on the iteratorCommRank 0 processor (the iterator) and is
     called from synchronize() in order to manage a static schedule for cases
@@ -2148,8 +2323,8 @@ broadcast_evaluation(int fn_eval_id, const Variables& vars,
 
 /** Invoked by the serve() function in derived Model classes.  Passes
     control to serve_evaluations_synch(), serve_evaluations_asynch(),
-    serve_evaluations_synch_peer(), or serve_evaluations_asynch_peer()
-    according to specified concurrency, partition, and scheduler
+    serve_evaluations_synch_peer(), serve_evaluations_asynch_peer(), or
+    serve_evaluations_prefetch() according to specified concurrency, partition, and scheduler
     configuration. */
 void ApplicationInterface::serve_evaluations()
 {
@@ -2167,7 +2342,13 @@ void ApplicationInterface::serve_evaluations()
   // since evalCommRank 0 is running the iterator/job schedulers
   bool peer_server1 = (!ieDedMasterFlag && evalServerId == 1);
 
-  if (asynchLocalEvalConcurrency > 1) {
+  if (evalPrefetch) {
+    // other processors in a multiprocessor server follow the local leader's
+    // bcasts of each queued job, as for the peer 1 partition
+    if (evalCommRank == 0) serve_evaluations_prefetch();
+    else                   serve_evaluations_synch_peer();
+  }
+  else if (asynchLocalEvalConcurrency > 1) {
     if (peer_server1) serve_evaluations_asynch_peer();
     else              serve_evaluations_asynch();
   }
@@ -2475,6 +2656,138 @@ void ApplicationInterface::serve_evaluations_asynch_peer()
 }
 
 
+/** This code is invoked by serve_evaluations() on the local leader of
+    each server when evaluation prefetch is active, and matches
+    master_dynamic_schedule_evaluations_prefetch().  Each incoming
+    message may hold several jobs, which are appended to a local queue
+    and executed in order: one at a time using derived_map(), or up to
+    asynchLocalEvalConcurrency at a time using derived_map_asynch().
+    Completed jobs are returned to the master in a single message,
+    together with their run times, once half of the jobs held by the
+    server have completed or no queued job remains.  This gives the
+    master time to refill the queue before the server runs out of work.
+    Incoming messages are tested between jobs, and the server blocks on
+    a receive only when it holds no jobs.  For multiprocessor servers,
+    each job is broadcast to the other processors, which execute
+    serve_evaluations_synch_peer(). */
+void ApplicationInterface::serve_evaluations_prefetch()
+{
+  int len_jobs, len_results;
+  prefetch_message_lengths(len_jobs, len_results);
+  MPIUnpackBuffer recv_buffer(len_jobs);
+  MPIPackBuffer   send_buffer(len_results);
+  MPI_Status  status;
+  MPI_Request recv_request;
+  parallelLib.irecv_ie(recv_buffer, 0, MPI_ANY_TAG, recv_request);
+
+  typedef std::chrono::steady_clock Clock;
+  std::deque<ParamResponsePair>  queued_jobs;
+  std::map<int, Clock::time_point> start_times; // active asynch local jobs
+  std::vector<ParamResponsePair> completed_jobs;
+  RealArray run_times;
+  bool asynch_local = (asynchLocalEvalConcurrency > 1);
+  int i, num_jobs, tag = 1, num_active = 0, mpi_test_flag;
+  currEvalId = 1;
+  while (tag) { // tag = 0 is the termination signal
+
+    // receive any new jobs, blocking only when the server holds no jobs
+    // (completed jobs are always returned once no queued job remains)
+    mpi_test_flag = 1;
+    while (mpi_test_flag) {
+      if (queued_jobs.empty() && !num_active)
+	parallelLib.wait(recv_request, status);
+      else
+	parallelLib.test(recv_request, mpi_test_flag, status);
+      if (mpi_test_flag) {
+	tag = status.MPI_TAG;
+	if (!tag) break;
+	recv_buffer >> num_jobs;
+	for (i=0; i<num_jobs; ++i) {
+	  int fn_eval_id; Variables vars; ActiveSet set;
+	  recv_buffer >> fn_eval_id >> vars >> set;
+	  Response local_response(sharedRespData, set); // special ctor
+	  queued_jobs.push_back(ParamResponsePair(vars, interfaceId,
+	    local_response, fn_eval_id, false)); // shallow copy
+	}
+	recv_buffer.reset();
+	parallelLib.irecv_ie(recv_buffer, 0, MPI_ANY_TAG, recv_request);
+      }
+    }
+
+    // execute queued jobs
+    if (asynch_local) {
+      while (!queued_jobs.empty() && num_active < asynchLocalEvalConcurrency) {
+	ParamResponsePair& prp = queued_jobs.front();
+	start_times[prp.eval_id()] = Clock::now();
+	asynchLocalActivePRPQueue.insert(prp);
+	derived_map_asynch(prp);
+	queued_jobs.pop_front(); ++num_active;
+      }
+      if (num_active) {
+	completionSet.clear();
+	test_local_evaluations(asynchLocalActivePRPQueue);//rebuilds completionSet
+	for (ISCIter id_iter = completionSet.begin();
+	     id_iter != completionSet.end(); ++id_iter) {
+	  PRPQueueIter q_it
+	    = lookup_by_eval_id(asynchLocalActivePRPQueue, *id_iter);
+	  if (q_it == asynchLocalActivePRPQueue.end()) {
+	    Cerr << "Error: failure in queue lookup within ApplicationInterface"
+		 << "::serve_evaluations_prefetch()." << std::endl;
+	    abort_handler(-1);
+	  }
+	  std::map<int, Clock::time_point>::iterator t_it
+	    = start_times.find(*id_iter);
+	  run_times.push_back(
+	    std::chrono::duration<Real>(Clock::now() - t_it->second).count());
+	  start_times.erase(t_it);
+	  completed_jobs.push_back(*q_it);
+	  asynchLocalActivePRPQueue.erase(q_it); --num_active;
+	}
+      }
+    }
+    else if (!queued_jobs.empty()) {
+      ParamResponsePair& prp = queued_jobs.front();
+      currEvalId = prp.eval_id();
+      const Variables& vars = prp.variables();
+      const ActiveSet& set  = prp.active_set();
+      Response local_response(prp.response()); // shared rep
+      if (multiProcEvalFlag) // match bcasts in serve_evaluations_synch_peer()
+	broadcast_evaluation(prp);
+      Clock::time_point start = Clock::now();
+      try { derived_map(vars, set, local_response, currEvalId); }//synch local
+      catch(const FunctionEvalFailure& fneval_except) {
+	manage_failure(vars, set, local_response, currEvalId);
+      }
+      run_times.push_back(
+	std::chrono::duration<Real>(Clock::now() - start).count());
+      completed_jobs.push_back(prp);
+      queued_jobs.pop_front();
+    }
+
+    // return completed jobs.  As in serve_evaluations_asynch(), use a
+    // blocking send; the master keeps a receive posted for each server
+    // that holds jobs.
+    size_t num_completed = completed_jobs.size(),
+      num_held = queued_jobs.size() + num_active + num_completed;
+    if (num_completed && (queued_jobs.empty() || 2*num_completed >= num_held)){
+      send_buffer.reset();
+      num_jobs = num_completed;
+      send_buffer << num_jobs;
+      for (i=0; i<num_jobs; ++i)
+	send_buffer << completed_jobs[i].eval_id() << run_times[i]
+		    << completed_jobs[i].response();
+      parallelLib.send_ie(send_buffer, 0, completed_jobs[0].eval_id());
+      completed_jobs.clear(); run_times.clear();
+    }
+  }
+
+  if (multiProcEvalFlag) { // stop serve_evaluations_synch_peer() procs
+    int fn_eval_id = 0;
+    parallelLib.bcast_e(fn_eval_id);
+  }
+}
+
+
 /** This code is executed on the iteratorComm rank 0 processor when
     iteration on a particular model is complete.  It sends a
     termination signal (tag = 0 instead of a valid fn_eval_id) to each
@@ -2681,6 +2994,71 @@ void ApplicationInterface::serve_analyses_synch()
 }
 
 
+// -----------------------------------------
+// Threaded evaluations within a process
+// -----------------------------------------
+/** Used by interfaces whose derived_map() holds no per-evaluation
+    state in class scope (e.g., PluginInterface), so that cheap
+    in-process simulations can occupy all cores of a node without
+    fork or MPI overhead.  Worker threads claim jobs from a shared
+    counter, so long and short evaluations balance dynamically.
+    Failures are collected on the workers and processed afterwards by
+    manage_failure() on the calling thread, as for other asynchronous
+    local evaluations.  A max_threads of 1 evaluates the jobs in turn
+    on the calling thread, e.g., for a derived_map() that is not
+    thread safe. */
+void ApplicationInterface::
+thread_local_evaluations(PRPQueue& prp_queue, size_t max_threads)
+{
+  size_t j, num_jobs = prp_queue.size();
+  if (!num_jobs) return;
+
+  // asynchLocalEvalConcurrency of 0 denotes unlimited; cap at the
+  // thread budget of this process (see dakota::util::thread_budget())
+  size_t num_threads = (asynchLocalEvalConcurrency > 0) ?
+    std::min((size_t)asynchLocalEvalConcurrency, num_jobs) :
+    dakota::util::num_threads(num_jobs, num_jobs, 1);
+  num_threads = std::min(num_threads, max_threads);
+
+  std::vector<PRPQueueIter> jobs; jobs.reserve(num_jobs);
+  for (PRPQueueIter prp_it=prp_queue.begin(); prp_it!=prp_queue.end(); ++prp_it)
+    jobs.push_back(prp_it);
+
+  BoolDeque eval_failed(num_jobs, false); // concurrent writes: no vector<bool>
+  std::vector<std::exception_ptr> eval_except(num_jobs);
+  std::atomic<size_t> next_job(0);
+  auto run_jobs = [&](size_t) {
+    for (size_t k = next_job++; k < num_jobs; k = next_job++) {
+      const ParamResponsePair& pair = *jobs[k];
+      // shallow copy: populates the Response rep shared with the queue
+      Response response = pair.response();
+      try { derived_map(pair.variables(), pair.active_set(), response,
+			pair.eval_id()); }
+      catch (const FunctionEvalFailure& fneval_except)
+	{ eval_failed[k] = true; }
+      catch (...)
+	{ eval_except[k] = std::current_exception(); }
+    }
+  };
+
+  // the calling thread participates as one of the workers
+  dakota::util::run_threads(num_threads, run_jobs);
+
+  for (j=0; j<num_jobs; ++j) {
+    if (eval_except[j])
+      std::rethrow_exception(eval_except[j]);
+    const ParamResponsePair& pair = *jobs[j];
+    int fn_eval_id = pair.eval_id();
+    if (eval_failed[j]) {
+      Response response = pair.response();
+      manage_failure(pair.variables(), response.active_set(), response,
+		     fn_eval_id);
+    }
+    completionSet.insert(fn_eval_id);
+  }
+}
+
+
 // -----------------------------------------
 // Routines for managing simulation failures
 // -----------------------------------------
@@ -2913,6 +3291,19 @@ continuation(const Variables& target_vars, const ActiveSet& set,
 void ApplicationInterface::
 receive_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
                    bool peer_flag)
+{
+#ifdef MPI_DEBUG
+  Cout << "receive_evaluation() buff_index = " << buff_index << " fn_eval_id = "
+       << prp_it->eval_id() << " server_id = " << server_id << std::endl;
+#endif // MPI_DEBUG
+
+  receive_evaluation(prp_it, recvBuffers[buff_index], server_id, peer_flag);
+}
+
+
+void ApplicationInterface::
+receive_evaluation(PRPQueueIter& prp_it, MPIUnpackBuffer& recv_buffer,
+		   int server_id, bool peer_flag)
 {
   int fn_eval_id = prp_it->eval_id();
   if (outputLevel > SILENT_OUTPUT) {
@@ -2923,27 +3314,117 @@ receive_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
     else           Cout << "slave server " << server_id << '\n';
   }
 
-#ifdef MPI_DEBUG
-  Cout << "receive_evaluation() buff_index = " << buff_index << " fn_eval_id = "
-       << fn_eval_id << " server_id = " << server_id << std::endl;
-#endif // MPI_DEBUG
-
   // Process incoming buffer from remote server.  Avoid multiple key-value
   // lookups.  Incoming response is a lightweight constructed response
   // corresponding to a particular ActiveSet.
   Response remote_response;
-  recvBuffers[buff_index] >> remote_response; // lightweight response
+  recv_buffer >> remote_response; // lightweight response
   // share the rep among between rawResponseMap and the processing queue, but
   // don't trample raw response sizing with lightweight remote response
   Response raw_response = rawResponseMap[fn_eval_id] = prp_it->response();
   raw_response.update(remote_response, true); // update metadata
 
   // insert into restart and eval cache ASAP
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)
+    { data_pairs.insert(*prp_it); nearbyGrid.insert(*prp_it); }
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
 
+void ApplicationInterface::
+send_evaluations(const std::vector<PRPQueueIter>& dispatch_order,
+		 size_t& next_job, int num_send, int server_id,
+		 MPI_Request& send_request)
+{
+  MPIPackBuffer& send_buffer = sendBuffers[server_id-1];
+  send_buffer.reset();
+  send_buffer << num_send;
+
+  if (outputLevel > SILENT_OUTPUT) {
+    Cout << "Master assigning ";
+    if (!(interfaceId.empty() || interfaceId == "NO_ID"))
+      Cout << interfaceId << ' ';
+    Cout << ((num_send > 1) ? "evaluations" : "evaluation");
+  }
+  // the message tag is the first evaluation id, since tag 0 terminates
+  int first_eval_id = dispatch_order[next_job]->eval_id();
+  for (int i=0; i<num_send; ++i, ++next_job) {
+    const PRPQueueIter& prp_it = dispatch_order[next_job];
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << ' ' << prp_it->eval_id();
+    send_buffer << prp_it->eval_id() << prp_it->variables()
+		<< prp_it->active_set();
+  }
+  if (outputLevel > SILENT_OUTPUT)
+    Cout << " to server " << server_id << '\n';
+
+  // nonblocking send: completion is tested within the scheduler's waitsome
+  parallelLib.isend_ie(send_buffer, server_id, first_eval_id, send_request);
+}
+
+
+/** Jobs are ordered by the mean run time recorded for their active set
+    request vector, so that evaluations including gradients or Hessians
+    are started ahead of value-only evaluations when they take longer.
+    Jobs with a request vector that has no history yet are started first,
+    and the order of beforeSynchCorePRPQueue (evaluation id) is otherwise
+    retained. */
+void ApplicationInterface::
+longest_first_order(std::vector<PRPQueueIter>& dispatch_order)
+{
+  dispatch_order.clear();
+  dispatch_order.reserve(beforeSynchCorePRPQueue.size());
+  for (PRPQueueIter prp_it = beforeSynchCorePRPQueue.begin();
+       prp_it != beforeSynchCorePRPQueue.end(); ++prp_it)
+    dispatch_order.push_back(prp_it);
+  if (evalRuntimeHistory.empty())
+    return;
+
+  std::vector<std::pair<Real, PRPQueueIter> > expected;
+  expected.reserve(dispatch_order.size());
+  for (size_t i=0; i<dispatch_order.size(); ++i) {
+    std::map<ShortArray, RealRealPair>::const_iterator h_it
+      = evalRuntimeHistory.find(dispatch_order[i]->active_set().
+				request_vector());
+    Real run_time = (h_it == evalRuntimeHistory.end()) ?
+      std::numeric_limits<Real>::infinity() : h_it->second.second;
+    expected.push_back(std::make_pair(run_time, dispatch_order[i]));
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+    [](const std::pair<Real, PRPQueueIter>& a,
+       const std::pair<Real, PRPQueueIter>& b) { return a.first > b.first; });
+  for (size_t i=0; i<expected.size(); ++i)
+    dispatch_order[i] = expected[i].second;
+}
+
+
+void ApplicationInterface::
+update_runtime_history(const ActiveSet& set, Real run_time)
+{
+  RealRealPair& history = evalRuntimeHistory[set.request_vector()];
+  history.first  += 1.;
+  history.second += (run_time - history.second) / history.first;//running mean
+}
+
+
+void ApplicationInterface::
+prefetch_message_lengths(int& len_jobs, int& len_results)
+{
+  // a message holds a job count followed by at most a full server queue of
+  // jobs, each preceded by its evaluation id (and run time for results)
+  MPIPackBuffer len_buffer;
+  int count = 0; Real run_time = 0.;
+  len_buffer << count;
+  int len_int = len_buffer.size();
+  len_buffer.reset();
+  len_buffer << run_time;
+  int len_real = len_buffer.size(),
+    max_jobs = std::max(1, asynchLocalEvalConcurrency) + evalPrefetch;
+  len_jobs    = len_int + max_jobs * (len_int + lenVarsActSetMessage);
+  len_results = len_int + max_jobs * (len_int + len_real + lenResponseMessage);
+}
+
+
 void ApplicationInterface::process_asynch_local(int fn_eval_id)
 {
   PRPQueueIter prp_it
@@ -2963,7 +3444,8 @@ void ApplicationInterface::process_asynch_local(int fn_eval_id)
   }
 
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)
+    { data_pairs.insert(*prp_it); nearbyGrid.insert(*prp_it); }
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 
   asynchLocalActivePRPQueue.erase(prp_it);
@@ -2984,7 +3466,8 @@ void ApplicationInterface::process_synch_local(PRPQueueIter& prp_it)
     Cout << "evaluation " << fn_eval_id << std::endl;
   }
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)
+    { data_pairs.insert(*prp_it); nearbyGrid.insert(*prp_it); }
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
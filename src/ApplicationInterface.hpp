@@ -102,6 +102,13 @@ protected:
   void manage_failure(const Variables& vars, const ActiveSet& set,
 		      Response& response, int failed_eval_id);
 
+  /// evaluates all jobs in prp_queue concurrently on a pool of at most
+  /// max_threads local threads sized by asynchLocalEvalConcurrency;
+  /// requires a reentrant derived_map() unless max_threads is 1, and
+  /// rebuilds completionSet
+  void thread_local_evaluations(PRPQueue& prp_queue,
+				size_t max_threads = SZ_MAX);
+
   /// executes a blocking schedule for asynchronous evaluations in the
   /// beforeSynchCorePRPQueue and returns all jobs
   const IntResponseMap& synchronize();
@@ -281,6 +288,10 @@ private:
   /// using message passing on a dedicated master partition; executes on
   /// iteratorComm master
   void master_dynamic_schedule_evaluations();
+  /// blocking dynamic schedule of all evaluations in beforeSynchCorePRPQueue
+  /// that packs several jobs per message and queues jobs ahead on each
+  /// server (evaluation_scheduling master prefetch)
+  void master_dynamic_schedule_evaluations_prefetch();
   /// blocking static schedule of all evaluations in beforeSynchCorePRPQueue
   /// using message passing on a peer partition; executes on iteratorComm master
   void peer_static_schedule_evaluations();
@@ -322,6 +333,24 @@ private:
   /// helper function for processing recvBuffers[buff_index] within scheduler
   void receive_evaluation(PRPQueueIter& prp_it, size_t buff_index,
 			  int server_id, bool peer_flag);
+  /// helper function for processing a response unpacked from recv_buffer
+  /// within scheduler
+  void receive_evaluation(PRPQueueIter& prp_it, MPIUnpackBuffer& recv_buffer,
+			  int server_id, bool peer_flag);
+  /// helper function for packing num_send jobs from dispatch_order,
+  /// starting at next_job, into sendBuffers[server_id-1] and sending them
+  /// to the server as one message (prefetch schedule)
+  void send_evaluations(const std::vector<PRPQueueIter>& dispatch_order,
+			size_t& next_job, int num_send, int server_id,
+			MPI_Request& send_request);
+  /// order the jobs in beforeSynchCorePRPQueue by decreasing expected
+  /// run time, based on evalRuntimeHistory
+  void longest_first_order(std::vector<PRPQueueIter>& dispatch_order);
+  /// update evalRuntimeHistory with the run time of a completed job
+  void update_runtime_history(const ActiveSet& set, Real run_time);
+  /// compute the maximum lengths of the combined job and result messages
+  /// exchanged by the prefetch schedule
+  void prefetch_message_lengths(int& len_jobs, int& len_results);
 
   /// launch an asynchronous local evaluation from a queue iterator 
   void launch_asynch_local(PRPQueueIter& prp_it);
@@ -361,6 +390,10 @@ private:
   /// serve the evaluation message passing schedulers and perform
   /// multiple asynchronous evaluations as part of the 1st peer
   void serve_evaluations_asynch_peer();
+  /// serve the prefetch schedule of the master, executing queued jobs
+  /// either synchronously or asynchronously and returning completed
+  /// results in combined messages
+  void serve_evaluations_prefetch();
 
   // Routines employed by init/set_communicators():
 
@@ -444,6 +477,15 @@ private:
   /// {DEFAULT,MASTER,PEER_DYNAMIC,PEER_STATIC}_SCHEDULING.  Used for manual
   /// overrides of auto-configure logic in ParallelLibrary::resolve_inputs().
   short evalScheduling;
+  /// user specification of the maximum number of evaluations queued on
+  /// each server in addition to its concurrency (master prefetch schedule)
+  int evalPrefetchSpec;
+  /// number of evaluations that may be queued ahead on each server; 0 if
+  /// the prefetch schedule is inactive in the current configuration
+  int evalPrefetch;
+  /// per-interface history of evaluation run times, keyed by the active
+  /// set request vector: (number of runs, mean run time in seconds)
+  std::map<ShortArray, RealRealPair> evalRuntimeHistory;
   /// user specification of analysis scheduling algorithm:
   /// {DEFAULT,MASTER,PEER}_SCHEDULING.  Used for manual overrides of
   /// the auto-configure logic in ParallelLibrary::resolve_inputs().
@@ -484,6 +526,9 @@ private:
   bool nearbyDuplicateDetect;
   /// tolerance value for tolerance-based duplication detection
   Real nearbyTolerance;
+  /// grid hash of this interface's data_pairs entries, bounding the
+  /// candidates of tolerance-based duplication detection
+  PRPGridIndex nearbyGrid;
 
   /// used to manage a user request to deactivate the restart file (i.e., 
   /// insertions into write_restart).
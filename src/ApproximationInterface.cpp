@@ -194,7 +194,7 @@ map(const Variables& vars, const ActiveSet& set, Response& response,
 
   // Subdivide set for algebraic_mappings() and derived_map()
   Response algebraic_response, core_response; // empty handles
-  ActiveSet core_set;
+  ActiveSet& core_set = coreSet; // fully reassigned below when used
 
   if (algebraicMappings) {
     if (evalIdCntr == 1)
@@ -237,18 +237,29 @@ map(const Variables& vars, const ActiveSet& set, Response& response,
     bool same_view = (vars.view().first == actualModelVars.view().first);
     if (!same_view) actualModelVars.map_variables_by_view(vars);
     const Variables& surf_vars = (same_view) ? vars : actualModelVars;
-    // precompute DVV mappings once for all grads/hessians
-    bool deriv_flag = false;  StSIter it;
-    for (it=approxFnIndices.begin(); it!=approxFnIndices.end(); ++it)
-      if (core_asv[*it] & 6)
-	{ deriv_flag = true; break; }
-    SizetArray assign_indices, curr_indices;
-    if (deriv_flag) {
-      SizetArray assign_dvv;
-      copy_data(actualModelVars.continuous_variable_ids(), assign_dvv);
-      core_response.map_dvv_indices(assign_dvv, assign_indices, curr_indices);
+
+    if (asynch_flag && !algebraicMappings) {
+      // defer the functionSurfaces evaluations to map_queued_evaluations(),
+      // which evaluates each function for all queued points at once
+      // (combining algebraic mappings is left to the synchronous path)
+      beforeSynchApproxQueue.push_back(QueuedApproxEval());
+      QueuedApproxEval& queued = beforeSynchApproxQueue.back();
+      queued.evalId       = evalIdCntr;
+      queued.surfVars     = surf_vars.copy();
+      queued.coreASV      = core_asv;
+      queued.coreResponse = response.copy();
+      map_dvv_indices(core_asv, queued.coreResponse, queued.assignIndices,
+		      queued.currIndices);
+      // bound the storage held by queued variables/responses
+      if (beforeSynchApproxQueue.size() >= approxBatchSize)
+	map_queued_evaluations();
+      return;
     }
 
+    // precompute DVV mappings once for all grads/hessians
+    SizetArray assign_indices, curr_indices;  StSIter it;
+    map_dvv_indices(core_asv, core_response, assign_indices, curr_indices);
+
     //size_t num_core_vars = x.length(), 
     //bool approx_scale_len  = (approxScale.length())  ? true : false;
     //bool approx_offset_len = (approxOffset.length()) ? true : false;
@@ -297,10 +308,102 @@ map(const Variables& vars, const ActiveSet& set, Response& response,
 }
 
 
+void ApproximationInterface::
+map_dvv_indices(const ShortArray& core_asv, Response& core_response,
+		SizetArray& assign_indices, SizetArray& curr_indices)
+{
+  bool deriv_flag = false;
+  for (StSIter it=approxFnIndices.begin(); it!=approxFnIndices.end(); ++it)
+    if (core_asv[*it] & 6)
+      { deriv_flag = true; break; }
+  if (deriv_flag) {
+    SizetArray assign_dvv;
+    copy_data(actualModelVars.continuous_variable_ids(), assign_dvv);
+    core_response.map_dvv_indices(assign_dvv, assign_indices, curr_indices);
+  }
+}
+
+
+/** Evaluates the functionSurfaces for the evaluations queued by
+    asynchronous map() calls.  Values and gradients are requested from
+    each Approximation as one batch over the queued points, allowing
+    surrogates with vectorized evaluations to amortize per-point
+    overhead; Hessians are evaluated point by point. */
+void ApproximationInterface::map_queued_evaluations()
+{
+  if (beforeSynchApproxQueue.empty())
+    return;
+
+  size_t i, num_queued = beforeSynchApproxQueue.size(), num_batch, fn_index;
+  VariablesArray batch_vars;  SizetArray batch_index;
+  RealVector batch_vals;      RealMatrix batch_grads;
+  batch_vars.reserve(num_queued);  batch_index.reserve(num_queued);
+  for (StSIter it=approxFnIndices.begin(); it!=approxFnIndices.end(); ++it) {
+    fn_index = *it;
+    Approximation& fn_surf = functionSurfaces[fn_index];
+
+    // function values
+    batch_vars.clear();  batch_index.clear();
+    for (i=0; i<num_queued; ++i)
+      if (beforeSynchApproxQueue[i].coreASV[fn_index] & 1) {
+	batch_vars.push_back(beforeSynchApproxQueue[i].surfVars);
+	batch_index.push_back(i);
+      }
+    num_batch = batch_index.size();
+    if (num_batch) {
+      fn_surf.values(batch_vars, batch_vals);
+      for (i=0; i<num_batch; ++i)
+	beforeSynchApproxQueue[batch_index[i]].coreResponse.
+	  function_value(batch_vals[i], fn_index);
+    }
+
+    // function gradients
+    batch_vars.clear();  batch_index.clear();
+    for (i=0; i<num_queued; ++i)
+      if (beforeSynchApproxQueue[i].coreASV[fn_index] & 2) {
+	batch_vars.push_back(beforeSynchApproxQueue[i].surfVars);
+	batch_index.push_back(i);
+      }
+    num_batch = batch_index.size();
+    if (num_batch) {
+      fn_surf.gradients(batch_vars, batch_grads);
+      for (i=0; i<num_batch; ++i) {
+	QueuedApproxEval& queued = beforeSynchApproxQueue[batch_index[i]];
+	RealVector approx_grad(Teuchos::View, batch_grads[i],
+			       batch_grads.numRows());
+	// Manage potential DVV mismatch (all vs. active)
+	queued.coreResponse.function_gradient(approx_grad, fn_index,
+	  queued.assignIndices, queued.currIndices);
+      }
+    }
+
+    // function Hessians
+    for (i=0; i<num_queued; ++i) {
+      QueuedApproxEval& queued = beforeSynchApproxQueue[i];
+      if (queued.coreASV[fn_index] & 4)
+	queued.coreResponse.function_hessian(fn_surf.hessian(queued.surfVars),
+	  fn_index, queued.assignIndices, queued.currIndices);
+    }
+  }
+
+  for (i=0; i<num_queued; ++i) {
+    QueuedApproxEval& queued = beforeSynchApproxQueue[i];
+    if (outputLevel > NORMAL_OUTPUT)
+      Cout << "\nActive response data for approximate fn evaluation "
+	   << queued.evalId << ":\n" << queued.coreResponse << '\n';
+    beforeSynchResponseMap[queued.evalId] = queued.coreResponse;
+  }
+  beforeSynchApproxQueue.clear();
+}
+
+
 // Little distinction between blocking and nonblocking synch since all 
 // responses are completed.
 const IntResponseMap& ApproximationInterface::synchronize()
 {
+  // evaluate any queued approximations
+  map_queued_evaluations();
+
   // move data from beforeSynch map to completed map
   rawResponseMap.clear();
   std::swap(beforeSynchResponseMap, rawResponseMap);
@@ -315,6 +418,9 @@ const IntResponseMap& ApproximationInterface::synchronize()
 
 const IntResponseMap& ApproximationInterface::synchronize_nowait()
 {
+  // evaluate any queued approximations
+  map_queued_evaluations();
+
   // move data from beforeSynch map to completed map
   rawResponseMap.clear();
   std::swap(beforeSynchResponseMap, rawResponseMap);
@@ -612,6 +718,9 @@ build_approximation(const RealVector&  c_l_bnds, const RealVector&  c_u_bnds,
 		    const IntVector&  di_l_bnds, const IntVector&  di_u_bnds,
 		    const RealVector& dr_l_bnds, const RealVector& dr_u_bnds)
 {
+  // queued evaluations were requested from the current approximations
+  map_queued_evaluations();
+
   // initialize the data shared among approximation instances
   sharedData.set_bounds(c_l_bnds, c_u_bnds, di_l_bnds, di_u_bnds,
 			dr_l_bnds, dr_u_bnds);
@@ -663,6 +772,9 @@ void ApproximationInterface::export_approximation()
     on data increments provided by {update,append}_approximation(). */
 void ApproximationInterface::rebuild_approximation(const BitArray& rebuild_fns)
 {
+  // queued evaluations were requested from the current approximations
+  map_queued_evaluations();
+
   // rebuild data shared among approximation instances
   sharedData.rebuild();
   // rebuild the approximation surfaces
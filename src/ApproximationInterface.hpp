@@ -204,12 +204,24 @@ private:
   /// Load approximation test points from user challenge points file
   void read_challenge_points();
 
+  /// map the derivative variables of the functionSurfaces to those
+  /// requested in core_response, if any derivatives are requested
+  void map_dvv_indices(const ShortArray& core_asv, Response& core_response,
+		       SizetArray& assign_indices, SizetArray& curr_indices);
+  /// evaluate the functionSurfaces for all evaluations queued by
+  /// asynchronous map() calls, one batch per function and derivative
+  /// order, and catalogue the completed responses
+  void map_queued_evaluations();
+
   //
   //- Heading: Data
   //
 
   /// counter for giving unique names to approximation interfaces
   static size_t approxIdNum;
+  /// number of queued asynchronous evaluations that triggers a batch
+  /// evaluation of the functionSurfaces prior to synchronization
+  static const size_t approxBatchSize = 4096;
   /// for incomplete approximation sets, this array specifies the
   /// response function subset that is approximated
   SizetSet approxFnIndices;
@@ -257,6 +269,9 @@ private:
   /// copy of the actualModel variables object used to simplify conversion 
   /// among differing variable views
   Variables actualModelVars;
+  /// active set for the functionSurfaces evaluations within map(),
+  /// retained across calls to reuse its allocations
+  ActiveSet coreSet;
   /// indicates usage of an evaluation cache by the actualModel
   bool actualModelCache;
   /// the interface id from the actualModel used for ordered PRPCache lookups
@@ -264,9 +279,29 @@ private:
 
   /// bookkeeping map to catalogue responses generated in map() for use in
   /// synchronize() and synchronize_nowait(). This supports pseudo-asynchronous
-  /// operations (approximate responses are always computed synchronously,
-  /// but asynchronous virtual functions are supported through bookkeeping).
+  /// operations (approximate responses are computed synchronously, in
+  /// batches, but asynchronous virtual functions are supported through
+  /// bookkeeping).
   IntResponseMap beforeSynchResponseMap;
+
+  /// core mapping deferred by an asynchronous map() call
+  struct QueuedApproxEval
+  {
+    /// evaluation id (evalIdCntr) assigned in map()
+    int evalId;
+    /// variables in the view of the functionSurfaces
+    Variables surfVars;
+    /// request vector for the functionSurfaces
+    ShortArray coreASV;
+    /// response receiving the functionSurfaces results (queued only
+    /// without algebraic mappings, so this is the complete response)
+    Response coreResponse;
+    /// DVV index mappings for derivative assignment into coreResponse
+    SizetArray assignIndices, currIndices;
+  };
+  /// evaluations whose functionSurfaces mappings are performed in batches
+  /// by map_queued_evaluations() prior to synchronize()/synchronize_nowait()
+  std::vector<QueuedApproxEval> beforeSynchApproxQueue;
 };
 
 
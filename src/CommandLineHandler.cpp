@@ -384,6 +384,13 @@ void CommandLineHandler::initialize_options()
   enroll("write_restart", GetLongOpt::OptionalValue,
          "Write a new DAKOTA restart file $val", NULL);
 
+  enroll("restart_batch", GetLongOpt::MandatoryValue,
+         "Commit restart records in groups of up to $val evaluations", NULL);
+
+  enroll("restart_window", GetLongOpt::MandatoryValue,
+         "Commit grouped restart records at least every $val milliseconds",
+	 NULL);
+
   //enroll("mpi", GetLongOpt::Valueless,
   //       "Turn on message passing within an executable built with MPI", 0);
 }
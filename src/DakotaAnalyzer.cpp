@@ -241,7 +241,10 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
   size_t i, num_evals
     = (compactMode) ? allSamples.numCols() : allVariables.size();
   bool header_flag = (allHeaders.size() == num_evals);
-  bool asynch_flag = model.asynch_flag();
+  // a model lacking asynchronous support may still evaluate a queued
+  // set of evaluations in a batch (e.g., a DataFitSurrModel)
+  bool asynch_flag
+    = (model.asynch_flag() || model.batch_evaluation_available());
 
   if (!asynch_flag && log_resp_flag) allResponses.clear();
 
@@ -828,6 +828,53 @@ Real Approximation::prediction_variance(const RealVector& c_vars)
 }
 
 
+void Approximation::
+values(const VariablesArray& vars_array, RealVector& approx_vals)
+{
+  if (approxRep)
+    approxRep->values(vars_array, approx_vals);
+  else { // default is one value() per point; overridden by batch surrogates
+    size_t i, num_pts = vars_array.size();
+    if (approx_vals.length() != num_pts)
+      approx_vals.sizeUninitialized(num_pts);
+    for (i=0; i<num_pts; ++i)
+      approx_vals[i] = value(vars_array[i]);
+  }
+}
+
+
+void Approximation::
+gradients(const VariablesArray& vars_array, RealMatrix& approx_grads)
+{
+  if (approxRep)
+    approxRep->gradients(vars_array, approx_grads);
+  else { // default is one gradient() per point
+    size_t i, num_pts = vars_array.size();
+    for (i=0; i<num_pts; ++i) {
+      const RealVector& approx_grad = gradient(vars_array[i]);
+      if (i == 0)
+	approx_grads.shapeUninitialized(approx_grad.length(), num_pts);
+      copy_data(approx_grad, approx_grads[i], approx_grad.length());
+    }
+  }
+}
+
+
+void Approximation::
+prediction_variances(const VariablesArray& vars_array, RealVector& approx_vars)
+{
+  if (approxRep)
+    approxRep->prediction_variances(vars_array, approx_vars);
+  else { // default is one prediction_variance() per point
+    size_t i, num_pts = vars_array.size();
+    if (approx_vars.length() != num_pts)
+      approx_vars.sizeUninitialized(num_pts);
+    for (i=0; i<num_pts; ++i)
+      approx_vars[i] = prediction_variance(vars_array[i]);
+  }
+}
+
+
 bool Approximation::advancement_available()
 {
   if (approxRep) return approxRep->advancement_available();
@@ -132,6 +132,18 @@ public:
   /// retrieve the variance of the predicted value for a given parameter vector
   virtual Real prediction_variance(const RealVector& c_vars);
 
+  /// retrieve the approximate function values for a set of parameter vectors
+  virtual void values(const VariablesArray& vars_array,
+		      RealVector& approx_vals);
+  /// retrieve the approximate function gradients (one column per entry in
+  /// vars_array) for a set of parameter vectors
+  virtual void gradients(const VariablesArray& vars_array,
+			 RealMatrix& approx_grads);
+  /// retrieve the variances of the predicted values for a set of
+  /// parameter vectors
+  virtual void prediction_variances(const VariablesArray& vars_array,
+				    RealVector& approx_vars);
+
   /// return the mean of the expansion, where all active vars are random
   virtual Real mean();
   /// return the mean of the expansion for a given parameter vector,
@@ -72,6 +72,7 @@ Interface::Interface(BaseConstructor, const ProblemDescDB& problem_db):
   coreMappings(true), outputLevel(problem_db.get_short("method.output")),
   currEvalId(0), fineGrainEvalCounters(outputLevel > NORMAL_OUTPUT),
   evalIdCntr(0), newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0),
+  cacheHitCntr(0), cacheMissCntr(0), nearbyLookupCntr(0), nearbyHitCntr(0),
   multiProcEvalFlag(false), ieDedMasterFlag(false),
   // See base constructor in DakotaIterator.cpp for full discussion of output
   // verbosity.  Interfaces support the full granularity in verbosity.
@@ -174,8 +175,9 @@ Interface::Interface(NoDBBaseConstructor, size_t num_fns, short output_level):
   interfaceId(no_spec_id()), algebraicMappings(false), coreMappings(true),
   outputLevel(output_level), currEvalId(0), 
   fineGrainEvalCounters(outputLevel > NORMAL_OUTPUT), evalIdCntr(0), 
-  newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0), multiProcEvalFlag(false),
-  ieDedMasterFlag(false), appendIfaceId(true)
+  newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0), cacheHitCntr(0),
+  cacheMissCntr(0), nearbyLookupCntr(0), nearbyHitCntr(0),
+  multiProcEvalFlag(false), ieDedMasterFlag(false), appendIfaceId(true)
 {
 #ifdef DEBUG
   outputLevel = DEBUG_OUTPUT;
@@ -460,6 +462,15 @@ print_evaluation_summary(std::ostream& s, bool minimal_header,
     s << ": " << fn_evals << " total (" << new_fn_evals << " new, "
       << fn_evals - new_fn_evals << " duplicate)\n";
 
+    // evaluation cache summary (end of run), reported for verbose output
+    // or when lookups apply a tolerance
+    int cache_lookups = cacheHitCntr + cacheMissCntr;
+    if (!relative_count && cache_lookups &&
+	(fineGrainEvalCounters || nearbyLookupCntr))
+      s << std::setw(15) << "cache lookups" << ": " << cache_lookups
+	<< " total (" << cacheHitCntr << " hit, " << cacheMissCntr
+	<< " miss, " << nearbyHitCntr << " hit within tolerance)\n";
+
     // detailed evaluation summary
     if (fineGrainEvalCounters) {
       size_t i, num_fns = std::min(fnValCounter.size(), fnLabels.size());
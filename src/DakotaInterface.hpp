@@ -393,6 +393,12 @@ protected:
   int newEvalIdCntr;  ///< new (non-duplicate) interface evaluation counter
   int evalIdRefPt;    ///< iteration reference point for evalIdCntr
   int newEvalIdRefPt; ///< iteration reference point for newEvalIdCntr
+  int cacheHitCntr;   ///< evaluation cache lookups that found a match
+  int cacheMissCntr;  ///< evaluation cache lookups that found no match
+  /// evaluation cache lookups performed with a tolerance on the variables
+  int nearbyLookupCntr;
+  /// tolerance-based cache hits on variables that are not an exact match
+  int nearbyHitCntr;
   // counter arrays provide more detailed reporting if output level >=
   // verbose; these are initalized on-demand in map() as sizes may
   // change due to fields or RecastModels
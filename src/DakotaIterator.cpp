@@ -1075,6 +1075,7 @@ void Iterator::run()
     if (summaryOutputFlag)
       Cout << "\n<<<<< Iterator " << method_string <<" completed.\n";
     finalize_run();
+    evaluationsDB.flush();
     resultsDB.flush();
   }
 }
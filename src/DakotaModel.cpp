@@ -1205,20 +1205,20 @@ void Model::evaluate()
     }
     
     // Define default ActiveSet for iterators which don't pass one
-    ActiveSet temp_set = currentResponse.active_set(); // copy
-    temp_set.request_values(1); // function values only
+    defaultEvalSet = currentResponse.active_set(); // reuses prior allocation
+    defaultEvalSet.request_values(1); // function values only
 
     if(modelEvaluationsDBState == EvaluationsDBState::ACTIVE)
       evaluationsDB.store_model_variables(modelId, modelType, modelEvalCntr,
-					  temp_set, currentVariables);
+					  defaultEvalSet, currentVariables);
 
     if (derived_master_overload()) {
       // prevents error of trying to run a multiproc. direct job on the master
-      derived_evaluate_nowait(temp_set);
+      derived_evaluate_nowait(defaultEvalSet);
       currentResponse = derived_synchronize().begin()->second;
     }
     else // perform a normal synchronous map
-      derived_evaluate(temp_set);
+      derived_evaluate(defaultEvalSet);
 
     if (modelAutoGraphicsFlag)
       derived_auto_graphics(currentVariables, currentResponse);
@@ -1251,22 +1251,20 @@ void Model::evaluate(const ActiveSet& set)
     // Derivative estimation support goes here and is not replicated in the
     // default asv version of evaluate -> a good reason for using an
     // overloaded function design rather than a default parameter design.
-    ShortArray map_asv(numFns, 0), fd_grad_asv(numFns, 0),
-      fd_hess_asv(numFns, 0), quasi_hess_asv(numFns, 0);
     // Manage map/estimate_derivs for a particular asv based on responses spec.
-    bool use_est_deriv = manage_asv(set, map_asv, fd_grad_asv,
-				    fd_hess_asv, quasi_hess_asv);
+    bool use_est_deriv = manage_asv(set, mapASV, fdGradASV, fdHessASV,
+				    quasiHessASV);
 
     if (use_est_deriv) {
       // Compute requested derivatives not available from the simulation (also
       // perform initial map for parallel load balance).  estimate_derivatives()
       // may involve asynch evals depending on asynchEvalFlag.
-      estimate_derivatives(map_asv, fd_grad_asv, fd_hess_asv, quasi_hess_asv,
+      estimate_derivatives(mapASV, fdGradASV, fdHessASV, quasiHessASV,
 			   set, asynchEvalFlag);
       if (asynchEvalFlag) { // concatenate asynch map calls into 1 response
         const IntResponseMap& fd_responses = derived_synchronize();
         synchronize_derivatives(currentVariables, fd_responses, currentResponse,
-				fd_grad_asv, fd_hess_asv, quasi_hess_asv, set);
+				fdGradASV, fdHessASV, quasiHessASV, set);
       }
     }
     else if (derived_master_overload()) {
@@ -1304,14 +1302,14 @@ void Model::evaluate_nowait()
     }
 
     // Define default ActiveSet for iterators which don't pass one
-    ActiveSet temp_set = currentResponse.active_set(); // copy
-    temp_set.request_values(1); // function values only
+    defaultEvalSet = currentResponse.active_set(); // reuses prior allocation
+    defaultEvalSet.request_values(1); // function values only
 
     if(modelEvaluationsDBState == EvaluationsDBState::ACTIVE)
       evaluationsDB.store_model_variables(modelId, modelType, modelEvalCntr,
-          temp_set, currentVariables);
+          defaultEvalSet, currentVariables);
     // perform an asynchronous parameter-to-response mapping
-    derived_evaluate_nowait(temp_set);
+    derived_evaluate_nowait(defaultEvalSet);
 
     rawEvalIdMap[derived_evaluation_id()] = modelEvalCntr;
     numFDEvalsMap[modelEvalCntr] = -1;//no deriv est; distinguish from QN update
@@ -1347,10 +1345,8 @@ void Model::evaluate_nowait(const ActiveSet& set)
 
     // Manage use of estimate_derivatives() for a particular asv based on
     // the user's gradients/Hessians spec.
-    ShortArray map_asv(numFns, 0),    fd_grad_asv(numFns, 0),
-           fd_hess_asv(numFns, 0), quasi_hess_asv(numFns, 0);
-    bool use_est_deriv = manage_asv(set, map_asv, fd_grad_asv,
-				    fd_hess_asv, quasi_hess_asv);
+    bool use_est_deriv = manage_asv(set, mapASV, fdGradASV, fdHessASV,
+				    quasiHessASV);
     int num_fd_evals;
     if (use_est_deriv) {
       // Compute requested derivatives not available from the simulation.
@@ -1359,11 +1355,11 @@ void Model::evaluate_nowait(const ActiveSet& set)
       // some additional bookkeeping so that the response arrays can be properly
       // recombined into estimated gradients/Hessians.
       estDerivsFlag = true; // flipped once per set of asynch evals
-      asvList.push_back(fd_grad_asv);     asvList.push_back(fd_hess_asv);
-      asvList.push_back(quasi_hess_asv);  setList.push_back(set);
+      asvList.push_back(fdGradASV);     asvList.push_back(fdHessASV);
+      asvList.push_back(quasiHessASV);  setList.push_back(set);
       num_fd_evals
-	= estimate_derivatives(map_asv, fd_grad_asv, fd_hess_asv,
-			       quasi_hess_asv, set, true); // always asynch
+	= estimate_derivatives(mapASV, fdGradASV, fdHessASV,
+			       quasiHessASV, set, true); // always asynch
     }
     else {
       derived_evaluate_nowait(set);
@@ -3020,16 +3016,12 @@ void Model::update_model_active_variables(Model& sub_model)
     then these asv outputs are used by estimate_derivatives() for the
     initial map, finite difference gradient evals, finite difference
     Hessian evals, and quasi-Hessian updates, respectively.  If the
-    returned use_est_deriv is false, then only map_asv_out is used. */
+    returned use_est_deriv is false, then the asv outputs are not used
+    (and are not updated when derivative estimation is unsupported). */
 bool Model::manage_asv(const ActiveSet& original_set, ShortArray& map_asv_out,
 		       ShortArray& fd_grad_asv_out, ShortArray& fd_hess_asv_out,
 		       ShortArray& quasi_hess_asv_out)
 {
-  const ShortArray& asv_in   = original_set.request_vector();
-  const SizetArray& orig_dvv = original_set.derivative_vector();
-
-  // *_asv_out[i] have all been initialized to zero
-
   // For EnsembleSurr and Recast models with no scaling (which contain no
   // interface object, only subordinate models), pass the ActiveSet through to
   // the sub-models in one piece and do not break it apart here. This preserves
@@ -3037,6 +3029,14 @@ bool Model::manage_asv(const ActiveSet& original_set, ShortArray& map_asv_out,
   if (!supportsEstimDerivs)
     return false;
 
+  const ShortArray& asv_in   = original_set.request_vector();
+  const SizetArray& orig_dvv = original_set.derivative_vector();
+
+  // initialize *_asv_out to zero; assign() reuses the existing allocations
+  // when the outputs are persistent members
+  map_asv_out.assign(numFns, 0);      fd_grad_asv_out.assign(numFns, 0);
+  fd_hess_asv_out.assign(numFns, 0);  quasi_hess_asv_out.assign(numFns, 0);
+
   bool use_est_deriv = false, fd_grad_flag = false;
   size_t i, asv_len = asv_in.size();
   for (i=0; i<asv_len; ++i) {
@@ -3973,6 +3973,15 @@ bool Model::resize_pending() const
 }
 
 
+bool Model::batch_evaluation_available() const
+{
+  if (modelRep)
+    return modelRep->batch_evaluation_available();
+  else // Base class default is false
+    return false;
+}
+
+
 void Model::build_approximation()
 {
   if (modelRep) // envelope fwd to letter
@@ -222,6 +222,11 @@ public:
   /// sizing-based initialization should be deferred
   virtual bool resize_pending() const;
 
+  /// return true if a set of evaluations may be queued with
+  /// evaluate_nowait() and evaluated in a batch by synchronize(), even
+  /// when asynch_flag() is false
+  virtual bool batch_evaluation_available() const;
+
   /// set primaryA{C,DI,DS,DR}VarMapIndices, secondaryA{C,DI,DS,DR}VarMapTargets
   /// (coming from a higher-level NestedModel context to inform derivative est.)
   virtual void nested_variable_mappings(const SizetArray& c_index1,
@@ -1665,6 +1670,14 @@ private:
   /// transfers deltas from estimate_derivatives() to synchronize_derivatives()
   RealList deltaList;
 
+  /// ASVs for the mapping, finite difference gradients, finite
+  /// difference Hessians, and quasi-Hessians managed within evaluate() and
+  /// evaluate_nowait(); retained across calls to reuse their allocations
+  ShortArray mapASV, fdGradASV, fdHessASV, quasiHessASV;
+  /// default ActiveSet (function values only) reused by evaluate() and
+  /// evaluate_nowait() when the caller does not pass one
+  ActiveSet defaultEvalSet;
+
   /// tracks the number of evaluations used within estimate_derivatives().
   /// Used in synchronize() as a key for combining finite difference
   /// responses into numerical gradients.
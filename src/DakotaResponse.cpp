@@ -1016,15 +1016,18 @@ void Response::write_tabular(std::ostream& s, bool eol) const
     // (inactive data) could be printed as 0's (the inactive value), "N/A",
     // -9999, a blank field, etc.  Using either "N/A" or a blank field gives
     // the correct meaning visually, but both cause problems with data import.
-    size_t i, num_fns = functionValues.length();
+    size_t i, j, num_fns = functionValues.length();
     const ShortArray& asv = responseActiveSet.request_vector();
     s << std::setprecision(write_precision) 
       << std::resetiosflags(std::ios::floatfield);
-    for (i=0; i<num_fns; ++i)
-      if (asv[i] & 1)
-	s << std::setw(write_precision+4) << functionValues[i] << ' ';
-      else
-	s << std::setw(write_precision+4) << "N/A" << ' '; // N/A for inactive
+    for (i=0; i<num_fns; i=j) {
+      // write each run of active values at once
+      for (j=i; j<num_fns && (asv[j] & 1); ++j)
+	;
+      write_tabular_values(s, functionValues.values() + i, j - i);
+      if (j < num_fns) // N/A for inactive
+	{ s << std::setw(write_precision+4) << "N/A" << ' '; ++j; }
+    }
       // BMA TODO: write something that can be read back in for tabular...
       //s << std::numeric_limits<double>::quiet_NaN(); // inactive data
       //s << "EMPTY"; // inactive data
@@ -1047,16 +1050,18 @@ write_tabular_partial(std::ostream& s, size_t start_index,
   if (responseRep) // envelope forward to letter
     responseRep->write_tabular_partial(s, start_index, num_items);
   else {
-    size_t i, num_fns = functionValues.length(),
+    size_t i, j, num_fns = functionValues.length(),
       end = std::min(num_fns, start_index + num_items);
     const ShortArray& asv = responseActiveSet.request_vector();
     s << std::setprecision(write_precision) 
       << std::resetiosflags(std::ios::floatfield);
-    for (i=start_index; i<end; ++i)
-      if (asv[i] & 1)
-	s << std::setw(write_precision+4) << functionValues[i] << ' ';
-      else
-	s << std::setw(write_precision+4) << "N/A" << ' '; // N/A for inactive
+    for (i=start_index; i<end; i=j) {
+      for (j=i; j<end && (asv[j] & 1); ++j)
+	;
+      write_tabular_values(s, functionValues.values() + i, j - i);
+      if (j < end) // N/A for inactive
+	{ s << std::setw(write_precision+4) << "N/A" << ' '; ++j; }
+    }
       // BMA TODO: write something that can be read back in for tabular...
       //s << std::numeric_limits<double>::quiet_NaN(); // inactive data
       //s << "EMPTY"; // inactive data
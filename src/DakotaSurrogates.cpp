@@ -219,6 +219,19 @@ RealVector SurrogatesBaseApprox::map_eval_vars(const Variables& vars)
 }
 
 
+void SurrogatesBaseApprox::
+map_eval_vars(const VariablesArray& vars_array, MatrixXd& eval_pts)
+{
+  size_t i, j, num_pts = vars_array.size();
+  eval_pts.resize(num_pts, sharedDataRep->numVars);
+  for (i=0; i<num_pts; ++i) {
+    RealVector surr_vars = map_eval_vars(vars_array[i]);
+    for (j=0; j<surr_vars.length(); ++j)
+      eval_pts(i,j) = surr_vars[j];
+  }
+}
+
+
 Real
 SurrogatesBaseApprox::value(const RealVector& c_vars)
 {
@@ -252,6 +265,49 @@ const RealVector& SurrogatesBaseApprox::gradient(const RealVector& c_vars)
 }
 
 
+void SurrogatesBaseApprox::
+values(const VariablesArray& vars_array, RealVector& approx_vals)
+{
+  if (!model) {
+    Cerr << "Error: surface is null in SurrogatesBaseApprox::values()"
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  MatrixXd eval_pts;
+  map_eval_vars(vars_array, eval_pts);
+  VectorXd pred_vals = model->value(eval_pts);
+
+  size_t i, num_pts = vars_array.size();
+  if (approx_vals.length() != num_pts)
+    approx_vals.sizeUninitialized(num_pts);
+  for (i=0; i<num_pts; ++i)
+    approx_vals[i] = pred_vals(i);
+}
+
+
+void SurrogatesBaseApprox::
+gradients(const VariablesArray& vars_array, RealMatrix& approx_grads)
+{
+  if (!model) {
+    Cerr << "Error: surface is null in SurrogatesBaseApprox::gradients()"
+	 << std::endl;
+    abort_handler(-1);
+  }
+
+  MatrixXd eval_pts;
+  map_eval_vars(vars_array, eval_pts);
+  MatrixXd pred_grads = model->gradient(eval_pts);
+
+  // Dakota stores one gradient per column
+  size_t i, j, num_pts = pred_grads.rows(), num_vars = pred_grads.cols();
+  approx_grads.shapeUninitialized(num_vars, num_pts);
+  for (i=0; i<num_pts; ++i)
+    for (j=0; j<num_vars; ++j)
+      approx_grads(j,i) = pred_grads(i,j);
+}
+
+
 void SurrogatesBaseApprox::
 import_model(const ProblemDescDB& problem_db)
 {
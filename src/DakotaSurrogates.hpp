@@ -77,6 +77,14 @@ protected:
 
   const RealVector& gradient(const RealVector& c_vars) override;
 
+  /// evaluate the surrogate at all points in a single call
+  void values(const VariablesArray& vars_array,
+	      RealVector& approx_vals) override;
+
+  /// evaluate the surrogate gradients at all points in a single call
+  void gradients(const VariablesArray& vars_array,
+		 RealMatrix& approx_grads) override;
+
   /// set the surrogate's verbosity level according to Dakota's verbosity
   void set_verbosity();
 
@@ -89,6 +97,10 @@ protected:
   /// extract active or all view as vector, mapping if needed for import
   RealVector map_eval_vars(const Variables& vars);
 
+  /// extract active or all view of each Variables as a row of eval_pts
+  void map_eval_vars(const VariablesArray& vars_array,
+		     dakota::MatrixXd& eval_pts);
+
   /// export the model to disk
   void
   export_model(const StringArray& var_labels, const String& fn_label,
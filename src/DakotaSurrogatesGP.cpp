@@ -189,6 +189,29 @@ Real SurrogatesGPApprox::prediction_variance(const RealVector& c_vars)
   return gp_model->variance(eval_point)(0);
 }
 
+void SurrogatesGPApprox::
+prediction_variances(const VariablesArray& vars_array, RealVector& approx_vars)
+{
+  if (!model) {
+    Cerr << "Error: surface is null in SurrogatesGPApprox::"
+	 << "prediction_variances()" << std::endl;
+    abort_handler(-1);
+  }
+
+  MatrixXd eval_pts;
+  map_eval_vars(vars_array, eval_pts);
+
+  auto gp_model =
+      std::static_pointer_cast<dakota::surrogates::GaussianProcess>(model);
+  VectorXd pred_vars = gp_model->variance(eval_pts);
+
+  size_t i, num_pts = vars_array.size();
+  if (approx_vars.length() != num_pts)
+    approx_vars.sizeUninitialized(num_pts);
+  for (i=0; i<num_pts; ++i)
+    approx_vars[i] = pred_vars(i);
+}
+
 void set_model_gp_options(Model& model, const String& options_file) {
   auto custom_param_list = Teuchos::getParametersFromYamlFile(options_file);
   std::vector<Approximation>& exp_gp_approxs = model.approximations();
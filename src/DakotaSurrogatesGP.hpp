@@ -51,6 +51,9 @@ protected:
 
   Real prediction_variance(const RealVector& c_vars) override;
 
+  void prediction_variances(const VariablesArray& vars_array,
+			    RealVector& approx_vars) override;
+
 };
 
 // free function for setting up experimental GPs with an
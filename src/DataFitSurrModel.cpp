@@ -1575,7 +1575,12 @@ void DataFitSurrModel::derived_evaluate(const ActiveSet& set)
 {
   ++surrModelEvalCntr;
 
-  ShortArray approx_asv, actual_asv; bool actual_eval, approx_eval, mixed_eval;
+  // split requests into the persistent approx/actual sets; asv_split()
+  // only populates a request vector when it has active requests
+  ShortArray& approx_asv = approxEvalSet.request_vector();
+  ShortArray& actual_asv = actualEvalSet.request_vector();
+  approx_asv.clear(); actual_asv.clear();
+  bool actual_eval, approx_eval, mixed_eval;
   Response actual_response, approx_response; // empty handles
   switch (responseMode) {
   case UNCORRECTED_SURROGATE: case AUTO_CORRECTED_SURROGATE:
@@ -1602,13 +1607,12 @@ void DataFitSurrModel::derived_evaluate(const ActiveSet& set)
     update_model(actualModel); // update variables/bounds/labels in actualModel
     switch (responseMode) {
     case UNCORRECTED_SURROGATE: case AUTO_CORRECTED_SURROGATE: {
-      ActiveSet actual_set = set;
-      actual_set.request_vector(actual_asv);
-      actualModel.evaluate(actual_set);
+      actualEvalSet.derivative_vector(set.derivative_vector());
+      actualModel.evaluate(actualEvalSet);
       if (mixed_eval)
 	actual_response = actualModel.current_response(); // shared rep
       else {
-	currentResponse.active_set(actual_set);
+	currentResponse.active_set(actualEvalSet);
 	currentResponse.update(actualModel.current_response(), true);//pull meta
       }
       break;
@@ -1651,14 +1655,13 @@ void DataFitSurrModel::derived_evaluate(const ActiveSet& set)
     
     switch (responseMode) {
     case UNCORRECTED_SURROGATE: case AUTO_CORRECTED_SURROGATE: {
-      ActiveSet approx_set = set;
-      approx_set.request_vector(approx_asv);
+      approxEvalSet.derivative_vector(set.derivative_vector());
       approx_response = (mixed_eval) ? currentResponse.copy() : currentResponse;
-      approxInterface.map(currentVariables, approx_set, approx_response);
+      approxInterface.map(currentVariables, approxEvalSet, approx_response);
       if (interfEvaluationsDBState == EvaluationsDBState::ACTIVE) {
         evaluationsDB.store_interface_variables(modelId,
 	  approxInterface.interface_id(), approxInterface.evaluation_id(),
-	  approx_set, currentVariables);
+	  approxEvalSet, currentVariables);
         evaluationsDB.store_interface_response(modelId,
 	  approxInterface.interface_id(), approxInterface.evaluation_id(),
 	  approx_response);
@@ -176,6 +176,10 @@ protected:
 
   bool force_rebuild();
 
+  /// approximate evaluations queued by evaluate_nowait() are evaluated
+  /// in batches by synchronize()
+  bool batch_evaluation_available() const;
+
   /// Builds the local/multipoint/global approximation using
   /// daceIterator/actualModel to generate new data points
   void build_approximation();
@@ -447,6 +451,10 @@ private:
   /// that could not be returned since corresponding truth model response
   /// portions were still pending.
   IntResponseMap cachedApproxRespMap;
+  /// approxInterface and actualModel active sets for synchronous
+  /// evaluations, retained across derived_evaluate() calls to reuse
+  /// their allocations
+  ActiveSet approxEvalSet, actualEvalSet;
 
   /// total points the user specified to construct the surrogate
   int pointsTotal;
@@ -557,6 +565,16 @@ inline bool DataFitSurrModel::force_rebuild()
 }
 
 
+inline bool DataFitSurrModel::batch_evaluation_available() const
+{
+  // truth evaluations are only queued by an asynchronous actualModel, so
+  // batches are limited to the approximation of all response functions
+  return ( ( responseMode == UNCORRECTED_SURROGATE ||
+	     responseMode == AUTO_CORRECTED_SURROGATE ) &&
+	   surrogateFnIndices.size() == numFns );
+}
+
+
 inline size_t DataFitSurrModel::qoi() const
 {
   // Response inflation from aggregation does not proliferate above
@@ -20,18 +20,21 @@ namespace Dakota {
 
 DataInterfaceRep::DataInterfaceRep():
   interfaceType(DEFAULT_INTERFACE),
-  allowExistingResultsFlag(false), verbatimFlag(false), apreproFlag(false),
+  allowExistingResultsFlag(false), verbatimFlag(false),
+  persistentDriverFlag(false), apreproFlag(false),
   resultsFileFormat(FLEXIBLE_RESULTS), fileTagFlag(false), fileSaveFlag(false),
   batchEvalFlag(false), asynchFlag(false),
   asynchLocalEvalConcurrency(0), asynchLocalEvalScheduling(DEFAULT_SCHEDULING),
   asynchLocalAnalysisConcurrency(0), evalServers(0),
-  evalScheduling(DEFAULT_SCHEDULING), procsPerEval(0), analysisServers(0),
+  evalScheduling(DEFAULT_SCHEDULING), evalPrefetch(0), procsPerEval(0),
+  analysisServers(0),
   analysisScheduling(DEFAULT_SCHEDULING), procsPerAnalysis(0),
   failAction("abort"), retryLimit(1), activeSetVectorFlag(true),
   evalCacheFlag(true), nearbyEvalCacheFlag(false),
   nearbyEvalCacheTol(DBL_EPSILON), // default relative tolerance is tight
   restartFileFlag(true), useWorkdir(false), dirTag(false),
-  dirSave(false), templateReplace(false), numpyFlag(false)
+  dirSave(false), templateReplace(false), numpyFlag(false),
+  columnarBatchFlag(false)
   // asynchLocal{Eval,Analysis}Concurrency, procsPer{Eval,Analysis} and
   // {eval,analysis}Servers default to zero in order to allow detection of
   // user overrides > 0
@@ -42,16 +45,19 @@ void DataInterfaceRep::write(MPIPackBuffer& s) const
 {
   s << idInterface << interfaceType << algebraicMappings << analysisDrivers
     << analysisComponents << inputFilter << outputFilter << parametersFile
-    << resultsFile << allowExistingResultsFlag  << verbatimFlag << apreproFlag 
+    << resultsFile << allowExistingResultsFlag  << verbatimFlag
+    << persistentDriverFlag << apreproFlag
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << evalPrefetch << procsPerEval
+    << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
     << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
-    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
+    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag
+    << columnarBatchFlag;
 }
 
 
@@ -59,16 +65,19 @@ void DataInterfaceRep::read(MPIUnpackBuffer& s)
 {
   s >> idInterface >> interfaceType >> algebraicMappings >> analysisDrivers
     >> analysisComponents >> inputFilter >> outputFilter >> parametersFile
-    >> resultsFile >> allowExistingResultsFlag  >> verbatimFlag >> apreproFlag 
+    >> resultsFile >> allowExistingResultsFlag  >> verbatimFlag
+    >> persistentDriverFlag >> apreproFlag
     >> resultsFileFormat >> fileTagFlag >> fileSaveFlag //>> gridHostNames >> gridProcsPerHost
     >> batchEvalFlag >> asynchFlag >> asynchLocalEvalConcurrency
     >> asynchLocalEvalScheduling >> asynchLocalAnalysisConcurrency
-    >> evalServers >> evalScheduling >> procsPerEval >> analysisServers
+    >> evalServers >> evalScheduling >> evalPrefetch >> procsPerEval
+    >> analysisServers
     >> analysisScheduling >> procsPerAnalysis >> failAction >> retryLimit
     >> recoveryFnVals >> activeSetVectorFlag >> evalCacheFlag
     >> nearbyEvalCacheFlag >> nearbyEvalCacheTol >> restartFileFlag
     >> useWorkdir >> workDir >> dirTag >> dirSave >> linkFiles
-    >> copyFiles >> templateReplace >> pluginLibraryPath >> numpyFlag;
+    >> copyFiles >> templateReplace >> pluginLibraryPath >> numpyFlag
+    >> columnarBatchFlag;
 }
 
 
@@ -76,16 +85,19 @@ void DataInterfaceRep::write(std::ostream& s) const
 {
   s << idInterface << interfaceType << algebraicMappings << analysisDrivers
     << analysisComponents << inputFilter << outputFilter << parametersFile
-    << resultsFile << allowExistingResultsFlag  << verbatimFlag << apreproFlag 
+    << resultsFile << allowExistingResultsFlag  << verbatimFlag
+    << persistentDriverFlag << apreproFlag
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << evalPrefetch << procsPerEval
+    << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
     << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
-    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
+    << copyFiles << templateReplace << pluginLibraryPath << numpyFlag
+    << columnarBatchFlag;
 }
 
 
@@ -134,6 +134,10 @@ public:
   /// analysis_drivers/input_filter/output_filter syntax (from the \c
   /// verbatim specification in \ref InterfApplicSC and \ref InterfApplicF)
   bool verbatimFlag;
+  /// flag for serving evaluations from a pool of long-lived analysis
+  /// driver processes (from the \c persistent_driver specification in
+  /// \ref InterfApplicF)
+  bool persistentDriverFlag;
   /// flag for aprepro format usage in the parameters file for
   /// system call and fork interfaces (from the \c aprepro
   /// specification in \ref InterfApplicSC and \ref InterfApplicF)
@@ -177,6 +181,10 @@ public:
   /// within an iterator: {DEFAULT,MASTER,PEER_DYNAMIC,PEER_STATIC}_SCHEDULING 
   /// (from the \c evaluation_scheduling specification in \ref InterfIndControl)
   short evalScheduling;
+  /// maximum number of evaluations queued on each evaluation server in
+  /// addition to its evaluation concurrency (from the \c prefetch
+  /// specification in \ref InterfIndControl)
+  int evalPrefetch;
   /// processors per parallel evaluation within the parallel configuration
   /// (from the \c processors_per_evaluation spec in \ref InterfIndControl)
   int procsPerEval;
@@ -237,6 +245,9 @@ public:
   String pluginLibraryPath;
   /// Python interface: use NumPy data structures (default is list data)
   bool numpyFlag;
+  /// Python interface: pass a batch as one dict of 2-D NumPy arrays
+  /// (default is a list of per-evaluation dicts)
+  bool columnarBatchFlag;
 
 private:
 
@@ -132,7 +132,7 @@ DataMethodRep::DataMethodRep():
   wilksConfidenceLevel(0.95), wilksSidedInterval(ONE_SIDED_UPPER),
   // NonD
   toleranceIntervalsFlag(false), tiCoverage(0.95), tiConfidenceLevel(0.90),
-  stdRegressionCoeffs(false),
+  stdRegressionCoeffs(false), streamingStatsFlag(false), streamingChunkSize(0),
   respScalingFlag(false), vbdOrder(0), covarianceControl(DEFAULT_COVARIANCE),
   rngName("mt19937"), refinementType(Pecos::NO_REFINEMENT),
   refinementControl(Pecos::NO_CONTROL),
@@ -303,7 +303,8 @@ void DataMethodRep::write(MPIPackBuffer& s) const
 
   // NonD
   s << toleranceIntervalsFlag << tiCoverage << tiConfidenceLevel
-    << stdRegressionCoeffs << respScalingFlag << vbdOrder << covarianceControl << rngName
+    << stdRegressionCoeffs << streamingStatsFlag << streamingChunkSize
+    << respScalingFlag << vbdOrder << covarianceControl << rngName
     << refinementType << refinementControl << nestingOverride << growthOverride
     << expansionType << piecewiseBasis << expansionBasisType
     << quadratureOrderSeq << sparseGridLevelSeq << expansionOrderSeq
@@ -473,7 +474,8 @@ void DataMethodRep::read(MPIUnpackBuffer& s)
 
   // NonD
   s >> toleranceIntervalsFlag >> tiCoverage >> tiConfidenceLevel
-    >> stdRegressionCoeffs >> respScalingFlag >> vbdOrder >> covarianceControl >> rngName
+    >> stdRegressionCoeffs >> streamingStatsFlag >> streamingChunkSize
+    >> respScalingFlag >> vbdOrder >> covarianceControl >> rngName
     >> refinementType >> refinementControl >> nestingOverride >> growthOverride
     >> expansionType >> piecewiseBasis >> expansionBasisType
     >> quadratureOrderSeq >> sparseGridLevelSeq >> expansionOrderSeq
@@ -643,7 +645,8 @@ void DataMethodRep::write(std::ostream& s) const
 
   // NonD
   s << toleranceIntervalsFlag << tiCoverage << tiConfidenceLevel
-    << stdRegressionCoeffs << respScalingFlag << vbdOrder << covarianceControl << rngName
+    << stdRegressionCoeffs << streamingStatsFlag << streamingChunkSize
+    << respScalingFlag << vbdOrder << covarianceControl << rngName
     << refinementType << refinementControl << nestingOverride << growthOverride
     << expansionType << piecewiseBasis << expansionBasisType
     << quadratureOrderSeq << sparseGridLevelSeq << expansionOrderSeq
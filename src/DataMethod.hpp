@@ -882,6 +882,11 @@ public:
 
   /// flag indicating the calculation/output of standardized regression coefficients
   bool stdRegressionCoeffs;
+  /// the \c streaming_statistics option accumulates sampling statistics
+  /// in one pass over chunks of samples that are not retained
+  bool streamingStatsFlag;
+  /// the \c chunk_size for \c streaming_statistics
+  size_t streamingChunkSize;
   
   /// Flag to specify use of double sided tolerance interval equivalent normal
   bool toleranceIntervalsFlag;
@@ -555,8 +555,7 @@ void DataTransformModel::derived_evaluate(const ActiveSet& set)
 
     // the incoming set is for the recast problem, which must be converted
     // back to the underlying response set for evaluation by the subModel.
-    ActiveSet sub_model_set;
-    transform_set(currentVariables, set, sub_model_set);
+    transform_set(currentVariables, set, subModelSet);
     // update currentResponse early as it's used in form_residuals
     currentResponse.active_set(set);
 
@@ -574,7 +573,7 @@ void DataTransformModel::derived_evaluate(const ActiveSet& set)
       transform_inactive_variables(config_vars[i], sm_vars);
 
       if (subModel.asynch_flag()) {
-        subModel.evaluate_nowait(sub_model_set);
+        subModel.evaluate_nowait(subModelSet);
         // be able to map the subModel's evalID back to the right
         // recastModel eval and omit evals we didn't schedule
         // Don't need to cache ActiveSet or Variables
@@ -583,7 +582,7 @@ void DataTransformModel::derived_evaluate(const ActiveSet& set)
       else {
         // No need to cache when the subModel is synchronous; populate
         // a subset of residuals for each subModel eval
-        subModel.evaluate(sub_model_set);
+        subModel.evaluate(subModelSet);
         // recast the subModel response ("user space") into the currentResponse
         // ("iterator space"); populate one experiment's residuals
         expData.form_residuals(subModel.current_response(), i, currentResponse);
@@ -637,8 +636,7 @@ void DataTransformModel::derived_evaluate_nowait(const ActiveSet& set)
 
     // the incoming set is for the recast problem, which must be converted
     // back to the underlying response set for evaluation by the subModel.
-    ActiveSet sub_model_set;
-    transform_set(currentVariables, set, sub_model_set);
+    transform_set(currentVariables, set, subModelSet);
 
     if (outputLevel >= VERBOSE_OUTPUT) {
       Cout << "\n------------------------------------";
@@ -653,7 +651,7 @@ void DataTransformModel::derived_evaluate_nowait(const ActiveSet& set)
       // update the subModel variables with the experiment configuration vars
       transform_inactive_variables(config_vars[i], sm_vars);
 
-      subModel.evaluate_nowait(sub_model_set);
+      subModel.evaluate_nowait(subModelSet);
 
       // be able to map the subModel's evalID back to the right
       // recastModel eval
@@ -44,12 +44,44 @@ DefaultSet::DefaultSet(const ActiveSet &in_set, const size_t num_metadata) : set
 
 
 const int HDF5_CHUNK_SIZE = 40000;
+// Default memory budget for buffered response data (bytes)
+const size_t EVAL_STORE_BUFFER_SIZE = 32*1024*1024;
+
+EvaluationStore::EvaluationStore() :
+  bufferedBytes(0), bufferCapacity(EVAL_STORE_BUFFER_SIZE) { }
+
 #ifdef DAKOTA_HAVE_HDF5
 void EvaluationStore::set_database(std::shared_ptr<HDF5IOHelper> db_ptr) {
+  flush(); // buffered rows belong to the previous database
   hdf5Stream = db_ptr;
 }
 #endif
 
+void EvaluationStore::buffer_size(size_t bytes) {
+  bufferCapacity = bytes;
+#ifdef DAKOTA_HAVE_HDF5
+  check_buffer();
+#endif
+}
+
+/// Responses are buffered by store_model_response and store_interface_response
+/// and written in bulk, one hyperslab per contiguous run of rows, when a
+/// dataset accumulates a chunk's worth of rows or the memory budget is
+/// exceeded. Rows are allocated (with fill values) when variables are stored,
+/// so until a flush, buffered responses read back as fill values.
+void EvaluationStore::flush() {
+#ifdef DAKOTA_HAVE_HDF5
+  if(!active()) {
+    pendingRows.clear();
+    bufferedBytes = 0;
+    return;
+  }
+  for(auto &p : pendingRows)
+    flush_rows(p.first, p.second);
+  hdf5Stream->flush();
+#endif
+}
+
 bool EvaluationStore::active() {
   #ifdef DAKOTA_HAVE_HDF5
   return bool(hdf5Stream);
@@ -296,6 +328,7 @@ void EvaluationStore::store_model_response(const String &model_id, const String
   String root_group = create_model_root(model_id, model_type);
   store_response(root_group, response_index, response, default_set_s);
   store_metadata(root_group, response_index, response);
+  check_buffer();
   auto cache_entry = modelResponseIndexCache.find(key);
   modelResponseIndexCache.erase(cache_entry);
 #else
@@ -343,6 +376,7 @@ void EvaluationStore::store_interface_response(const String &model_id, const Str
   String root_group = create_interface_root(model_id, interface_id);
   store_response(root_group, response_index, response, interfaceDefaultSets[std::make_pair(model_id, interface_id)]);
   store_metadata(root_group, response_index, response);
+  check_buffer();
   auto cache_entry = interfaceResponseIndexCache.find(key);
   interfaceResponseIndexCache.erase(cache_entry);
 #else
@@ -1963,22 +1997,17 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
   bool has_functions = bool(default_set_s.numFunctions); 
   String functions_name = response_root + "functions";
   if(has_functions) { 
-    // because of NaN fill value, we have to do some legwork. If all of the function
-    // values are set, we can write them all without making a copy. If some of them are
-    // set, we have to make a copy (initizlied to NaN and write just the values that are
-    // present. If none are set, we do nothing, because tThe dataset by default has NaN
+    // because of NaN fill value, we have to do some legwork. The buffered row is
+    // initialized to NaN, and just the values that are present are copied in. If
+    // none are set, we do nothing, because the dataset by default has NaN
     // fill values.
     const RealVector &f = response.function_values();
     int num1 = std::count_if(asv.begin(), asv.end(), [](const short &a){return a & 1;});
-    if(num1 == num_functions) {
-      hdf5Stream->set_vector(functions_name, f, resp_idx);
-    } else if(num1 > 0) {
-      RealVector f_copy(num_functions, false /*don't zero out */);
-      f_copy = REAL_DSET_FILL_VAL;
+    if(num1 > 0) {
+      Real *f_row = buffer_row(functions_name, resp_idx, num_functions);
       for(int i = 0; i < num_functions; ++i) {
-        if(asv[i] & 1) f_copy[i] = f[i];
+        if(asv[i] & 1) f_row[i] = f[i];
       }
-      hdf5Stream->set_vector(functions_name, f_copy, resp_idx);
     } //else, none are set, do nothing.
   }
   // Gradients. Gradients and hessians are more complicated than function values for two reasons.
@@ -1992,10 +2021,18 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
   IntVector dvv_idx; // indexes into the full gradient matrix of the deriv vars. Declare at this scope
                      // so it can be reused for Hessian storage, if needed
   if(num_gradients && std::any_of(asv.begin(), asv.end(), [](const short &a){return a & 2;})) {
+    // The dataset is (evaluations x gradients x deriv vars); the column-major gradient
+    // matrix (deriv vars x functions) therefore is already in row-major storage order.
     // First do the simple case where the dvv is the same length as default dvv and gradients are 
     // not mixed.
     if(dvv.size() == num_default_deriv_vars && num_gradients == num_functions) {
-        hdf5Stream->set_matrix(gradients_name, response.function_gradients(), resp_idx, true /*transpose*/);
+        const RealMatrix &gradients = response.function_gradients();
+        Real *g_row = buffer_row(gradients_name, resp_idx, num_functions*num_default_deriv_vars);
+        // copy by column; the matrix may be a view with a leading dimension
+        // (stride) exceeding its number of rows
+        for(int i = 0; i < num_functions; ++i)
+          std::copy(gradients[i], gradients[i] + num_default_deriv_vars,
+                    g_row + i*num_default_deriv_vars);
     } else {
       // Need to grab the gradients only for the subset of responses that can have them, and then
       // for those gradients, grab the components that are in the dvv
@@ -2004,68 +2041,65 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
         if(default_asv[i] & 2)
           gradient_idxs.push_back(i);    
       const int num_default_gradients = gradient_idxs.size();
-      RealMatrix full_gradients(num_default_deriv_vars, num_default_gradients, false /*don't zero out*/);
-      full_gradients = REAL_DSET_FILL_VAL;
+      Real *g_row = buffer_row(gradients_name, resp_idx,
+                               num_default_gradients*num_default_deriv_vars);
       dvv_idx.resize(dvv.size());
       for(int i = 0; i < dvv.size(); ++i)
         dvv_idx[i] = find_index(default_dvv, dvv[i]);
       for(int i = 0; i < num_default_gradients; ++i) {
         const RealVector col = response.function_gradient_view(gradient_idxs[i]);
+        Real *g_i = g_row + i*num_default_deriv_vars;
         for(int j = 0; j < dvv.size(); ++j) {
-          full_gradients(dvv_idx[j], i) = col(j);
+          g_i[dvv_idx[j]] = col(j);
         }
       }
-      hdf5Stream->set_matrix(gradients_name, full_gradients, resp_idx, true /*transpose */);
     }
   } 
   // Hessians. Same bookkeeping needs to be done here as for gradients. Addditionally, the
-  // hessians have to be converted from symmetric matrices to regular ones. (Probably should
-  // consider just storing them as row or column major 1D arrays)
+  // hessians have to be expanded from symmetric matrices to full ones in the buffered row,
+  // which is (hessians x deriv vars x deriv vars).
   const int &num_hessians = default_set_s.numHessians;
   String hessians_name = response_root + "hessians";
   if(num_hessians && std::any_of(asv.begin(), asv.end(), [](const short &a){return a & 4;})) {
     // First do the simple case where the dvv is the same length as default dvv, and
     // hessians are not mixed.
+    const size_t hess_len = num_default_deriv_vars*num_default_deriv_vars;
     if(dvv.size() == num_default_deriv_vars && num_hessians == num_functions) {
-      RealMatrixArray full_hessians;
+      Real *h_row = buffer_row(hessians_name, resp_idx, num_functions*hess_len);
       for(const auto &m : response.function_hessians()) {
-        RealMatrix full_hessian(num_default_deriv_vars, num_default_deriv_vars, false /*don't zero out*/);
         for(int i = 0; i < num_default_deriv_vars; ++i) {
-          full_hessian(i, i) = m(i, i);
+          h_row[i*num_default_deriv_vars + i] = m(i, i);
           for(int j = i+1; j < num_default_deriv_vars; ++j) {
-            full_hessian(j,i) = full_hessian(i,j) = m(i,j);
+            h_row[j*num_default_deriv_vars + i] = h_row[i*num_default_deriv_vars + j] = m(i,j);
           }
         }
-        full_hessians.push_back(full_hessian);
+        h_row += hess_len;
       }
-      hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose (for efficiency)*/);
     } else {
       IntArray hessian_idxs; // Indexes of responses that can have hessians
       for(int i = 0; i < num_functions; ++i)
         if(default_asv[i] & 4)
           hessian_idxs.push_back(i);    
       int num_default_hessians = hessian_idxs.size();
-      RealMatrixArray full_hessians;  //(num_default_deriv_vars, num_default_gradients);
+      Real *h_row = buffer_row(hessians_name, resp_idx, num_default_hessians*hess_len);
       if(dvv_idx.empty()) { // not yet populated by gradient storage block
         dvv_idx.resize(dvv.size());
         for(int i = 0; i < dvv.size(); ++i)
           dvv_idx[i] = find_index(default_dvv, dvv[i]);
       }
       for(int mi = 0; mi < num_default_hessians; ++mi) {
-        RealMatrix full_hessian(num_default_deriv_vars, num_default_deriv_vars, false /*don't zero out*/);
-        full_hessian = REAL_DSET_FILL_VAL;
+        Real *full_hessian = h_row + mi*hess_len;
         const RealSymMatrix &resp_hessian = response.function_hessian_view(hessian_idxs[mi]);
         for(int i = 0; i < dvv.size(); ++i) {
           const int &dvv_i = dvv_idx[i];
-          full_hessian(dvv_i, dvv_i) = resp_hessian(i,i);
+          full_hessian[dvv_i*num_default_deriv_vars + dvv_i] = resp_hessian(i,i);
           for(int j = i+1; j < dvv.size(); ++j) {
             const int &dvv_j = dvv_idx[j];
-            full_hessian(dvv_j, dvv_i) = full_hessian(dvv_i, dvv_j) = resp_hessian(i, j);
+            full_hessian[dvv_j*num_default_deriv_vars + dvv_i]
+              = full_hessian[dvv_i*num_default_deriv_vars + dvv_j] = resp_hessian(i, j);
           }
         }
-        full_hessians.push_back(full_hessian);
       }
-      hdf5Stream->set_vector_matrix(hessians_name, full_hessians, resp_idx, true /*transpose */);
     }
   } 
 #else
@@ -2120,12 +2154,79 @@ void EvaluationStore::store_metadata(const String &root_group, const int &resp_i
   const size_t num_metadata = metadata.size();
   String metadata_name = root_group + "metadata";
   
-  hdf5Stream->set_vector(metadata_name, metadata, resp_idx);
+  Real *md_row = buffer_row(metadata_name, resp_idx, num_metadata);
+  std::copy(metadata.begin(), metadata.end(), md_row);
 #else
   return;
 #endif
 }
 
+#ifdef DAKOTA_HAVE_HDF5
+Real* EvaluationStore::buffer_row(const String &dset_name, const int &resp_idx,
+    const size_t row_length) {
+  auto p_it = pendingRows.find(dset_name);
+  if(p_it == pendingRows.end()) {
+    // chunks hold a whole number of rows (see HDF5IOHelper::create_empty_dataset)
+    PendingRows &new_rows = pendingRows[dset_name];
+    new_rows.rowLength = row_length;
+    size_t row_bytes = std::max(row_length*sizeof(Real), size_t(1));
+    new_rows.rowsPerChunk = std::max(HDF5_CHUNK_SIZE/row_bytes, size_t(1));
+    p_it = pendingRows.find(dset_name);
+  }
+  PendingRows &rows = p_it->second;
+  if(row_length != rows.rowLength) {
+    Cerr << "Error: inconsistent response length for HDF5 dataset " << dset_name
+      << " (" << row_length << " vs. " << rows.rowLength << ").\n";
+    abort_handler(-1);
+  }
+  rows.indices.push_back(resp_idx);
+  rows.values.resize(rows.values.size() + row_length, REAL_DSET_FILL_VAL);
+  bufferedBytes += row_length*sizeof(Real);
+  return &rows.values[rows.values.size() - row_length];
+}
+
+void EvaluationStore::check_buffer() {
+  if(!active())
+    return;
+  bool over_budget = (bufferedBytes > bufferCapacity);
+  for(auto &p : pendingRows)
+    if(over_budget || p.second.indices.size() >= p.second.rowsPerChunk)
+      flush_rows(p.first, p.second);
+}
+
+void EvaluationStore::flush_rows(const String &dset_name, PendingRows &rows) {
+  const size_t num_rows = rows.indices.size(), row_len = rows.rowLength;
+  if(!num_rows)
+    return;
+  // Evaluations may complete out of order; sort the rows by index so that
+  // contiguous runs are written together. A row stored twice keeps the
+  // last value, as for write-through storage.
+  std::vector<size_t> order(num_rows);
+  for(size_t i = 0; i < num_rows; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(),
+      [&rows](const size_t &a, const size_t &b) {return rows.indices[a] < rows.indices[b];});
+  std::vector<int> sorted_indices;
+  std::vector<Real> sorted_values;
+  sorted_indices.reserve(num_rows);
+  sorted_values.reserve(num_rows*row_len);
+  for(size_t i = 0; i < num_rows; ++i) {
+    const int &index = rows.indices[order[i]];
+    const Real *row = &rows.values[order[i]*row_len];
+    if(!sorted_indices.empty() && sorted_indices.back() == index)
+      std::copy(row, row + row_len, sorted_values.end() - row_len);
+    else {
+      sorted_indices.push_back(index);
+      sorted_values.insert(sorted_values.end(), row, row + row_len);
+    }
+  }
+  hdf5Stream->set_rows(dset_name, sorted_indices, sorted_values);
+  bufferedBytes -= num_rows*row_len*sizeof(Real);
+  rows.indices.clear();
+  rows.values.clear();
+}
+#endif
+
 void EvaluationStore::model_selection(const unsigned short &selection) {
   modelSelection = selection;
 }
@@ -49,6 +49,9 @@ struct DefaultSet {
 
 class EvaluationStore {
   public:
+    /// Default constructor
+    EvaluationStore();
+
 #ifdef DAKOTA_HAVE_HDF5
     /// Set the HDF5IOHelper to use
     void set_database(std::shared_ptr<HDF5IOHelper> db_ptr);
@@ -93,8 +96,41 @@ class EvaluationStore {
     void store_interface_response(const String &model_id, const String &interface_id, 
                                 const int &eval_id, const Response &response);
 
+    /// Set the memory budget (bytes) for buffered response data; 0 writes
+    /// each response immediately
+    void buffer_size(size_t bytes);
+
+    /// Write all buffered response data to the database
+    void flush();
+
   private:
 
+#ifdef DAKOTA_HAVE_HDF5
+    /// Response "rows" of one dataset that have not yet been written
+    struct PendingRows {
+      /// number of values per row (product of the trailing dimensions)
+      size_t rowLength;
+      /// number of rows per HDF5 chunk of the dataset
+      size_t rowsPerChunk;
+      /// dataset row (index into the 0th dimension) of each buffered row
+      std::vector<int> indices;
+      /// buffered rows, packed in row-major order
+      std::vector<Real> values;
+    };
+
+    /// Append a row of length row_length for dataset row resp_idx to the
+    /// buffer of dset_name, initialized to the fill value; returns its start
+    Real* buffer_row(const String &dset_name, const int &resp_idx,
+                     const size_t row_length);
+
+    /// Write the rows of datasets that fill an HDF5 chunk, or of all datasets
+    /// if the memory budget is exceeded
+    void check_buffer();
+
+    /// Write and clear the buffered rows of one dataset
+    void flush_rows(const String &dset_name, PendingRows &rows);
+#endif
+
     /// Create the mapping from variable type to description
     static std::map<unsigned short, String> create_variable_type_map();
 
@@ -222,7 +258,13 @@ class EvaluationStore {
 #ifdef DAKOTA_HAVE_HDF5
     /// Pointer to HDF5IOHelper instance
     std::shared_ptr<HDF5IOHelper> hdf5Stream;
+    /// Buffered response rows, by dataset name
+    std::map<String, PendingRows> pendingRows;
 #endif
+    /// Bytes of response data currently buffered
+    size_t bufferedBytes;
+    /// Memory budget (bytes) for buffered response data
+    size_t bufferCapacity;
     /// Models that have been allocated
     std::set<String> allocatedModels;
     /// Interface+model pairs that have been allocated
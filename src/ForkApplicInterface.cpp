@@ -27,7 +27,21 @@ namespace Dakota {
 ForkApplicInterface::
 ForkApplicInterface(const ProblemDescDB& problem_db):
   ProcessHandleApplicInterface(problem_db)
-{ }
+{
+  if (problem_db.get_bool("interface.application.persistent_driver")) {
+    // a persistent driver serves whole evaluations, so each evaluation
+    // must map to a single driver process
+    if (programNames.size() != 1 || !iFilterName.empty() ||
+	!oFilterName.empty() || batchEval) {
+      Cerr << "Error: persistent_driver requires a single analysis_driver "
+	   << "and does not support input_filter, output_filter, or "
+	   << "batch." << std::endl;
+      abort_handler(-1);
+    }
+    driverPool = std::make_shared<PersistentDriverPool>(programNames[0],
+							 outputLevel);
+  }
+}
 
 
 void ForkApplicInterface::wait_local_evaluation_sequence(PRPQueue& prp_queue)
@@ -118,6 +132,9 @@ size_t ForkApplicInterface::test_local_analyses_send(int analysis_id)
 pid_t ForkApplicInterface::
 create_analysis_process(bool block_flag, bool new_group)
 {
+  if (driverPool)
+    return create_persistent_process(block_flag);
+
   // Guidance: Do as little between fork/exec as possible to avoid
   // memory issues and overhead from copy-on-write.  Guidance from
   // various sources leads to:
@@ -205,6 +222,29 @@ create_analysis_process(bool block_flag, bool new_group)
 }
 
 
+/** Parameters and results file names are made absolute, since the
+    persistent driver process does not follow Dakota into the
+    evaluation's work directory. */
+pid_t ForkApplicInterface::create_persistent_process(bool block_flag)
+{
+  bfs::path work_dir = (useWorkdir) ? curWorkdir :
+    bfs::path(WorkdirHelper::startup_pwd());
+  if (work_dir.is_relative())
+    work_dir = WorkdirHelper::rel_to_abs(work_dir);
+  bfs::path params_path(argList[1]), results_path(argList[2]);
+  if (params_path.is_relative())
+    params_path = work_dir / params_path;
+  if (results_path.is_relative())
+    results_path = work_dir / results_path;
+
+  pid_t pid = driverPool->submit(work_dir.string(), params_path.string(),
+				 results_path.string());
+  if (block_flag)
+    driverPool->wait(pid);
+  return pid;
+}
+
+
 pid_t ForkApplicInterface::
 wait(pid_t process_group_id, std::map<pid_t, int>& process_id_map,
      bool block_flag)
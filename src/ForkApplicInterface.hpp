@@ -17,6 +17,7 @@
 #define FORK_APPLIC_INTERFACE_H
 
 #include "ProcessHandleApplicInterface.hpp"
+#include "PersistentDriverPool.hpp"
 
 
 namespace Dakota {
@@ -25,7 +26,10 @@ namespace Dakota {
 /// using fork/execvp/waitpid.
 
 /** ForkApplicInterface is used on Unix systems and is a peer to
-    SpawnApplicInterface for Windows systems. */
+    SpawnApplicInterface for Windows systems.  With persistent_driver,
+    evaluations are instead dispatched to a PersistentDriverPool of
+    long-lived driver processes, whose process ids take the place of
+    the per-evaluation child process ids. */
 
 class ForkApplicInterface: public ProcessHandleApplicInterface
 {
@@ -92,6 +96,10 @@ private:
   /// core code used by join_{evaluation,analysis}_process_group()
   void join_process_group(pid_t& process_group_id, bool new_group);
 
+  /// send the evaluation defined by argList to driverPool and wait for
+  /// its completion if block_flag is true
+  pid_t create_persistent_process(bool block_flag);
+
   //
   //- Heading: Data
   //
@@ -104,6 +112,10 @@ private:
   /// used by this interface instance (to distinguish from other interface
   /// instances that could be running at the same time)
   pid_t analysisProcGroupId;
+
+  /// pool of persistent analysis driver processes (empty unless
+  /// persistent_driver is specified)
+  std::shared_ptr<PersistentDriverPool> driverPool;
 };
 
 
@@ -112,7 +124,10 @@ inline ForkApplicInterface::~ForkApplicInterface()
 
 
 inline pid_t ForkApplicInterface::wait_evaluation(bool block_flag)
-{ return wait(evalProcGroupId, evalProcessIdMap, block_flag); }
+{
+  return (driverPool) ? driverPool->wait_any(block_flag) :
+    wait(evalProcGroupId, evalProcessIdMap, block_flag);
+}
 
 
 inline pid_t ForkApplicInterface::wait_analysis(bool block_flag)
@@ -26,9 +26,11 @@
 #include "hdf5.h"       // C   API
 #include "hdf5_hl.h"    // C   H5Lite API
 #include "H5Opublic.h"  
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -325,6 +327,18 @@ class HDF5IOHelper
                      const int &index,
                      const bool &transpose = false);
  
+  /// Set layers along the 0th dimension of a dataset at the (sorted, unique)
+  /// indices by name. data holds the layers packed in row-major order; each
+  /// contiguous run of indices is written with a single hyperslab selection.
+  template<typename T>
+  void set_rows(const String &dset_name, const std::vector<int> &indices,
+                     const std::vector<T> &data);
+  /// Set layers along the 0th dimension of a dataset at the (sorted, unique)
+  /// indices using a dataset object.
+  template<typename T>
+  void set_rows(const String &dset_name, H5::DataSet &ds,
+                     const std::vector<int> &indices, const std::vector<T> &data);
+
   /// Set a scalar field on all elements of a 1D dataset of compound type using a ds name.
   template<typename T>
   void set_vector_scalar_field(const String &dset_name,
@@ -944,6 +958,66 @@ void HDF5IOHelper::set_vector_matrix(const String &dset_name, H5::DataSet &ds,
   }
 } 
 
+template<typename T>
+void HDF5IOHelper::set_rows(const String &dset_name, const std::vector<int> &indices,
+                   const std::vector<T> &data) {
+  auto ds_iter = datasetCache.find(dset_name);
+  if( ds_iter != datasetCache.end())
+    set_rows(dset_name, ds_iter->second, indices, data);
+  else {
+    H5::DataSet ds = h5File.openDataSet(dset_name);
+    set_rows(dset_name, ds, indices, data);
+  }
+}
+
+template<typename T>
+void HDF5IOHelper::set_rows(const String &dset_name, H5::DataSet &ds,
+                   const std::vector<int> &indices, const std::vector<T> &data) {
+  // 1. discover the rank and dimensions
+  // 2. the data must hold one full layer per index, and indices must be in range
+  // 3. write each contiguous run of indices as one hyperslab
+  if(indices.empty())
+    return;
+  H5::DataSpace f_space = ds.getSpace();
+  int rank = f_space.getSimpleExtentNdims();
+  std::unique_ptr<hsize_t[]> f_dims(new hsize_t[rank]), f_start(new hsize_t[rank]),
+    f_count(new hsize_t[rank]);
+  f_space.getSimpleExtentDims(f_dims.get());
+  size_t row_len = std::accumulate(&f_dims[1], &f_dims[rank], size_t(1),
+                                   std::multiplies<size_t>());
+  if(data.size() != indices.size()*row_len) {
+    flush();
+    throw std::runtime_error(String("Attempt to set rows of ") + dset_name +
+                             " failed; length of data is " + std::to_string(data.size()) +
+                             " but " + std::to_string(indices.size()) + " rows of length " +
+                             std::to_string(row_len) + " were requested");
+  }
+  if(indices.front() < 0 || static_cast<hsize_t>(indices.back()) >= f_dims[0]) {
+    flush();
+    throw std::runtime_error(String("Attempt to set rows of ") + dset_name +
+                             " failed; requested indices must be >= 0 and < " +
+                             std::to_string(f_dims[0]));
+  }
+  H5::DataType m_datatype = h5_mem_dtype(data[0]);  // memory datatype
+  for(int i = 1; i < rank; ++i) {
+    f_start[i] = 0;
+    f_count[i] = f_dims[i];
+  }
+  size_t first = 0, num_rows = indices.size();
+  while(first < num_rows) {
+    size_t last = first + 1;
+    while(last < num_rows && indices[last] == indices[last-1] + 1)
+      ++last;
+    f_start[0] = indices[first];
+    f_count[0] = last - first;
+    hsize_t m_dim[1] = {f_count[0]*row_len};
+    H5::DataSpace m_space(1, m_dim);
+    f_space.selectHyperslab(H5S_SELECT_SET, f_count.get(), f_start.get());
+    ds.write(&data[first*row_len], m_datatype, m_space, f_space);
+    first = last;
+  }
+}
+
 template<typename T>
 void HDF5IOHelper::set_vector_scalar_field(const String &dset_name, const T &data, const String &field_name) {
   auto ds_iter = datasetCache.find(dset_name);
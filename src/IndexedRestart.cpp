@@ -0,0 +1,323 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        IndexedRestartWriter, IndexedRestartReader
+//- Description:  Class implementation
+
+#include "IndexedRestart.hpp"
+#include "dakota_global_defs.hpp"
+#include "DakotaBuildInfo.hpp"
+#include "ParamResponsePair.hpp"
+#include "util_threads.hpp"
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <streambuf>
+
+
+
+namespace Dakota {
+
+namespace {
+
+/// identifies the indexed restart container (first and last 8 bytes)
+const char indexed_magic[8] = { 'D','A','K','R','S','T','I','X' };
+/// version of the container layout (not of the records within it)
+const std::uint64_t indexed_container_version = 1;
+/// bytes in the magic + container version preamble
+const std::uint64_t preamble_size = 16;
+/// bytes in the footer: index offset, record count, magic
+const std::uint64_t footer_size = 24;
+/// bytes per index entry: record offset, eval id
+const std::uint64_t index_entry_size = 16;
+/// records per thread below which read_prps() decodes serially
+const size_t min_records_per_thread = 1024;
+
+/// read-only stream buffer over a region of memory, so an archive can
+/// be decoded in place from the mapped file
+class MemoryStreambuf: public std::streambuf
+{
+public:
+  MemoryStreambuf(const char* data, size_t length)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + length);
+  }
+};
+
+template <typename T>
+T read_scalar(const char* data)
+{ T val; std::memcpy(&val, data, sizeof(T)); return val; }
+
+template <typename T>
+void write_scalar(std::ostream& os, const T& val)
+{ os.write(reinterpret_cast<const char*>(&val), sizeof(T)); }
+
+/// decode a data record (archived without header) into prp
+void decode_prp(const char* data, size_t length, ParamResponsePair& prp)
+{
+  MemoryStreambuf record_buf(data, length);
+  std::istream record_is(&record_buf);
+  boost::archive::binary_iarchive record_archive(record_is,
+    boost::archive::no_header);
+  record_archive & prp;
+}
+
+} // anonymous namespace
+
+
+IndexedRestartWriter::
+IndexedRestartWriter(const String& write_restart_filename):
+  restartFilename(write_restart_filename), writeOffset(0)
+{
+  open(RestartVersion(DakotaBuildInfo::get_release_num(),
+		      DakotaBuildInfo::get_rev_number()));
+}
+
+
+IndexedRestartWriter::
+IndexedRestartWriter(const String& write_restart_filename,
+		     const RestartVersion& rst_version):
+  restartFilename(write_restart_filename), writeOffset(0)
+{ open(rst_version); }
+
+
+IndexedRestartWriter::~IndexedRestartWriter()
+{ close(); }
+
+
+void IndexedRestartWriter::open(const RestartVersion& rst_version)
+{
+  restartFS.open(restartFilename.c_str(), std::ios::binary);
+  if (!restartFS.good()) {
+    Cerr << "\nError: could not open restart file '" << restartFilename
+	 << "' for writing." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  restartFS.write(indexed_magic, sizeof(indexed_magic));
+  write_scalar(restartFS, indexed_container_version);
+
+  // the header record carries a full archive header, which validates
+  // the platform's binary archive format when read
+  std::ostringstream header_os;
+  {
+    boost::archive::binary_oarchive header_archive(header_os);
+    header_archive & rst_version;
+  }
+  const std::string& header = header_os.str();
+  write_scalar(restartFS, (std::uint64_t)header.size());
+  restartFS.write(header.data(), header.size());
+  writeOffset = preamble_size + sizeof(std::uint64_t) + header.size();
+}
+
+
+void IndexedRestartWriter::append_prp(const ParamResponsePair& prp_in)
+{
+  std::ostringstream record_os;
+  {
+    boost::archive::binary_oarchive record_archive(record_os,
+      boost::archive::no_header);
+    record_archive & prp_in;
+  }
+  const std::string& record = record_os.str();
+  append_record(record.data(), record.size(), prp_in.eval_id());
+}
+
+
+void IndexedRestartWriter::
+append_record(const char* data, size_t length, int eval_id)
+{
+  if (!restartFS.is_open()) {
+    Cerr << "\nError: attempt to write to closed restart file '"
+	 << restartFilename << "'." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  recordIndex.push_back(std::make_pair(writeOffset, (std::int64_t)eval_id));
+  write_scalar(restartFS, (std::uint64_t)length);
+  restartFS.write(data, length);
+  writeOffset += sizeof(std::uint64_t) + length;
+}
+
+
+void IndexedRestartWriter::flush()
+{ restartFS.flush(); }
+
+
+void IndexedRestartWriter::close()
+{
+  if (!restartFS.is_open())
+    return;
+  std::uint64_t index_offset = writeOffset;
+  for (size_t i=0; i<recordIndex.size(); ++i) {
+    write_scalar(restartFS, recordIndex[i].first);
+    write_scalar(restartFS, recordIndex[i].second);
+  }
+  write_scalar(restartFS, index_offset);
+  write_scalar(restartFS, (std::uint64_t)recordIndex.size());
+  restartFS.write(indexed_magic, sizeof(indexed_magic));
+  restartFS.close();
+}
+
+
+IndexedRestartReader::
+IndexedRestartReader(const String& read_restart_filename):
+  restartFilename(read_restart_filename), restartFile(read_restart_filename),
+  fileData(restartFile.data()), fileSize(restartFile.size()), dataOffset(0),
+  recoveredFlag(false)
+{
+  if (!restartFile.good()) {
+    Cerr << "\nError: could not open restart file '" << restartFilename
+	 << "' for reading." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+
+  if (fileSize < preamble_size + sizeof(std::uint64_t) ||
+      std::memcmp(fileData, indexed_magic, sizeof(indexed_magic)) != 0) {
+    Cerr << "\nError: '" << restartFilename << "' is not an indexed restart "
+	 << "file." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  if (read_scalar<std::uint64_t>(fileData + sizeof(indexed_magic)) >
+      indexed_container_version) {
+    Cerr << "\nError: indexed restart file '" << restartFilename
+	 << "' was created with a newer version of Dakota." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+
+  const char* header = NULL; std::uint64_t header_len = 0;
+  if (!record_at(preamble_size, header, header_len)) {
+    Cerr << "\nError: truncated header in indexed restart file '"
+	 << restartFilename << "'." << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  MemoryStreambuf header_buf(header, header_len);
+  std::istream header_is(&header_buf);
+  boost::archive::binary_iarchive header_archive(header_is);
+  header_archive & rstVersion;
+  dataOffset = preamble_size + sizeof(std::uint64_t) + header_len;
+
+  if (!read_index()) {
+    scan_records(dataOffset);
+    recoveredFlag = true;
+  }
+}
+
+
+bool IndexedRestartReader::is_indexed(const String& restart_filename)
+{
+  std::ifstream ifs(restart_filename.c_str(), std::ios::binary);
+  char magic[sizeof(indexed_magic)];
+  return ifs.read(magic, sizeof(magic)) &&
+    std::memcmp(magic, indexed_magic, sizeof(magic)) == 0;
+}
+
+
+bool IndexedRestartReader::read_index()
+{
+  if (fileSize < dataOffset + footer_size)
+    return false;
+  const char* footer = fileData + fileSize - footer_size;
+  if (std::memcmp(footer + 16, indexed_magic, sizeof(indexed_magic)) != 0)
+    return false;
+  std::uint64_t index_offset = read_scalar<std::uint64_t>(footer),
+    num_records = read_scalar<std::uint64_t>(footer + 8);
+  if (index_offset < dataOffset || index_offset > fileSize - footer_size ||
+      (fileSize - footer_size - index_offset) / index_entry_size != num_records)
+    return false;
+
+  recordIndex.resize(num_records);
+  const char* entry = fileData + index_offset;
+  for (size_t i=0; i<num_records; ++i, entry += index_entry_size) {
+    recordIndex[i].first  = read_scalar<std::uint64_t>(entry);
+    recordIndex[i].second = read_scalar<std::int64_t>(entry + 8);
+    const char* data = NULL; std::uint64_t length = 0;
+    if (recordIndex[i].first < dataOffset ||
+	!record_at(recordIndex[i].first, data, length) ||
+	data + length > fileData + index_offset) {
+      recordIndex.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+
+void IndexedRestartReader::scan_records(std::uint64_t first_offset)
+{
+  // Without an index, eval ids require decoding; records that fail to
+  // decode (partially written) end the recovery.
+  recordIndex.clear();
+  const char* data = NULL; std::uint64_t length = 0;
+  for (std::uint64_t offset = first_offset; record_at(offset, data, length);
+       offset += sizeof(std::uint64_t) + length) {
+    ParamResponsePair prp;
+    try { decode_prp(data, length, prp); }
+    catch (const std::exception&) { break; }
+    recordIndex.push_back(std::make_pair(offset, (std::int64_t)prp.eval_id()));
+  }
+  Cout << "Warning: indexed restart file '" << restartFilename
+       << "' has no valid index;\n  recovered " << recordIndex.size()
+       << " records." << std::endl;
+}
+
+
+bool IndexedRestartReader::
+record_at(std::uint64_t offset, const char*& data,
+	  std::uint64_t& length) const
+{
+  if (offset + sizeof(std::uint64_t) > fileSize)
+    return false;
+  length = read_scalar<std::uint64_t>(fileData + offset);
+  data = fileData + offset + sizeof(std::uint64_t);
+  return length <= fileSize - offset - sizeof(std::uint64_t);
+}
+
+
+std::pair<const char*, size_t> IndexedRestartReader::record_data(size_t i) const
+{
+  const char* data = NULL; std::uint64_t length = 0;
+  record_at(recordIndex[i].first, data, length); // validated when indexed
+  return std::make_pair(data, (size_t)length);
+}
+
+
+void IndexedRestartReader::read_prp(size_t i, ParamResponsePair& prp) const
+{
+  std::pair<const char*, size_t> record = record_data(i);
+  decode_prp(record.first, record.second, prp);
+}
+
+
+void IndexedRestartReader::read_prps(size_t num_records, PRPArray& prps) const
+{
+  num_records = std::min(num_records, size());
+  prps.clear();
+  prps.resize(num_records);
+  if (num_records == 0)
+    return;
+
+  // decode the first record serially so that any lazily-initialized
+  // serialization singletons exist before concurrent decoding
+  read_prp(0, prps[0]);
+
+  size_t num_threads = dakota::util::num_threads(num_records - 1,
+    num_records - 1, min_records_per_thread);
+  // records are independent archives: decode contiguous blocks in parallel
+  size_t block = (num_records - 1 + num_threads - 1) / num_threads;
+  dakota::util::run_threads(num_threads, [&](size_t t) {
+    size_t start = 1 + t * block, end = std::min(num_records, start + block);
+    for (size_t i=start; i<end; ++i)
+      read_prp(i, prps[i]);
+  });
+}
+
+} // namespace Dakota
@@ -0,0 +1,172 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        IndexedRestartWriter, IndexedRestartReader
+//- Description:  Restart container with an offset index for random access
+
+#ifndef DAKOTA_INDEXED_RESTART_H
+#define DAKOTA_INDEXED_RESTART_H
+
+#include "dakota_data_types.hpp"
+#include "RestartVersion.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <fstream>
+#include <utility>
+
+
+namespace Dakota {
+
+class ParamResponsePair;
+
+
+/// Writer for the indexed restart container
+
+/** The indexed container stores the same ParamResponsePair data as a
+    (sequential) restart archive, but each record is a self-contained
+    binary archive, so records can be located through an offset index
+    and decoded independently and concurrently.  Layout (host byte
+    order, as for binary archives):
+
+      magic "DAKRSTIX", uint64 container version
+      uint64 length, RestartVersion archive            (header record)
+      { uint64 length, ParamResponsePair archive }*    (data records)
+      { uint64 record offset, int64 eval id }*         (index)
+      uint64 index offset, uint64 record count, magic  (footer)
+
+    Appending a record is independent of the number of records already
+    written; the index and footer are written by close().  A file
+    lacking a valid index (e.g., Dakota was killed) is recovered by
+    walking the record length prefixes. */
+class IndexedRestartWriter
+{
+public:
+
+  /// constructor writing the current Dakota restart version
+  IndexedRestartWriter(const String& write_restart_filename);
+  /// constructor taking non-default version info, e.g., that of a
+  /// converted restart file
+  IndexedRestartWriter(const String& write_restart_filename,
+		       const RestartVersion& rst_version);
+  /// destructor; closes the container if not already closed
+  ~IndexedRestartWriter();
+
+  /// encode and append the passed pair
+  void append_prp(const ParamResponsePair& prp_in);
+  /// append a record already encoded in the container format, e.g.,
+  /// from IndexedRestartReader::record_data(), without decoding it
+  void append_record(const char* data, size_t length, int eval_id);
+
+  /// flush the data records written so far
+  void flush();
+  /// write the index and footer and close the file
+  void close();
+
+  /// number of records appended
+  size_t size() const;
+
+private:
+
+  /// open the file and write the magic and version header
+  void open(const RestartVersion& rst_version);
+
+  /// name of the container file
+  String restartFilename;
+  /// binary stream to which the container is written
+  std::ofstream restartFS;
+  /// offset of the next record to be written
+  std::uint64_t writeOffset;
+  /// (offset, eval id) of each data record
+  std::vector<std::pair<std::uint64_t, std::int64_t> > recordIndex;
+};
+
+
+/// Random-access reader for the indexed restart container
+
+/** The file is memory mapped where available (otherwise read into
+    memory) by MappedFile and records are decoded only when requested. */
+class IndexedRestartReader
+{
+public:
+
+  /// constructor opening and indexing the container
+  IndexedRestartReader(const String& read_restart_filename);
+
+  /// whether the named file is an indexed restart container
+  static bool is_indexed(const String& restart_filename);
+
+  /// restart version information stored in the container
+  const RestartVersion& version() const;
+  /// number of (complete) records in the container
+  size_t size() const;
+  /// whether the index was rebuilt from the record length prefixes
+  bool recovered() const;
+
+  /// evaluation id of record i, available without decoding it
+  int eval_id(size_t i) const;
+  /// decode record i into prp
+  void read_prp(size_t i, ParamResponsePair& prp) const;
+  /// decode the first num_records records into prps, concurrently
+  /// when num_records is large enough to benefit
+  void read_prps(size_t num_records, PRPArray& prps) const;
+  /// encoded bytes of record i, for copying without decoding
+  std::pair<const char*, size_t> record_data(size_t i) const;
+
+private:
+
+  /// load the index from the footer; false if it is missing or invalid
+  bool read_index();
+  /// rebuild the index by walking the record length prefixes
+  void scan_records(std::uint64_t first_offset);
+  /// length-prefixed record at offset; false if it extends past end
+  bool record_at(std::uint64_t offset, const char*& data,
+		 std::uint64_t& length) const;
+
+  /// name of the container file
+  String restartFilename;
+  /// the mapped (or read) container file
+  MappedFile restartFile;
+  /// start of the file contents (restartFile.data())
+  const char* fileData;
+  /// size of the file contents in bytes (restartFile.size())
+  size_t fileSize;
+
+  /// restart version from the header record
+  RestartVersion rstVersion;
+  /// offset of the first data record
+  std::uint64_t dataOffset;
+  /// (offset, eval id) of each data record
+  std::vector<std::pair<std::uint64_t, std::int64_t> > recordIndex;
+  /// whether recordIndex was rebuilt from length prefixes
+  bool recoveredFlag;
+};
+
+
+inline size_t IndexedRestartWriter::size() const
+{ return recordIndex.size(); }
+
+
+inline const RestartVersion& IndexedRestartReader::version() const
+{ return rstVersion; }
+
+
+inline size_t IndexedRestartReader::size() const
+{ return recordIndex.size(); }
+
+
+inline bool IndexedRestartReader::recovered() const
+{ return recoveredFlag; }
+
+
+inline int IndexedRestartReader::eval_id(size_t i) const
+{ return (int)recordIndex[i].second; }
+
+} // namespace Dakota
+
+#endif
@@ -0,0 +1,66 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        MappedFile
+//- Description:  Class implementation
+
+#include "MappedFile.hpp"
+#include <fstream>
+#include <iterator>
+
+#ifdef DAKOTA_HAVE_MMAN
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DAKOTA_HAVE_MMAN
+
+
+namespace Dakota {
+
+MappedFile::MappedFile(const std::string& filename):
+  fileData(NULL), fileSize(0), goodFlag(false), mappedFlag(false)
+{
+#ifdef DAKOTA_HAVE_MMAN
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  struct stat file_stat;
+  if (fd >= 0 && fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+    void* addr = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      fileData = static_cast<const char*>(addr);
+      fileSize = file_stat.st_size;
+      goodFlag = mappedFlag = true;
+    }
+  }
+  if (fd >= 0)
+    ::close(fd); // the mapping remains valid
+  if (mappedFlag)
+    return;
+#endif // DAKOTA_HAVE_MMAN
+
+  std::ifstream ifs(filename.c_str(), std::ios::binary);
+  if (!ifs.good())
+    return;
+  goodFlag = true;
+  fileBuffer.assign(std::istreambuf_iterator<char>(ifs),
+		    std::istreambuf_iterator<char>());
+  fileData = fileBuffer.data();
+  fileSize = fileBuffer.size();
+}
+
+
+MappedFile::~MappedFile()
+{
+#ifdef DAKOTA_HAVE_MMAN
+  if (mappedFlag)
+    munmap(const_cast<char*>(fileData), fileSize);
+#endif // DAKOTA_HAVE_MMAN
+}
+
+} // namespace Dakota
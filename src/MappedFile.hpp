@@ -0,0 +1,75 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        MappedFile
+//- Description:  Read-only file contents, memory mapped where available
+
+#ifndef DAKOTA_MAPPED_FILE_H
+#define DAKOTA_MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+
+
+namespace Dakota {
+
+/// Read-only contents of a file, memory mapped where available
+
+/** The file is memory mapped when sys/mman.h is available and the
+    mapping succeeds; otherwise (including for empty files) it is read
+    into memory.  Readers (IndexedRestartReader, tabular file import)
+    then parse the contents in place. */
+class MappedFile
+{
+public:
+
+  /// constructor mapping (or reading) the named file
+  MappedFile(const std::string& filename);
+  /// destructor; unmaps the file
+  ~MappedFile();
+
+  /// whether the file could be opened
+  bool good() const;
+  /// start of the file contents
+  const char* data() const;
+  /// size of the file contents in bytes
+  size_t size() const;
+
+private:
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// start of the file contents
+  const char* fileData;
+  /// size of the file contents in bytes
+  size_t fileSize;
+  /// whether the file could be opened
+  bool goodFlag;
+  /// whether fileData is a memory mapping (vs. fileBuffer)
+  bool mappedFlag;
+  /// file contents when memory mapping is unavailable
+  std::vector<char> fileBuffer;
+};
+
+
+inline bool MappedFile::good() const
+{ return goodFlag; }
+
+
+inline const char* MappedFile::data() const
+{ return fileData; }
+
+
+inline size_t MappedFile::size() const
+{ return fileSize; }
+
+} // namespace Dakota
+
+#endif
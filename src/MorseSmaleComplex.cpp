@@ -65,13 +65,9 @@ int Vertex::GetIthNeighbor(int i, KNN_Edge * E[])
 	return neighborID;
 }
 
-void Vertex::CreateANNpoint(ANNpoint &p)
+const double *Vertex::GetX()
 {
-	if(p != NULL)
-		delete [] p;
-	p = new ANNcoord[d];
-	for(int i = 0; i < d; i++)
-		p[i] = this->x[i];
+	return x;
 }
 
 void Vertex::Union_Max(Vertex * v, Vertex * V[])
@@ -399,44 +395,33 @@ void MS_Complex::KNN()
 	int eIndex = 0;
 	int i,k;
 
-	ANNpointArray pa = new ANNpoint[numV];
+	// index the vertex coordinates in place and search concurrently
+	Dakota::NearestNeighborIndex knn_index(d);
 	for(i = 0; i < numV; i++)
-	{
-		pa[i] = NULL;
-		V[i]->CreateANNpoint(pa[i]);
-	}
+		knn_index.insert(V[i]->GetX());
+	Dakota::SizetArray nn_idx;
+	Dakota::RealArray dists;
+	knn_index.search(knn_index.points(), numKneighbors+1,
+	                       nn_idx, dists);
 
-	SearchStructure = new ANNkd_tree(pa,numV,d);
-	ANNidxArray nn_idx;
-	ANNdistArray dists;
 	for(i = 0; i < numV; i++)
 	{		
-		nn_idx = new ANNidx[numKneighbors+1];
-		dists = new ANNdist[numKneighbors+1];
-
-		SearchStructure->annkSearch(pa[i],numKneighbors+1,nn_idx,dists);
-
+		const size_t *nn_idx_i = &nn_idx[i*(numKneighbors+1)];
 		for(k=1;k<numKneighbors+1;k++)
 		{
-      if(!DoesEdgeExist(i, nn_idx[k], eIndex))
+      if(!DoesEdgeExist(i, nn_idx_i[k], eIndex))
       {
-			  E[eIndex] = new KNN_Edge(V[i],V[nn_idx[k]],E, eIndex);
+			  E[eIndex] = new KNN_Edge(V[i],V[nn_idx_i[k]],E, eIndex);
 			  eIndex++;
       }
-      if(!DoesEdgeExist(nn_idx[k],i, eIndex))
+      if(!DoesEdgeExist(nn_idx_i[k],i, eIndex))
       {
-			  E[eIndex] = new KNN_Edge(V[nn_idx[k]],V[i],E, eIndex);
+			  E[eIndex] = new KNN_Edge(V[nn_idx_i[k]],V[i],E, eIndex);
 			  eIndex++;
       }
 		}
-		delete [] nn_idx;
-		delete [] dists;
 	}
 
-	for(i = 0; i < numV; i++)
-		delete [] pa[i];
-
-	delete [] pa;
 	numE = eIndex;
 }
 
@@ -1358,7 +1343,6 @@ MS_Complex::~MS_Complex()
 	
 	delete [] V_to_C;
   delete [] persistences;
-	delete SearchStructure;
 }
 
 void MS_Complex::Destroy()
@@ -1375,7 +1359,6 @@ void MS_Complex::Destroy()
 	
 	delete [] V_to_C;
   delete [] persistences;
-	delete SearchStructure;
 }
 
 int MS_Complex::GetIthHighestPersistence(int i)
@@ -15,9 +15,7 @@
 #ifndef MS_COMPLEX_H
 #define MS_COMPLEX_H
 
-#include "ANN/ANN.h"
-#include "ANN/ANNperf.h"
-#include "ANN/ANNx.h"
+#include "NearestNeighborIndex.hpp"
 
 #include <vector>
 #include <cstdlib>
@@ -37,8 +35,8 @@ class Vertex
 {
 public:
 	Vertex(int n, double *p, double _val, int _id);
-	void CreateANNpoint(ANNpoint &p);
 	double GetXi(int i);
+	const double *GetX();
 	void Union_Max(Vertex * v, Vertex * V[]);
 	int Find_Max(Vertex * V[]);
 	void Union_Min(Vertex * v, Vertex * V[]);
@@ -181,7 +179,6 @@ private:
         return true;
     return false;
   }
-	ANNkd_tree *SearchStructure;
 };
 double ScoreTOPOB(MS_Complex &C, double *x);
 double ScoreTOPOP(MS_Complex &C, double *x);
@@ -6563,6 +6563,7 @@ static bool
 	MP_(apreproFlag),
 	MP_(asynchFlag),
 	MP_(batchEvalFlag),
+	MP_(columnarBatchFlag),
 	MP_(dirSave),
 	MP_(dirTag),
 	MP_(evalCacheFlag),
@@ -6570,6 +6571,7 @@ static bool
 	MP_(fileTagFlag),
 	MP_(nearbyEvalCacheFlag),
 	MP_(numpyFlag),
+	MP_(persistentDriverFlag),
 	MP_(restartFileFlag),
 	MP_(templateReplace),
 	MP_(useWorkdir),
@@ -6579,6 +6581,7 @@ static int
 	MP_(analysisServers),
 	MP_(asynchLocalAnalysisConcurrency),
 	MP_(asynchLocalEvalConcurrency),
+	MP_(evalPrefetch),
 	MP_(evalServers),
 	MP_(procsPerAnalysis),
 	MP_(procsPerEval);
@@ -6935,6 +6938,7 @@ static bool
 	MP_(speculativeFlag),
 	MP_(standardizedSpace),
         MP_(stdRegressionCoeffs),
+        MP_(streamingStatsFlag),
         MP_(toleranceIntervalsFlag),
 	MP_(surrBasedGlobalReplacePts),
 	MP_(surrBasedLocalLayerBypass),
@@ -7012,7 +7016,8 @@ static size_t
 	MP_(numParents),
 	MP_(numPredConfigs),
   //MP_(startOrder),
-  MP_(startRank);
+  MP_(startRank),
+	MP_(streamingChunkSize);
 
 static Method_mp_type
 	MP2s(allocationTarget,TARGET_MEAN),
@@ -0,0 +1,371 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        NearestNeighborIndex
+//- Description:  Exact k-nearest neighbor index over referenced points
+
+#include "NearestNeighborIndex.hpp"
+#include "dakota_global_defs.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace Dakota {
+
+/// maximum number of points in a leaf that has a coordinate spread
+static const size_t NN_BUCKET_SIZE = 8;
+
+
+NearestNeighborIndex::NearestNeighborIndex(size_t num_dims, short metric):
+  numDims(num_dims), distMetric(metric), numBuiltPoints(0)
+{ }
+
+
+NearestNeighborIndex::
+NearestNeighborIndex(const RealMatrix& points, size_t first_row,
+		     size_t num_dims, short metric):
+  numDims(num_dims), distMetric(metric), numBuiltPoints(0)
+{ insert(points, first_row); }
+
+
+void NearestNeighborIndex::insert(const Real* point)
+{
+  pointData.push_back(point);
+  size_t id = pointData.size() - 1;
+  if (pointData.size() >= 2 * numBuiltPoints)
+    { build(); return; }
+
+  // descend to the leaf whose region contains the point
+  size_t node_id = 0;
+  while (treeNodes[node_id].splitDim >= 0) {
+    const Node& node = treeNodes[node_id];
+    node_id = (point[node.splitDim] < node.splitValue) ? node.left : node.right;
+  }
+  treeNodes[node_id].bucket.push_back(id);
+  split(node_id);
+}
+
+
+void NearestNeighborIndex::insert(const RealMatrix& points, size_t first_row)
+{
+  if (first_row + numDims > points.numRows()) {
+    Cerr << "\nError: rows " << first_row << " to " << first_row + numDims
+	 << " requested for NearestNeighborIndex from matrix with "
+	 << points.numRows() << " rows." << std::endl;
+    abort_handler(-1);
+  }
+
+  std::vector<const Real*> views;
+  column_views(points, first_row, views);
+  if (pointData.size() + views.size() >= 2 * numBuiltPoints) {
+    pointData.insert(pointData.end(), views.begin(), views.end());
+    build();
+  }
+  else
+    for (const Real* point : views)
+      insert(point);
+}
+
+
+void NearestNeighborIndex::
+column_views(const RealMatrix& matrix, size_t first_row,
+	     std::vector<const Real*>& views)
+{
+  int j, num_cols = matrix.numCols();
+  views.resize(num_cols);
+  for (j=0; j<num_cols; ++j)
+    views[j] = matrix[j] + first_row;
+}
+
+
+void NearestNeighborIndex::build()
+{
+  size_t num_points = pointData.size();
+  SizetArray pt_ids(num_points);
+  for (size_t i=0; i<num_points; ++i)
+    pt_ids[i] = i;
+  treeNodes.assign(1, Node());
+  build(pt_ids, 0, num_points, 0);
+  numBuiltPoints = num_points;
+}
+
+
+/** The points are split at the median of the widest coordinate, so
+    each level halves the points regardless of their distribution. */
+size_t NearestNeighborIndex::
+build(SizetArray& pt_ids, size_t first, size_t last, size_t node_id)
+{
+  Real spread = 0.;
+  int dim = (last - first > NN_BUCKET_SIZE) ?
+    widest_dimension(pt_ids, first, last, spread) : -1;
+  if (dim < 0 || spread <= 0.) {
+    Node& leaf = treeNodes[node_id];
+    leaf.splitDim = -1;
+    leaf.bucket.assign(pt_ids.begin() + first, pt_ids.begin() + last);
+    return node_id;
+  }
+
+  size_t mid = first + (last - first) / 2;
+  std::nth_element(pt_ids.begin() + first, pt_ids.begin() + mid,
+		   pt_ids.begin() + last, [&](size_t a, size_t b)
+		   { return pointData[a][dim] < pointData[b][dim]; });
+  size_t left = treeNodes.size();
+  treeNodes.resize(left + 2);
+  Node& node = treeNodes[node_id];
+  node.splitDim   = dim;
+  node.splitValue = pointData[pt_ids[mid]][dim];
+  node.left  = left;
+  node.right = left + 1;
+  SizetArray().swap(node.bucket);
+  build(pt_ids, first, mid, left);
+  build(pt_ids, mid, last, left + 1);
+  return node_id;
+}
+
+
+void NearestNeighborIndex::split(size_t node_id)
+{
+  if (treeNodes[node_id].bucket.size() <= NN_BUCKET_SIZE)
+    return;
+  SizetArray pt_ids;
+  pt_ids.swap(treeNodes[node_id].bucket);
+  build(pt_ids, 0, pt_ids.size(), node_id);
+}
+
+
+int NearestNeighborIndex::
+widest_dimension(const SizetArray& pt_ids, size_t first, size_t last,
+		 Real& spread) const
+{
+  int widest = -1;
+  spread = 0.;
+  for (size_t d=0; d<numDims; ++d) {
+    Real lower = pointData[pt_ids[first]][d], upper = lower;
+    for (size_t i=first+1; i<last; ++i) {
+      Real x = pointData[pt_ids[i]][d];
+      if (x < lower) lower = x;
+      else if (x > upper) upper = x;
+    }
+    if (upper - lower > spread)
+      { spread = upper - lower; widest = (int)d; }
+  }
+  return widest;
+}
+
+
+/** Coordinates are accumulated in order, as for the ANN library, so
+    the distances agree with it exactly. */
+Real NearestNeighborIndex::distance(const Real* x, const Real* y) const
+{ return distance(x, y, std::numeric_limits<Real>::infinity()); }
+
+
+Real NearestNeighborIndex::
+distance(const Real* x, const Real* y, Real bound) const
+{
+  Real dist = 0.;
+  if (distMetric == L2_NORM)
+    for (size_t d=0; d<numDims && dist <= bound; ++d)
+      { Real diff = x[d] - y[d]; dist += diff * diff; }
+  else
+    for (size_t d=0; d<numDims && dist <= bound; ++d)
+      dist = std::max(dist, std::abs(x[d] - y[d]));
+  return dist;
+}
+
+
+void NearestNeighborIndex::
+search(const Real* query, size_t k, SizetArray& indices,
+       RealArray& distances) const
+{
+  std::vector<Neighbor> nearest;
+  nearest.reserve(k);
+  if (k && !treeNodes.empty())
+    search(0, query, k, nearest);
+  size_t num_nearest = nearest.size();
+  indices.resize(num_nearest);
+  distances.resize(num_nearest);
+  for (size_t r=0; r<num_nearest; ++r)
+    { distances[r] = nearest[r].first; indices[r] = nearest[r].second; }
+}
+
+
+void NearestNeighborIndex::
+search(size_t node_id, const Real* query, size_t k,
+       std::vector<Neighbor>& nearest) const
+{
+  const Node& node = treeNodes[node_id];
+  if (node.splitDim < 0) {
+    for (size_t id : node.bucket) {
+      bool full = (nearest.size() == k);
+      Neighbor candidate(distance(query, pointData[id], full ?
+			 nearest.back().first :
+			 std::numeric_limits<Real>::infinity()), id);
+      if (full && !(candidate < nearest.back()))
+	continue;
+      // insert in (distance, index) order
+      if (full) nearest.back() = candidate;
+      else      nearest.push_back(candidate);
+      for (size_t r=nearest.size()-1; r>0 && nearest[r] < nearest[r-1]; --r)
+	std::swap(nearest[r], nearest[r-1]);
+    }
+    return;
+  }
+
+  // search the side containing the query first; the other side is at
+  // least the coordinate difference away
+  Real diff = query[node.splitDim] - node.splitValue;
+  size_t near_id = (diff < 0.) ? node.left : node.right,
+         far_id  = (diff < 0.) ? node.right : node.left;
+  search(near_id, query, k, nearest);
+  if (nearest.size() < k || coordinate_distance(diff) <= nearest.back().first)
+    search(far_id, query, k, nearest);
+}
+
+
+size_t NearestNeighborIndex::count_within(const Real* query, Real radius) const
+{ return treeNodes.empty() ? 0 : count_within(0, query, radius); }
+
+
+size_t NearestNeighborIndex::
+count_within(size_t node_id, const Real* query, Real radius) const
+{
+  const Node& node = treeNodes[node_id];
+  if (node.splitDim < 0) {
+    size_t count = 0;
+    for (size_t id : node.bucket)
+      if (distance(query, pointData[id], radius) <= radius)
+	++count;
+    return count;
+  }
+
+  Real diff = query[node.splitDim] - node.splitValue;
+  size_t near_id = (diff < 0.) ? node.left : node.right,
+         far_id  = (diff < 0.) ? node.right : node.left,
+         count   = count_within(near_id, query, radius);
+  if (coordinate_distance(diff) <= radius)
+    count += count_within(far_id, query, radius);
+  return count;
+}
+
+
+void NearestNeighborIndex::
+within(const Real* query, Real radius, SizetArray& indices) const
+{
+  indices.clear();
+  if (!treeNodes.empty())
+    within(0, query, radius, indices);
+  std::sort(indices.begin(), indices.end());
+}
+
+
+void NearestNeighborIndex::
+within(size_t node_id, const Real* query, Real radius,
+       SizetArray& indices) const
+{
+  const Node& node = treeNodes[node_id];
+  if (node.splitDim < 0) {
+    for (size_t id : node.bucket)
+      if (distance(query, pointData[id], radius) <= radius)
+	indices.push_back(id);
+    return;
+  }
+
+  Real diff = query[node.splitDim] - node.splitValue;
+  within((diff < 0.) ? node.left : node.right, query, radius, indices);
+  if (coordinate_distance(diff) <= radius)
+    within((diff < 0.) ? node.right : node.left, query, radius, indices);
+}
+
+
+void NearestNeighborIndex::
+within_box(const Real* lower, const Real* upper, SizetArray& indices) const
+{
+  indices.clear();
+  if (!treeNodes.empty())
+    within_box(0, lower, upper, indices);
+  std::sort(indices.begin(), indices.end());
+}
+
+
+void NearestNeighborIndex::
+within_box(size_t node_id, const Real* lower, const Real* upper,
+	   SizetArray& indices) const
+{
+  const Node& node = treeNodes[node_id];
+  if (node.splitDim < 0) {
+    for (size_t id : node.bucket) {
+      const Real* x = pointData[id];
+      size_t d = 0;
+      while (d < numDims && x[d] >= lower[d] && x[d] <= upper[d])
+	++d;
+      if (d == numDims)
+	indices.push_back(id);
+    }
+    return;
+  }
+
+  if (lower[node.splitDim] <= node.splitValue)
+    within_box(node.left, lower, upper, indices);
+  if (upper[node.splitDim] >= node.splitValue)
+    within_box(node.right, lower, upper, indices);
+}
+
+
+void NearestNeighborIndex::
+search(const std::vector<const Real*>& queries, size_t k,
+       SizetArray& indices, RealArray& distances) const
+{
+  size_t num_queries = queries.size(), num_threads
+    = num_query_threads(num_queries);
+  indices.resize(num_queries * k);
+  distances.resize(num_queries * k);
+  auto search_queries = [&](size_t t) {
+    std::vector<Neighbor> nearest;
+    nearest.reserve(k);
+    for (size_t q=t; q<num_queries; q+=num_threads) {
+      nearest.clear();
+      if (k && !treeNodes.empty())
+	search(0, queries[q], k, nearest);
+      for (size_t r=0; r<nearest.size(); ++r) {
+	distances[q*k + r] = nearest[r].first;
+	indices[q*k + r]   = nearest[r].second;
+      }
+    }
+  };
+  dakota::util::run_threads(num_threads, search_queries);
+}
+
+
+void NearestNeighborIndex::
+count_within(const std::vector<const Real*>& queries, const RealVector& radii,
+	     SizetArray& counts) const
+{
+  size_t num_queries = queries.size(), num_threads
+    = num_query_threads(num_queries);
+  counts.resize(num_queries);
+  auto count_queries = [&](size_t t) {
+    for (size_t q=t; q<num_queries; q+=num_threads)
+      counts[q] = count_within(queries[q], radii[q]);
+  };
+  dakota::util::run_threads(num_threads, count_queries);
+}
+
+
+size_t NearestNeighborIndex::num_query_threads(size_t num_queries) const
+{
+  // below this much brute-force-equivalent work per thread, threading
+  // does not pay
+  const size_t min_work_per_thread = 1 << 15;
+  return dakota::util::num_threads(num_queries, num_queries * size(),
+				   min_work_per_thread);
+}
+
+} // namespace Dakota
@@ -0,0 +1,185 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        NearestNeighborIndex
+//- Description:  Exact k-nearest neighbor index over referenced points
+
+#ifndef NEAREST_NEIGHBOR_INDEX_H
+#define NEAREST_NEIGHBOR_INDEX_H
+
+#include "dakota_data_types.hpp"
+#include <cmath>
+#include <utility>
+
+
+namespace Dakota {
+
+/// Exact k-nearest neighbor and fixed-radius search over a kd-tree
+
+/** The index references its points rather than copying them: points
+    are added as pointers to num_dims contiguous coordinates, e.g.,
+    views of (a row range of) the columns of a RealMatrix, which must
+    outlive the index.  Points may be inserted incrementally; the tree
+    is rebuilt (balanced) whenever the number of points has doubled
+    since the last build, and otherwise the new points are added to
+    the leaves.  Queries are const and thread-safe, and the batched
+    queries distribute the query points over threads.
+
+    Distances are reported as for the ANN library: for L2_NORM the
+    squared Euclidean distance, for LINF_NORM the maximum coordinate
+    difference.  Neighbors are ordered by distance, then by index, so
+    results are independent of the tree shape and thread count. */
+class NearestNeighborIndex
+{
+public:
+
+  /// distance metrics
+  enum { L2_NORM, LINF_NORM };
+
+  //
+  //- Heading: Constructors
+  //
+
+  /// constructor for an empty index of num_dims-dimensional points
+  NearestNeighborIndex(size_t num_dims, short metric = L2_NORM);
+  /// constructor indexing rows [first_row, first_row + num_dims) of
+  /// each column of points
+  NearestNeighborIndex(const RealMatrix& points, size_t first_row,
+		       size_t num_dims, short metric = L2_NORM);
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// add a point (num_dims contiguous coordinates, not copied); its
+  /// index is the previous size()
+  void insert(const Real* point);
+  /// add rows [first_row, first_row + num_dims) of each column of points
+  void insert(const RealMatrix& points, size_t first_row);
+
+  /// number of indexed points
+  size_t size() const;
+  /// dimension of the indexed points
+  size_t dimension() const;
+  /// the indexed points, in index order
+  const std::vector<const Real*>& points() const;
+
+  /// distance between two points in the index metric
+  Real distance(const Real* x, const Real* y) const;
+
+  /// the min(k, size()) nearest neighbors of query, ordered by distance
+  void search(const Real* query, size_t k, SizetArray& indices,
+	      RealArray& distances) const;
+  /// number of points within (<=) radius of query
+  size_t count_within(const Real* query, Real radius) const;
+  /// indices, in increasing order, of the points within (<=) radius
+  /// of query
+  void within(const Real* query, Real radius, SizetArray& indices) const;
+  /// indices, in increasing order, of the points in the closed box
+  /// [lower, upper] (bounds may be infinite)
+  void within_box(const Real* lower, const Real* upper,
+		  SizetArray& indices) const;
+
+  /// the k nearest neighbors of each query, concurrently; neighbor r
+  /// of query q is at indices/distances[q*k + r] (requires k <= size())
+  void search(const std::vector<const Real*>& queries, size_t k,
+	      SizetArray& indices, RealArray& distances) const;
+  /// number of points within radii[q] of each query q, concurrently
+  void count_within(const std::vector<const Real*>& queries,
+		    const RealVector& radii, SizetArray& counts) const;
+
+  /// pointers to rows [first_row, first_row + num_rows) of each column
+  static void column_views(const RealMatrix& matrix, size_t first_row,
+			   std::vector<const Real*>& views);
+
+private:
+
+  //
+  //- Heading: Convenience types and functions
+  //
+
+  /// (distance, point index) of a candidate neighbor
+  typedef std::pair<Real, size_t> Neighbor;
+
+  /// kd-tree node; a leaf when splitDim < 0.  Points in the left
+  /// subtree have coordinate splitDim <= splitValue, those in the
+  /// right subtree >= splitValue.
+  struct Node {
+    int splitDim;
+    Real splitValue;
+    size_t left, right;
+    SizetArray bucket;
+  };
+
+  /// rebuild a balanced tree over all points
+  void build();
+  /// recursively build the subtree at node_id over pt_ids[first, last)
+  size_t build(SizetArray& pt_ids, size_t first, size_t last, size_t node_id);
+  /// split leaf node_id if it is full and its points are not coincident
+  void split(size_t node_id);
+  /// dimension of largest coordinate spread of pt_ids[first, last)
+  int widest_dimension(const SizetArray& pt_ids, size_t first, size_t last,
+		       Real& spread) const;
+
+  /// distance from query to the point, abandoning the computation
+  /// once it exceeds bound
+  Real distance(const Real* x, const Real* y, Real bound) const;
+  /// distance contribution of a single coordinate difference
+  Real coordinate_distance(Real diff) const;
+
+  /// k-nearest neighbor search of the subtree at node_id
+  void search(size_t node_id, const Real* query, size_t k,
+	      std::vector<Neighbor>& nearest) const;
+  /// fixed-radius count over the subtree at node_id
+  size_t count_within(size_t node_id, const Real* query, Real radius) const;
+  /// fixed-radius report over the subtree at node_id
+  void within(size_t node_id, const Real* query, Real radius,
+	      SizetArray& indices) const;
+  /// box report over the subtree at node_id
+  void within_box(size_t node_id, const Real* lower, const Real* upper,
+		  SizetArray& indices) const;
+
+  /// number of threads over which num_queries queries are distributed
+  size_t num_query_threads(size_t num_queries) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// dimension of the points
+  size_t numDims;
+  /// L2_NORM or LINF_NORM
+  short distMetric;
+  /// coordinates of each indexed point (referenced, not owned)
+  std::vector<const Real*> pointData;
+  /// kd-tree nodes; node 0 is the root
+  std::vector<Node> treeNodes;
+  /// number of points when the tree was last (re)built
+  size_t numBuiltPoints;
+};
+
+
+inline size_t NearestNeighborIndex::size() const
+{ return pointData.size(); }
+
+
+inline size_t NearestNeighborIndex::dimension() const
+{ return numDims; }
+
+
+inline const std::vector<const Real*>& NearestNeighborIndex::points() const
+{ return pointData; }
+
+
+inline Real NearestNeighborIndex::coordinate_distance(Real diff) const
+{ return (distMetric == L2_NORM) ? diff * diff : std::abs(diff); }
+
+} // namespace Dakota
+
+#endif
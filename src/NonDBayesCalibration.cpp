@@ -35,13 +35,7 @@
 #include "boost/random/variate_generator.hpp"
 #include "boost/generator_iterator.hpp"
 #include "boost/math/special_functions/digamma.hpp"
-// BMA: May need to better manage DLL export / import from ANN in the future
-// #ifdef DLL_EXPORTS
-// #undef DLL_EXPORTS
-// #endif
-#include "ANN/ANN.h"
-//#include "ANN/ANNperf.h"
-//#include "ANN/ANNx.h"
+#include <memory>
 #include "dakota_data_util.hpp"
 //#include "dakota_tabular_io.hpp"
 #include "DiscrepancyCorrection.hpp"
@@ -1376,6 +1370,9 @@ void NonDBayesCalibration::choose_batch_from_mutual_info( int random_seed,
   int num_filtered = mi_chain.numCols();
   size_t optimal_ind;
   RealMatrix Xmatrix;
+  // the posterior samples (X marginal) are common to all candidates
+  NearestNeighborIndex theta_index(mi_chain, 0, numContinuousVars,
+				   NearestNeighborIndex::LINF_NORM);
   // For loop for batch MI 
   for (int batch_n = 1; batch_n < batchEvals+1; batch_n ++) {
     Xmatrix.reshape(numContinuousVars + batch_n * numFunctions,
@@ -1398,7 +1395,8 @@ void NonDBayesCalibration::choose_batch_from_mutual_info( int random_seed,
 
       // calculate the mutual information b/w post theta and lofi responses
       Real MI = knn_mutual_info(Xmatrix, numContinuousVars,
-			        batch_n * numFunctions, mutualInfoAlg);
+			        batch_n * numFunctions, mutualInfoAlg,
+				&theta_index);
       if (outputLevel >= NORMAL_OUTPUT) 
         print_hi2lo_status(num_it, i, xi_i, MI);
     
@@ -3332,8 +3330,6 @@ void NonDBayesCalibration::prior_sample_matrix(RealMatrix& prior_dist_samples)
 Real NonDBayesCalibration::knn_kl_div(RealMatrix& distX_samples,
     			 	RealMatrix& distY_samples, size_t dim)
 {
-  approxnn::normSelector::instance().method(approxnn::L2_NORM);
-
   size_t NX = distX_samples.numCols();
   size_t NY = distY_samples.numCols();
   //size_t dim = numContinuousVars; 
@@ -3345,34 +3341,17 @@ Real NonDBayesCalibration::knn_kl_div(RealMatrix& distX_samples,
   IntVector k_vec_XX(NX);
   k_vec_XX.putScalar(7); //k default set to 6
   			 //1st neighbor is self, so need k+1 for XtoX
-  double eps = 0.0; //default ann error
-   
-  // Copy distX samples into ANN data types
-  ANNpointArray dataX;
-  dataX = annAllocPts(NX, dim);
-  RealVector col(dim);
-  for (int i = 0; i < NX; i++){
-    col = Teuchos::getCol(Teuchos::View, distX_samples, i);
-    for (int j = 0; j < dim; j++){
-      dataX[i][j] = col[j];
-    }
-  } 
-  // Copy distY samples into ANN data types
-  ANNpointArray dataY;
-  dataY = annAllocPts(NY, dim);
-  for (int i = 0; i < NY; i++){
-    col = Teuchos::getCol(Teuchos::View, distY_samples, i);
-    for (int j = 0; j < dim; j++){
-      dataY[i][j] = col[j];
-    }
-  } 
+
+  // Index the samples in place (squared L2 distances, as for ANN)
+  NearestNeighborIndex indexX(distX_samples, 0, dim),
+    indexY(distY_samples, 0, dim);
   
   // calculate vector of kNN distances from dist1 to dist2
   RealVector XtoYdistances(NX);
-  ann_dist(dataX, dataY, XtoYdistances, NX, NY, dim, k_vec_XY, eps);
+  knn_distances(indexY, indexX.points(), XtoYdistances, k_vec_XY);
   // calculate vector of kNN distances from dist1 to itself
   RealVector XtoXdistances(NX);
-  ann_dist(dataX, dataX, XtoXdistances, NX, NX, dim, k_vec_XX, eps);
+  knn_distances(indexX, indexX.points(), XtoXdistances, k_vec_XX);
   
   double log_sum = 0;
   double digamma_sum = 0;
@@ -3390,11 +3369,6 @@ Real NonDBayesCalibration::knn_kl_div(RealMatrix& distX_samples,
   Dkl_est = (double(dim)*log_sum + digamma_sum)/double(NX)
           + log( double(NY)/(double(NX)-1) );
 
-  annDeallocPts( dataX );
-  annDeallocPts( dataY );
-
-  approxnn::normSelector::instance().reset();
-
   return Dkl_est;
 }
 
@@ -3464,10 +3438,8 @@ void NonDBayesCalibration::mutual_info_buildX()
 }
 
 Real NonDBayesCalibration::knn_mutual_info(RealMatrix& Xmatrix, int dimX,
-    int dimY, unsigned short alg)
+    int dimY, unsigned short alg, const NearestNeighborIndex* indexX)
 {
-  approxnn::normSelector::instance().method(approxnn::LINF_NORM);
-
   //std::ofstream test_stream("kam1.txt");
   //test_stream << "Xmatrix = " << Xmatrix << '\n';
   //Cout << "Xmatrix = " << Xmatrix << '\n';
@@ -3475,116 +3447,88 @@ Real NonDBayesCalibration::knn_mutual_info(RealMatrix& Xmatrix, int dimX,
   int num_samples = Xmatrix.numCols();
   int dim = dimX + dimY;
 
-  // Cast Xmatrix into ANN data structure
-  ANNpointArray dataXY;
-  dataXY = annAllocPts(num_samples, dim);
-  RealVector col(dim);
-  for (int i = 0; i < num_samples; i++){
-    col = Teuchos::getCol(Teuchos::View, Xmatrix, i);
-    for (int j = 0; j < dim; j++){
-      dataXY[i][j] = col[j];
-    }
-  }
-
   // Normalize data
-  ANNpoint meanXY, stdXY;
-  meanXY = annAllocPt(dim); //means
+  RealVector meanXY(dim), stdXY(dim); //means, standard deviations
   for (int i = 0; i < num_samples; i++){
     for(int j = 0; j < dim; j++){
-      meanXY[j] += dataXY[i][j];
+      meanXY[j] += Xmatrix(j,i);
     }
   }
   for (int j = 0; j < dim; j++){
     meanXY[j] = meanXY[j]/double(num_samples);
     //Cout << "mean" << j << " = " << meanXY[j] << '\n';
   }
-  stdXY = annAllocPt(dim); //standard deviations
   for (int i = 0; i < num_samples; i++){
     for (int j = 0; j < dim; j++){
-      stdXY[j] += pow (dataXY[i][j] - meanXY[j], 2.0);
+      stdXY[j] += pow (Xmatrix(j,i) - meanXY[j], 2.0);
     }
   }
   for (int j = 0; j < dim; j++){
     stdXY[j] = sqrt( stdXY[j]/(double(num_samples)-1.0) );
     //Cout << "std" << j << " = " << stdXY[j] << '\n';
   }
+  RealMatrix dataXY(dim, num_samples, false);
   for (int i = 0; i < num_samples; i++){
     for (int j = 0; j < dim; j++){
-      dataXY[i][j] = ( dataXY[i][j] - meanXY[j] )/stdXY[j];
+      dataXY(j,i) = ( Xmatrix(j,i) - meanXY[j] )/stdXY[j];
     }
-    //Cout << "dataXY = " << dataXY[i][0] << '\n';
+    //Cout << "dataXY = " << dataXY(0,i) << '\n';
   }
 
-  // Get knn-distances for Xmatrix
+  // Get knn-distances for Xmatrix (max-norm distances)
+  NearestNeighborIndex indexXY(dataXY, 0, dim, NearestNeighborIndex::LINF_NORM);
   RealVector XYdistances(num_samples);
   Int2DArray XYindices(num_samples);
   IntVector k_vec(num_samples);
   int k = 6;
   k_vec.putScalar(k); // for self distances, need k+1
-  double eps = 0.0;
-  ann_dist(dataXY, dataXY, XYdistances, XYindices, num_samples, num_samples, 
-           dim, k_vec, eps);
-
-  // Build marginals
-  ANNpointArray dataX, dataY;
-  dataX = annAllocPts(num_samples, dimX);
-  dataY = annAllocPts(num_samples, dimY);
-  //RealMatrix chainX(dimX, num_samples);
-  //RealMatrix chainY(dimY, num_samples);
-  for(int i = 0; i < num_samples; i++){
-    col = Teuchos::getCol(Teuchos::View, Xmatrix, i);
-    //Cout << "col = " << col << '\n';
-    for(int j = 0; j < dimX; j++){
-      //dataX[i][j] = dataXY[i][j];
-      //Cout << "col " << j << " = " << col[j] << '\n';
-      //chainX[i][j] = col[j];
-      dataX[i][j] = col[j];
-    }
-    for(int j = 0; j < dimY; j++){
-      //dataY[i][j] = dataXY[i][dimX+j];
-      //chainY[i][j] = col[dimX+j];
-      dataY[i][j] = col[dimX+j];
-    }
-  }
-  //Cout << "chainX = " << chainX;
-  ANNkd_tree* kdTreeX;
-  ANNkd_tree* kdTreeY;
-  kdTreeX = new ANNkd_tree(dataX, num_samples, dimX);
-  kdTreeY = new ANNkd_tree(dataY, num_samples, dimY);
-
-  double marg_sum = 0.0;
-  int n_x, n_y;
+  knn_distances(indexXY, indexXY.points(), XYdistances, k_vec, &XYindices);
+
+  // Marginals index the (unnormalized) rows of Xmatrix in place; the
+  // caller may supply a persistent index for the X marginal
+  std::unique_ptr<NearestNeighborIndex> local_indexX;
+  if (!indexX) {
+    local_indexX.reset(new NearestNeighborIndex(Xmatrix, 0, dimX,
+      NearestNeighborIndex::LINF_NORM));
+    indexX = local_indexX.get();
+  }
+  NearestNeighborIndex indexY(Xmatrix, dimX, dimY,
+			      NearestNeighborIndex::LINF_NORM);
+  std::vector<const Real*> dataX, dataY;
+  NearestNeighborIndex::column_views(Xmatrix, 0, dataX);
+  NearestNeighborIndex::column_views(Xmatrix, dimX, dataY);
+
+  // marginal search radii
+  RealVector e_x(num_samples), e_y(num_samples);
   for(int i = 0; i < num_samples; i++){
     if (alg == MI_ALG_KSG2) { //alg=1, ksg2
-      IntArray XYind_i = XYindices[i];	
-      RealArray ex_vec(XYind_i.size()-1);
-      RealArray ey_vec(XYind_i.size()-1);
+      const IntArray& XYind_i = XYindices[i];
       for(int j = 1; j < XYind_i.size(); j ++) {
-	ex_vec[j-1] = annDist(dimX, dataX[i], dataX[XYind_i[j]]);
-	ey_vec[j-1] = annDist(dimY, dataY[i], dataY[XYind_i[j]]);
+	e_x[i] = std::max(e_x[i], indexX->distance(dataX[i],
+						   dataX[XYind_i[j]]));
+	e_y[i] = std::max(e_y[i], indexY.distance(dataY[i],
+						  dataY[XYind_i[j]]));
       }
-      ANNdist e_x = *std::max_element(ex_vec.begin(), ex_vec.end());
-      ANNdist e_y = *std::max_element(ey_vec.begin(), ey_vec.end());
       /*
-      ANNdist e = max(e_x, e_y);
-      n_x = kdTreeX->annkFRSearch(dataX[i], e, 0, NULL, NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], e, 0, NULL, NULL, eps);
+      e = max(e_x, e_y);
       */
-      n_x = kdTreeX->annkFRSearch(dataX[i], e_x, 0, NULL, NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], e_y, 0, NULL, NULL, eps);
     }
     else { //alg=0, ksg1
-      n_x = kdTreeX->annkFRSearch(dataX[i], XYdistances[i], 0, NULL, 
-  				    NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], XYdistances[i], 0, NULL,
-  				    NULL, eps);
-    }
-    double psiX = boost::math::digamma(n_x);
-    double psiY = boost::math::digamma(n_y);
-    //double psiX = boost::math::digamma(n_x+1);
-    //double psiY = boost::math::digamma(n_y+1);
+      e_x[i] = e_y[i] = XYdistances[i];
+    }
+  }
+  SizetArray n_x, n_y;
+  indexX->count_within(dataX, e_x, n_x);
+  indexY.count_within(dataY, e_y, n_y);
+
+  double marg_sum = 0.0;
+  for(int i = 0; i < num_samples; i++){
+    double psiX = boost::math::digamma(n_x[i]);
+    double psiY = boost::math::digamma(n_y[i]);
+    //double psiX = boost::math::digamma(n_x[i]+1);
+    //double psiY = boost::math::digamma(n_y[i]+1);
     marg_sum += psiX + psiY;
-    //test_stream <<"i = "<< i <<", nx = "<< n_x <<", ny = "<< n_y <<'\n';
+    //test_stream <<"i = "<< i <<", nx = "<< n_x[i] <<", ny = "<< n_y[i] <<'\n';
     //test_stream << "psiX = " << psiX << '\n';
     //test_stream << "psiY = " << psiY << '\n';
   }
@@ -3599,15 +3543,6 @@ Real NonDBayesCalibration::knn_mutual_info(RealMatrix& Xmatrix, int dimX,
   //test_stream << "psiN = " << psiN << '\n';
   //test_stream << "MI_est = " << MI_est << '\n';
 
-  // Dealloc memory
-  delete kdTreeX;
-  delete kdTreeY;
-  annDeallocPts(dataX);
-  annDeallocPts(dataY);
-  annDeallocPts(dataXY);
-
-  approxnn::normSelector::instance().reset();
-
   // Compare to dkl
   /*
   double kl_est = knn_kl_div(Xmatrix, Xmatrix);
@@ -3618,85 +3553,44 @@ Real NonDBayesCalibration::knn_mutual_info(RealMatrix& Xmatrix, int dimX,
 
 }
 
-void NonDBayesCalibration::ann_dist(const ANNpointArray matrix1, 
-     const ANNpointArray matrix2, RealVector& distances, int NX, int NY, 
-     int dim2, IntVector& k_vec, double eps)
-{
-
-  ANNkd_tree* kdTree;
-  kdTree = new ANNkd_tree( matrix2, NY, dim2 );
-  for (unsigned int i = 0; i < NX; ++i){
-    int k_i = k_vec[i] ;
-    ANNdistArray knn_dist = new ANNdist[k_i+1];
-    ANNidxArray knn_ind = new ANNidx[k_i+1];
-    //calc min number of distances needed
-    kdTree->annkSearch(matrix1[ i ], k_i+1, knn_ind, knn_dist, eps);
-    double dist = knn_dist[k_i];
-    if (dist == 0.0){
-      ANNdistArray knn_dist_i = new ANNdist[NY];
-      ANNidxArray knn_ind_i = new ANNidx[NY];
-      //calc distances for whole array
-      kdTree->annkSearch(matrix1[ i ], NY, knn_ind_i, knn_dist_i, eps); 
-      for (unsigned int j = k_i+1; j < NY; ++j){
-	if (knn_dist_i[j] > 0.0){
-	  dist = knn_dist_i[j];
-	  k_vec[i] = j;
-	  break;
-	}
-      }
-      delete [] knn_ind_i;
-      delete [] knn_dist_i;
-    }
-    distances[i] = dist;
-    delete [] knn_ind;
-    delete [] knn_dist;
-  }
-  delete kdTree;
-  annClose();
-}
-
-void NonDBayesCalibration::ann_dist(const ANNpointArray matrix1, 
-     const ANNpointArray matrix2, RealVector& distances, Int2DArray& indices, 
-     int NX, int NY, int dim2, IntVector& k_vec, 
-     double eps)
-{
-  ANNkd_tree* kdTree;
-  kdTree = new ANNkd_tree( matrix2, NY, dim2 );
-  for (unsigned int i = 0; i < NX; ++i){
-    int k_i = k_vec[i] ;
-    ANNdistArray knn_dist = new ANNdist[k_i+1];
-    ANNidxArray knn_ind = new ANNidx[k_i+1];
-    //calc min number of distances needed
-    kdTree->annkSearch(matrix1[ i ], k_i+1, knn_ind, knn_dist, eps);
-    double dist = knn_dist[k_i];
-    IntArray ind(k_i+1);
-    for (int j = 0; j < k_i+1; j ++) 
-      ind[j] = knn_ind[j];
+/** The kNN distance of each query excludes coincident neighbors: if
+    its k-th neighbor is at distance zero, k is increased to skip all
+    points coincident with the query. */
+void NonDBayesCalibration::
+knn_distances(const NearestNeighborIndex& index,
+	      const std::vector<const Real*>& queries, RealVector& distances,
+	      IntVector& k_vec, Int2DArray* indices)
+{
+  size_t NX = queries.size(), NY = index.size(), max_k = 0;
+  for (size_t i = 0; i < NX; ++i)
+    max_k = std::max(max_k, (size_t)k_vec[i]);
+  //calc min number of distances needed
+  size_t num_nn = std::min(max_k+1, NY);
+  SizetArray knn_ind;
+  RealArray knn_dist;
+  index.search(queries, num_nn, knn_ind, knn_dist);
+
+  SizetArray knn_ind_i;
+  RealArray knn_dist_i;
+  for (size_t i = 0; i < NX; ++i){
+    int k_i = k_vec[i];
+    double dist = knn_dist[i*num_nn + k_i];
+    IntArray ind(knn_ind.begin() + i*num_nn,
+		 knn_ind.begin() + i*num_nn + k_i+1);
     if (dist == 0.0){
-      ANNdistArray knn_dist_i = new ANNdist[NY];
-      ANNidxArray knn_ind_i = new ANNidx[NY];
-      //calc distances for whole array
-      kdTree->annkSearch(matrix1[ i ], NY, knn_ind_i, knn_dist_i, eps); 
-      for (unsigned int j = k_i+1; j < NY; ++j){
-	if (knn_dist_i[j] > 0.0){
-	  dist = knn_dist_i[j];
-	  ind.resize(j);
-	  for (int k = 0; k < j; k ++)  
-	    ind[k] = knn_ind_i[k];
-	  k_vec[i] = j;
-	  break;
-	}
+      // first neighbor at positive distance follows the coincident ones
+      size_t num_zero = index.count_within(queries[i], 0.);
+      if (num_zero < NY) {
+	index.search(queries[i], num_zero+1, knn_ind_i, knn_dist_i);
+	dist = knn_dist_i[num_zero];
+	ind.assign(knn_ind_i.begin(), knn_ind_i.begin() + num_zero);
+	k_vec[i] = num_zero;
       }
-      delete [] knn_ind_i;
-      delete [] knn_dist_i;
     }
     distances[i] = dist;
-    indices[i] = ind;
-    delete [] knn_ind;
-    delete [] knn_dist;
+    if (indices)
+      (*indices)[i] = ind;
   }
-  delete kdTree;
-  annClose();
 }
 
 void NonDBayesCalibration::print_kl(std::ostream& s)
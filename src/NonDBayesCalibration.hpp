@@ -20,7 +20,7 @@
 #include "MarginalsCorrDistribution.hpp"
 #include "InvGammaRandomVariable.hpp"
 #include "GaussianKDE.hpp"
-#include "ANN/ANN.h" 
+#include "NearestNeighborIndex.hpp"
 
 //#define DEBUG
 
@@ -82,7 +82,8 @@ public:
   static Real knn_kl_div(RealMatrix& distX_samples, RealMatrix& distY_samples,
       		size_t dim); 
   static Real knn_mutual_info(RealMatrix& Xmatrix, int dimX, int dimY,
-			      unsigned short alg);
+			      unsigned short alg,
+			      const NearestNeighborIndex* indexX = NULL);
 
 protected:
 
@@ -536,13 +537,12 @@ protected:
   void kl_post_prior(RealMatrix& acceptanceChain);
   void prior_sample_matrix(RealMatrix& prior_dist_samples);
   void mutual_info_buildX();
-  static void ann_dist(const ANNpointArray matrix1, const ANNpointArray matrix2,
-     		RealVector& distances, int NX, int NY, int dim2, IntVector& k, 
-		double eps);
-  static void ann_dist(const ANNpointArray matrix1, 
-                const ANNpointArray matrix2, RealVector& distances, 
-		Int2DArray& indices, int NX, int NY, int dim2, 
-		IntVector& k, double eps);
+  /// distances from each query to its k_vec[i]-th nearest indexed
+  /// point, optionally with the indices of the nearest points
+  static void knn_distances(const NearestNeighborIndex& index,
+			    const std::vector<const Real*>& queries,
+			    RealVector& distances, IntVector& k_vec,
+			    Int2DArray* indices = NULL);
   Real kl_est;	
   void print_kl(std::ostream& stream);		
   void print_chain_diagnostics(std::ostream& s);
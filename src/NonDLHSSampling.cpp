@@ -42,9 +42,6 @@ static const char rcsId[]="@(#) $Id: NonDLHSSampling.cpp 7035 2010-10-22 21:45:3
 
 namespace Dakota {
 
-// instance of static member variables
-RealArray NonDLHSSampling::rawData;
-
 /** This constructor is called for a standard letter-envelope iterator 
     instantiation.  In this case, set_db_list_nodes has been called and 
     probDescDB can be queried for settings from the method specification. */
@@ -57,7 +54,9 @@ NonDLHSSampling::NonDLHSSampling(ProblemDescDB& problem_db, Model& model):
   pcaFlag(probDescDB.get_bool("method.principal_components")),
   varBasedDecompFlag(probDescDB.get_bool("method.variance_based_decomp")),
   percentVarianceExplained(
-    probDescDB.get_real("method.percent_variance_explained"))
+    probDescDB.get_real("method.percent_variance_explained")),
+  streamingStats(probDescDB.get_bool("method.streaming_statistics")),
+  streamChunkSize(probDescDB.get_sizet("method.nond.streaming_chunk_size"))
 {
   // sampleType default in DataMethod.cpp is SUBMETHOD_DEFAULT (0).
   // Enforce an LHS default for this method.
@@ -116,6 +115,18 @@ NonDLHSSampling::NonDLHSSampling(ProblemDescDB& problem_db, Model& model):
 	     << "final design will not." << std::endl;
     }
   }
+  if (streamingStats) {
+    if (varBasedDecompFlag || pcaFlag || dOptimal || !refineSamples.empty() ||
+	wilksFlag || stdRegressionCoeffs || toleranceIntervalsFlag) {
+      Cerr << "\nError: 'streaming_statistics' does not support "
+	   << "variance_based_decomp, principal_components,\n       d_optimal, "
+	   << "refinement_samples, wilks, std_regression_coeffs, or\n       "
+	   << "tolerance_intervals, which require the full sample set.\n";
+      abort_handler(METHOD_ERROR);
+    }
+    if (!streamChunkSize)
+      streamChunkSize = 10000;
+  }
   qoiSamplesMatrix.shape(numFunctions, 0);
 
   initialize_final_statistics();
@@ -134,7 +145,8 @@ NonDLHSSampling(Model& model, unsigned short sample_type, int samples,
   NonDSampling(RANDOM_SAMPLING, model, sample_type, samples, seed, rng,
 	       vary_pattern, sampling_vars_mode),
   numResponseFunctions(numFunctions), dOptimal(false), oversampleRatio(0.0),
-  pcaFlag(false), varBasedDecompFlag(false)
+  pcaFlag(false), varBasedDecompFlag(false), streamingStats(false),
+  streamChunkSize(0)
 { }
 
 
@@ -153,7 +165,8 @@ NonDLHSSampling(unsigned short sample_type, int samples, int seed,
 		const RealVector& upper_bnds): 
   NonDSampling(sample_type, samples, seed, rng, lower_bnds, upper_bnds),
   numResponseFunctions(0), dOptimal(false), oversampleRatio(0.0), 
-  pcaFlag(false), varBasedDecompFlag(false)
+  pcaFlag(false), varBasedDecompFlag(false), streamingStats(false),
+  streamChunkSize(0)
 {
   // since there will be no late data updates to capture in this case
   // (no sampling_reset()), go ahead and get the parameter sets.
@@ -175,7 +188,8 @@ NonDLHSSampling(unsigned short sample_type, int samples, int seed,
   NonDSampling(sample_type, samples, seed, rng, means, std_devs,
 	       lower_bnds, upper_bnds, correl),
   numResponseFunctions(0), dOptimal(false), oversampleRatio(0.0),
-  pcaFlag(false), varBasedDecompFlag(false)
+  pcaFlag(false), varBasedDecompFlag(false), streamingStats(false),
+  streamChunkSize(0)
 {
   // since there will be no late data updates to capture in this case
   // (no sampling_reset()), go ahead and get the parameter sets.
@@ -221,6 +235,18 @@ void NonDLHSSampling::pre_run()
     return;
   }
 
+  // samples are generated in chunks within core_run()
+  if (streaming_statistics()) {
+    const ShortArray& final_asv = finalStatistics.active_set_request_vector();
+    for (size_t i=0; i<final_asv.size(); ++i)
+      if (final_asv[i] & 2) {
+	Cerr << "\nError: 'streaming_statistics' does not support gradients "
+	     << "of final statistics." << std::endl;
+	abort_handler(METHOD_ERROR);
+      }
+    return;
+  }
+
   // DataFitSurrModel sets subIteratorFlag; if true it will manage
   // batch increments 
   // BMA TODO: refactor to handle increments more gracefully
@@ -446,20 +472,14 @@ store_ranks(const RealMatrix& sample_values, IntMatrix& sample_ranks)
     for (int s=0; s<num_samples; ++s)
       sample_ranks(v,s) = boost::math::round(sampleRanks(v,s));
 
-  // compute and store the discrete ranks
-  IntArray rank_col(num_samples), final_rank(num_samples);
-  rawData.resize(num_samples);
+  // compute and store the discrete ranks, reading the strided row in place
+  SizetArray final_rank;
   for (size_t v=numContinuousVars; v<num_vars; ++v) {
-    for (size_t rank_count = 0; rank_count < num_samples; rank_count++){
-      rank_col[rank_count] = rank_count;
-      rawData[rank_count] = sample_values[rank_count][v];
-    }
-    std::sort(rank_col.begin(), rank_col.end(), rank_sort);
+    ordinal_ranks(sample_values.values() + v, num_samples, final_rank,
+		  sample_values.stride());
     for (size_t s=0; s<num_samples; ++s)
-      final_rank[rank_col[s]] = s;
-    for (size_t s=0; s<num_samples; ++s) // can't be combined with loop above
       sample_ranks(v, s) = final_rank[s] + 1;
-    }
+  }
 }
 
 
@@ -484,37 +504,26 @@ combine_discrete_ranks(const RealMatrix& initial_values,
   const int previous_samples = initial_values.numCols();
   const int new_samples = increm_values.numCols();
   const int total_samples = previous_samples + new_samples;
-  IntArray rank_col(total_samples), final_rank(total_samples);
-  rawData.resize(total_samples);
+  RealArray raw_data(total_samples);
+  SizetArray final_rank;
 
   // vars_start lets us skip the continuous variables
   for (size_t v=numContinuousVars; v<num_vars; ++v) {
-    for (size_t rank_count = 0; rank_count < previous_samples; rank_count++){
-      rank_col[rank_count] = rank_count;
-      rawData[rank_count] = initial_values[rank_count][v];
-    }
-    for (size_t rank_count = previous_samples; rank_count < total_samples; 
-         rank_count++) {
-      rank_col[rank_count] = rank_count;
-      rawData[rank_count] = increm_values[rank_count-previous_samples][v];
-    }
-    std::sort(rank_col.begin(), rank_col.end(), rank_sort);
-    for (size_t s=0; s<total_samples; ++s)
-      final_rank[rank_col[s]] = s+1;
+    for (size_t s=0; s<previous_samples; ++s)
+      raw_data[s] = initial_values(v, s);
+    for (size_t s=previous_samples; s<total_samples; ++s)
+      raw_data[s] = increm_values(v, s-previous_samples);
+    ordinal_ranks(&raw_data[0], total_samples, final_rank);
 #ifdef DEBUG
     Cout << "final ranks " << final_rank << '\n';
-    Cout << "rawData " << rawData << '\n'; 
+    Cout << "raw_data " << raw_data << '\n'; 
 #endif
-    for (size_t s=0; s<total_samples; ++s) // can't be combined with loop above
-      sampleRanks(v, s) = final_rank[s];
+    for (size_t s=0; s<total_samples; ++s)
+      sampleRanks(v, s) = final_rank[s] + 1;
   }
 }
 
 
-bool NonDLHSSampling::rank_sort(const int& x, const int& y)
-{ return rawData[x]<rawData[y]; }
-
-
 /** For now, when this function is called, numSamples is the number of
     new samples to generate. */
 void NonDLHSSampling::
@@ -663,6 +672,9 @@ void NonDLHSSampling::post_input()
     statistics on the set of responses if statsFlag is set. */
 void NonDLHSSampling::core_run()
 {
+  if (streaming_statistics())
+    { evaluate_parameter_set_chunks(); return; }
+
   bool log_resp_flag = (allDataFlag || statsFlag);
   bool log_best_flag = !numResponseFunctions; // DACE mode w/ opt or NLS
   evaluate_parameter_sets(iteratedModel, log_resp_flag, log_best_flag);
@@ -672,6 +684,38 @@ void NonDLHSSampling::core_run()
   //store_evaluations(); 
 }
 
+/** Memory use is bounded by the chunk size rather than the number of
+    samples.  Each chunk after the first continues the random number
+    sequence, so an LHS run is a replicated LHS composed of
+    independent Latin designs of the chunk size.  Evaluations are
+    synchronized at the end of each chunk, so the chunk size should
+    be large relative to the evaluation concurrency. */
+void NonDLHSSampling::evaluate_parameter_set_chunks()
+{
+  size_t cv_start, num_cv, div_start, num_div, dsv_start, num_dsv,
+    drv_start, num_drv;
+  mode_counts(iteratedModel.current_variables(), cv_start, num_cv, div_start,
+	      num_div, dsv_start, num_dsv, drv_start, num_drv);
+  initialize_accumulators(num_cv + num_div + num_dsv + num_drv);
+
+  bool log_best_flag = !numResponseFunctions, // DACE mode w/ opt or NLS
+    vary_pattern = varyPattern;
+  size_t num_chunk, num_evaluated = 0;
+  while (num_evaluated < numSamples) {
+    num_chunk = std::min(streamChunkSize, numSamples - num_evaluated);
+    get_parameter_sets(iteratedModel, num_chunk, allSamples,
+		       num_evaluated == 0);
+    evaluate_parameter_sets(iteratedModel, true, log_best_flag);
+    accumulate_statistics(allSamples, allResponses);
+    allResponses.clear();
+    num_evaluated += num_chunk;
+    varyPattern = true; // continue the sequence for the next chunk
+  }
+  varyPattern = vary_pattern;
+  allSamples.shape(0, 0);
+}
+
+
 void NonDLHSSampling::store_evaluations(){
   int eval_index = 0; //qoiSamplesMatrix.numCols(); //old size
   qoiSamplesMatrix.reshape(numFunctions, numSamples);
@@ -748,7 +792,10 @@ void NonDLHSSampling::post_run(std::ostream& s)
       // iteratively called by print_results. However, when the sampling iterator 
       // is a subiterator (e.g. in a nested model), print_results isn't called.
       // Compute stats here for all samples.
-      compute_statistics(allSamples, allResponses);
+      if (streaming_statistics())
+        compute_accumulated_statistics();
+      else
+        compute_statistics(allSamples, allResponses);
       // JAS TODO
       archive_results(numSamples); 
     }
@@ -1035,7 +1082,12 @@ void NonDLHSSampling::print_results(std::ostream& s, short results_state)
                                      iteratedModel.response_labels(),
                                      vbdDropTol);
   else if (statsFlag) {
-    if(refineSamples.length() == 0) {
+    if (streaming_statistics()) {
+      compute_accumulated_statistics();
+      archive_results(numSamples);
+      print_header_and_statistics(s, numSamples);
+    }
+    else if(refineSamples.length() == 0) {
       compute_statistics(allSamples, allResponses);
       archive_results(numSamples);
       int actual_samples = allSamples.numCols();
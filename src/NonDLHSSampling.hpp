@@ -135,9 +135,6 @@ protected:
   void combine_discrete_ranks(const RealMatrix& initial_values, 
                               const RealMatrix& increm_values);
 
-  /// sort algorithm to compute ranks for rank correlations
-  static bool rank_sort(const int& x, const int& y);
-
   /// Print a header and summary statistics
   void print_header_and_statistics(std::ostream& s, const int& num_samples);
 
@@ -147,6 +144,13 @@ protected:
   /// Store samples in a matrix for bootstrapping
   void store_evaluations();
 
+  /// generate and evaluate the samples in chunks, folding each chunk
+  /// into the one-pass statistics accumulators
+  void evaluate_parameter_set_chunks();
+  /// whether statistics are accumulated from chunks of samples that
+  /// are not retained
+  bool streaming_statistics() const;
+
   Real bootstrap_covariance(const size_t qoi);
 
 private:
@@ -170,9 +174,6 @@ private:
   /// oversampling ratio for Leja D-optimal candidate set generation
   Real oversampleRatio;
 
-  /// static data used by static rank_sort() fn
-  static RealArray rawData;
-
   /// flags computation of variance-based decomposition indices
   bool varBasedDecompFlag;
 
@@ -184,8 +185,21 @@ private:
 
   /// Datastructure to store samples which can be used for bootstrapping
   RealMatrix qoiSamplesMatrix;
+
+  /// flags accumulation of statistics from chunks of samples that are
+  /// released after evaluation, rather than from the full sample set
+  bool streamingStats;
+  /// number of samples generated and evaluated per chunk when
+  /// streamingStats is set
+  size_t streamChunkSize;
 };
 
+
+/** Streaming is bypassed when the full sample set is required by the
+    calling context (e.g., to build a surrogate). */
+inline bool NonDLHSSampling::streaming_statistics() const
+{ return streamingStats && !allDataFlag; }
+
 } // namespace Dakota
 
 #endif
@@ -299,6 +299,9 @@ void NonDPOFDarts::core_run()
         _Lip = new double[numFunctions];
         for (size_t resp_fn_count = 0; resp_fn_count < numFunctions; resp_fn_count++) _Lip[resp_fn_count] = 0.0;
         
+        _sample_index = new NearestNeighborIndex(_n_dim);
+        _max_sphere_radius_sq = 0.0;
+        
     }
     
     void NonDPOFDarts::exit_pof_darts()
@@ -318,6 +321,7 @@ void NonDPOFDarts::core_run()
         delete[] _sample_points;
         delete[] _sample_neighbors;
         delete[] _sample_vsize;
+        delete _sample_index;
         for (size_t resp_fn_count = 0; resp_fn_count < numFunctions; resp_fn_count++) delete[] _fval[resp_fn_count];
         
         delete[] _fval;
@@ -343,6 +347,7 @@ void NonDPOFDarts::core_run()
                 
                 // adjust prior sphere radii to reflect current response function and threshold
                 for (size_t isample = 0; isample < _num_inserted_points; isample++) assign_sphere_radius_POF(isample);
+                update_max_sphere_radius();
                 
                 start_time = clock();
                 if (kd == 0)
@@ -431,6 +436,7 @@ void NonDPOFDarts::core_run()
                     {
                         assign_sphere_radius_POF(isample);
                     }
+                    update_max_sphere_radius();
                     
                     //std::cout<< "\npof:: Void-finding budget has been exhausted, shrinking BIG disks!" << std::endl;
                     //shrink_big_spheres();
@@ -552,6 +558,7 @@ void NonDPOFDarts::core_run()
                     {
                         assign_sphere_radius_POF(isample);
                     }
+                    update_max_sphere_radius();
                     //std::cout<< "\npof:: Void-finding budget has been exhausted, shrinking all disks!" << std::endl;
                     //shrink_big_spheres();
                 }
@@ -566,8 +573,12 @@ void NonDPOFDarts::core_run()
 
     bool NonDPOFDarts::valid_dart(double* x)
     {
-        for (size_t index = 0; index < _num_inserted_points; index++)
+        // only disks centered within the largest radius can cover the dart
+        SizetArray candidates;
+        _sample_index->within(x, _max_sphere_radius_sq, candidates);
+        for (size_t icand = 0; icand < candidates.size(); icand++)
         {
+            size_t index = candidates[icand];
             double dd(0.0);
             for (size_t idim = 0; idim < _n_dim; idim++)
             {
@@ -582,8 +593,25 @@ void NonDPOFDarts::core_run()
     
     bool NonDPOFDarts::valid_line_flat(size_t flat_dim, double* flat_dart)
     {
-        for (size_t index = 0; index < _num_inserted_points; index++)
+        // only disks centered in the slab of half-width equal to the largest
+        // radius about the flat can cut it; visit them in insertion order
+        double r_max = std::sqrt(_max_sphere_radius_sq);
+        double* lower = new double[_n_dim];
+        double* upper = new double[_n_dim];
+        for (size_t idim = 0; idim < _n_dim; idim++)
         {
+            lower[idim] = flat_dart[idim] - r_max;
+            upper[idim] = flat_dart[idim] + r_max;
+        }
+        lower[flat_dim] = -std::numeric_limits<double>::infinity();
+        upper[flat_dim] =  std::numeric_limits<double>::infinity();
+        SizetArray candidates;
+        _sample_index->within_box(lower, upper, candidates);
+        delete[] lower; delete[] upper;
+        
+        for (size_t icand = 0; icand < candidates.size(); icand++)
+        {
+            size_t index = candidates[icand];
             double hh(0.0);
             for (size_t idim = 0; idim < _n_dim; idim++)
             {
@@ -674,6 +702,7 @@ void NonDPOFDarts::core_run()
         _sample_neighbors[_num_inserted_points][0] = 0;
         
         for (size_t idim = 0; idim < _n_dim; idim++) _sample_points[_num_inserted_points][idim] = x[idim];
+        _sample_index->insert(_sample_points[_num_inserted_points]);
         
         double* x_actual = new double[_n_dim];
         for (size_t idim = 0; idim < _n_dim; idim++) x_actual[idim] = _xmin[idim] + x[idim] * (_xmax[idim] - _xmin[idim]);
@@ -702,6 +731,7 @@ void NonDPOFDarts::core_run()
         {
             update_global_L();
             for (size_t isample = 0; isample < _num_inserted_points; isample++) assign_sphere_radius_POF(isample);
+            update_max_sphere_radius();
         }
         delete [] x_actual;
     }
@@ -782,6 +812,10 @@ void NonDPOFDarts::core_run()
         double* qH = new double[_n_dim];         // mid-ppint
         double* nH = new double[_n_dim];         // normal vector
         
+        // nearest samples, for a first bound on the trimmed spokes
+        SizetArray near_points; RealArray near_dists;
+        _sample_index->search(_sample_points[ipoint], std::min(_num_inserted_points, 2 * _n_dim + 1), near_points, near_dists);
+        
         _sample_vsize[ipoint] = 0.0;
         size_t num_neighbors(0), num_misses(0), max_misses(10);
         while (num_misses < max_misses)
@@ -825,27 +859,7 @@ void NonDPOFDarts::core_run()
             for (size_t idim = 0; idim < _n_dim; idim++) tmp_pnt[idim] = _sample_points[ipoint][idim] + t_end * (tmp_pnt[idim] - _sample_points[ipoint][idim]);
             
             // trim spoke using Voronoi faces
-            size_t ineighbor(ipoint);
-            for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
-            {
-                if (jpoint == ipoint) continue;
-                
-                // trim line spoke via hyperplane between
-                double norm(0.0);
-                for (size_t idim = 0; idim < _n_dim; idim++)
-                {
-                    qH[idim] = 0.5 * (_sample_points[ipoint][idim] + _sample_points[jpoint][idim]);
-                    nH[idim] =  _sample_points[jpoint][idim] -  _sample_points[ipoint][idim];
-                    norm+= nH[idim] * nH[idim];
-                }
-                norm = 1.0 / std::sqrt(norm);
-                for (size_t idim = 0; idim < _n_dim; idim++) nH[idim] *= norm;
-                
-                if (trim_line_using_Hyperplane(_n_dim, _sample_points[ipoint], tmp_pnt, qH, nH))
-                {
-                    ineighbor = jpoint;
-                }
-            }
+            size_t ineighbor = trim_spoke(ipoint, tmp_pnt, near_points, qH, nH);
             
             double dst = 0.0;
             for (size_t idim = 0; idim < _n_dim; idim++)
@@ -911,6 +925,10 @@ void NonDPOFDarts::core_run()
         double* qH = new double[_n_dim];         // mid-ppint
         double* nH = new double[_n_dim];         // normal vector
         
+        // nearest samples, for a first bound on the trimmed spokes
+        SizetArray near_points; RealArray near_dists;
+        _sample_index->search(_sample_points[ipoint], std::min(_num_inserted_points, 2 * _n_dim + 1), near_points, near_dists);
+        
         double vsize = 0.0;
         for (size_t ispoke = 0; ispoke < 10000; ispoke++)
         {
@@ -953,27 +971,7 @@ void NonDPOFDarts::core_run()
             for (size_t idim = 0; idim < _n_dim; idim++) tmp_pnt[idim] = _sample_points[ipoint][idim] + t_end * (tmp_pnt[idim] - _sample_points[ipoint][idim]);
             
             // trim spoke using Voronoi faces
-            size_t ineighbor(ipoint);
-            for (size_t jpoint = 0; jpoint < _num_inserted_points; jpoint++)
-            {
-                if (jpoint == ipoint) continue;
-                
-                // trim line spoke via hyperplane between
-                double norm(0.0);
-                for (size_t idim = 0; idim < _n_dim; idim++)
-                {
-                    qH[idim] = 0.5 * (_sample_points[ipoint][idim] + _sample_points[jpoint][idim]);
-                    nH[idim] =  _sample_points[jpoint][idim] -  _sample_points[ipoint][idim];
-                    norm+= nH[idim] * nH[idim];
-                }
-                norm = 1.0 / std::sqrt(norm);
-                for (size_t idim = 0; idim < _n_dim; idim++) nH[idim] *= norm;
-                
-                if (trim_line_using_Hyperplane(_n_dim, _sample_points[ipoint], tmp_pnt, qH, nH))
-                {
-                    ineighbor = jpoint;
-                }
-            }
+            trim_spoke(ipoint, tmp_pnt, near_points, qH, nH);
             
             double dst = 0.0;
             for (size_t idim = 0; idim < _n_dim; idim++)
@@ -993,6 +991,67 @@ void NonDPOFDarts::core_run()
         delete[] tmp_pnt; delete[] qH; delete[] nH;
     }
 
+
+    size_t NonDPOFDarts::trim_spoke(size_t ipoint, double* spoke_end, const SizetArray& near_points, double* qH, double* nH)
+    {
+        // The face shared with jpoint cuts the spoke only if the spoke reaches past
+        // the mid-point, i.e., |x_j - x_i| <= 2 * length. Bound the trimmed length
+        // using the nearest samples, then trim by the faces of the samples within
+        // twice that bound, in insertion order as for a full scan.
+        double* x = _sample_points[ipoint];
+        double spoke_sq(0.0);
+        for (size_t idim = 0; idim < _n_dim; idim++)
+        {
+            double dx = spoke_end[idim] - x[idim];
+            spoke_sq += dx * dx;
+        }
+        
+        double t_bound(1.0);
+        for (size_t i = 0; i < near_points.size(); i++)
+        {
+            size_t jpoint = near_points[i];
+            if (jpoint == ipoint) continue;
+            
+            double dd(0.0), de(0.0);
+            for (size_t idim = 0; idim < _n_dim; idim++)
+            {
+                double dx = _sample_points[jpoint][idim] - x[idim];
+                dd += dx * dx;
+                de += dx * (spoke_end[idim] - x[idim]);
+            }
+            if (dd > 0.0 && 0.5 * dd < t_bound * de) t_bound = 0.5 * dd / de;
+        }
+        
+        SizetArray candidates;
+        _sample_index->within(x, 4.0 * t_bound * t_bound * spoke_sq * (1.0 + 1E-10), candidates);
+        
+        size_t ineighbor(ipoint);
+        for (size_t i = 0; i < candidates.size(); i++)
+        {
+            size_t jpoint = candidates[i];
+            if (jpoint == ipoint) continue;
+            
+            if (trim_spoke_using_face(ipoint, jpoint, spoke_end, qH, nH)) ineighbor = jpoint;
+        }
+        return ineighbor;
+    }
+    
+    bool NonDPOFDarts::trim_spoke_using_face(size_t ipoint, size_t jpoint, double* spoke_end, double* qH, double* nH)
+    {
+        // trim line spoke via hyperplane between
+        double norm(0.0);
+        for (size_t idim = 0; idim < _n_dim; idim++)
+        {
+            qH[idim] = 0.5 * (_sample_points[ipoint][idim] + _sample_points[jpoint][idim]);
+            nH[idim] =  _sample_points[jpoint][idim] -  _sample_points[ipoint][idim];
+            norm+= nH[idim] * nH[idim];
+        }
+        norm = 1.0 / std::sqrt(norm);
+        for (size_t idim = 0; idim < _n_dim; idim++) nH[idim] *= norm;
+        
+        return trim_line_using_Hyperplane(_n_dim, _sample_points[ipoint], spoke_end, qH, nH);
+    }
+
     
     
     
@@ -1064,6 +1123,7 @@ void NonDPOFDarts::core_run()
         
         _sample_points[isample][_n_dim] = r * r;
         if (_fval[_active_response_function][isample] < _failure_threshold) _sample_points[isample][_n_dim] = - _sample_points[isample][_n_dim];
+        if (r * r > _max_sphere_radius_sq) _max_sphere_radius_sq = r * r;
         
         if (_use_local_L)
         {
@@ -1071,8 +1131,13 @@ void NonDPOFDarts::core_run()
             
             // A sphere shouldn't contain a sample point that is not its neighbor
             
-            for (size_t jsample = 0; jsample < _num_inserted_points; jsample++)
+            // radii only shrink below, so only samples within r_i + r_max can overlap
+            double r_reach = r + std::sqrt(_max_sphere_radius_sq);
+            SizetArray candidates;
+            _sample_index->within(_sample_points[isample], r_reach * r_reach * (1.0 + 1E-10), candidates);
+            for (size_t icand = 0; icand < candidates.size(); icand++)
             {
+                size_t jsample = candidates[icand];
                 //if (_sample_points[isample][_n_dim] * _sample_points[jsample][_n_dim] > 0.0) continue; // same color
                 
                 if (isample == jsample) continue;
@@ -1109,6 +1174,16 @@ void NonDPOFDarts::core_run()
     }
     
        
+    void NonDPOFDarts::update_max_sphere_radius()
+    {
+        _max_sphere_radius_sq = 0.0;
+        for (size_t isample = 0; isample < _num_inserted_points; isample++)
+        {
+            double r_sq = fabs(_sample_points[isample][_n_dim]);
+            if (r_sq > _max_sphere_radius_sq) _max_sphere_radius_sq = r_sq;
+        }
+    }
+    
     void NonDPOFDarts::shrink_big_spheres()
     {
         double rr_max(0.0);
@@ -21,6 +21,7 @@
 #include "DakotaNonD.hpp"
 #include "DakotaApproximation.hpp"
 #include "VPSApproximation.hpp"
+#include "NearestNeighborIndex.hpp"
 
 
 
@@ -104,6 +105,15 @@ protected:
     void retrieve_neighbors(size_t ipoint, bool update_point_neighbors);
     
     void sample_furthest_vertex(size_t ipoint, double* fv);
+    
+    /// trim a spoke from ipoint to spoke_end by the Voronoi faces of
+    /// ipoint, using the sample index to visit only the samples whose
+    /// faces can cross it; returns the last trimming sample (ipoint if none)
+    size_t trim_spoke(size_t ipoint, double* spoke_end, const SizetArray& near_points,
+                      double* qH, double* nH);
+    
+    bool trim_spoke_using_face(size_t ipoint, size_t jpoint, double* spoke_end,
+                               double* qH, double* nH);
 
     
     ////////////////////////////////////////////////////////////////
@@ -116,6 +126,8 @@ protected:
     
     void  shrink_big_spheres(); // shrink all disks by 90% to allow more sampling
     
+    void update_max_sphere_radius(); // exact bound after reassigning all radii
+    
     double area_triangle(double x1, double y1, double x2, double y2, double x3, double y3);
    
     //////////////////////////////////////////////////////////////
@@ -199,6 +211,8 @@ protected:
     size_t** _sample_neighbors;
     double*  _sample_vsize;
     double   _max_vsize; // size of biggest Voronoi cell
+    NearestNeighborIndex* _sample_index; // kd-tree over the sample points (radius excluded)
+    double   _max_sphere_radius_sq; // upper bound on the squared sphere radii
     
     // Darts
     double* _dart; // a dart for inserting a new sample point
@@ -976,6 +976,46 @@ void NonDSampling::core_run()
 void NonDSampling::
 compute_statistics(const RealMatrix&     vars_samples,
 		   const IntResponseMap& resp_samples)
+{
+  archive_statistics_labels();
+
+  if (epistemicStats) { // Epistemic/mixed
+    compute_intervals(resp_samples); // compute min/max response intervals
+  }
+  else { // Aleatory
+    // compute means and std deviations with confidence intervals
+    compute_moments(resp_samples);
+    // compute CDF/CCDF mappings of z to p/beta and p/beta to z
+    if (totalLevelRequests)
+      compute_level_mappings(resp_samples);
+  }
+
+  if (!subIteratorFlag) {
+    nonDSampCorr.compute_correlations(vars_samples, resp_samples);
+  }
+
+  if (stdRegressionCoeffs) {
+    nonDSampCorr.compute_std_regress_coeffs(vars_samples, resp_samples);
+  }
+
+  if (toleranceIntervalsFlag) {
+    computeDSTIEN( resp_samples
+                 , tiCoverage
+                 , 1. - tiConfidenceLevel
+                 , tiNumValidSamples           // Output
+                 , tiDstienMus                 // Output
+                 , tiDeltaMultiplicativeFactor // Output
+                 , tiSampleSigmas              // Output
+                 , tiDstienSigmas              // Output
+                 );
+  }
+
+  // push results into finalStatistics
+  update_final_statistics();
+}
+
+
+void NonDSampling::archive_statistics_labels()
 {
   StringMultiArrayConstView
     acv_labels  = iteratedModel.all_continuous_variable_labels(),
@@ -1009,40 +1049,235 @@ compute_statistics(const RealMatrix&     vars_samples,
     resultsDB.insert(run_identifier(), resultsNames.fn_labels, 
 		     iteratedModel.response_labels());
   }
+}
 
-  if (epistemicStats) { // Epistemic/mixed
-    compute_intervals(resp_samples); // compute min/max response intervals
+
+/** Statistics are accumulated in one pass and the samples need not be
+    retained, so that memory use is independent of the number of
+    samples.  Rank correlations, regression coefficients, tolerance
+    intervals, and moment gradients require the full sample set and
+    are not supported. */
+void NonDSampling::initialize_accumulators(size_t num_vars)
+{
+  momentAccumulators.assign(numFunctions, MomentAccumulator());
+  quantileSketches.assign(numFunctions, QuantileSketch());
+  levelBinCounts.assign(numFunctions, SizetArray());
+  if (!epistemicStats)
+    for (size_t i=0; i<numFunctions; ++i)
+      if (!requestedRespLevels[i].empty() && respLevelTarget != RELIABILITIES)
+	levelBinCounts[i].assign(requestedRespLevels[i].length()+1, 0);
+  corrAccumulator.initialize((subIteratorFlag) ? 0 : num_vars + numFunctions);
+}
+
+
+void NonDSampling::
+accumulate_statistics(const RealMatrix&     vars_samples,
+		      const IntResponseMap& resp_samples)
+{
+  size_t i, j, k, num_obs = resp_samples.size(), num_valid = 0,
+    num_vars = vars_samples.numRows();
+  bool corr = (corrAccumulator.means().length() > 0);
+  BoolDeque valid_sample(num_obs, true);
+
+  IntRespMCIter r_it; Real sample;
+  for (r_it=resp_samples.begin(), j=0; r_it!=resp_samples.end(); ++r_it, ++j) {
+    const RealVector& fn_vals = r_it->second.function_values();
+    for (i=0; i<numFunctions; ++i) {
+      sample = fn_vals[i];
+      momentAccumulators[i].push(sample);
+      if (!std::isfinite(sample))
+	{ valid_sample[j] = false; continue; }
+      if (!epistemicStats && ( !requestedProbLevels[i].empty() ||
+			       !requestedGenRelLevels[i].empty() ))
+	quantileSketches[i].push(sample);
+      SizetArray& bins = levelBinCounts[i];
+      if (!bins.empty()) { // cumulative p(g<=z) bins, as in level mappings
+	const RealVector& req_rl_i = requestedRespLevels[i];
+	size_t rl_len = req_rl_i.length();
+	for (k=0; k<rl_len; ++k)
+	  if (sample <= req_rl_i[k])
+	    break;
+	++bins[k];
+      }
+    }
+    if (valid_sample[j]) ++num_valid;
+  }
+
+  // correlations omit any sample with a non-finite response
+  if (corr && num_valid) {
+    RealMatrix valid_data(num_vars + numFunctions, num_valid, false);
+    for (r_it=resp_samples.begin(), j=0, k=0; r_it!=resp_samples.end();
+	 ++r_it, ++j)
+      if (valid_sample[j]) {
+	const RealVector& fn_vals = r_it->second.function_values();
+	for (i=0; i<num_vars; ++i)
+	  valid_data(i,k) = vars_samples(i,j);
+	for (i=0; i<numFunctions; ++i)
+	  valid_data(num_vars+i,k) = fn_vals[i];
+	++k;
+      }
+    corrAccumulator.push(valid_data);
+  }
+}
+
+
+void NonDSampling::compute_accumulated_statistics()
+{
+  archive_statistics_labels();
+
+  size_t i;
+  if (epistemicStats) { // Epistemic/mixed: min/max response intervals
+    const StringArray& resp_labels = iteratedModel.response_labels();
+    extremeValues.resize(numFunctions);
+    for (i=0; i<numFunctions; ++i) {
+      const MomentAccumulator& acc = momentAccumulators[i];
+      extremeValues[i].first  = acc.min();
+      extremeValues[i].second = acc.max();
+      if (acc.num_omitted())
+	Cerr << "Warning: sampling statistics for " << resp_labels[i]
+	     << " omit " << acc.num_omitted() << " failed evaluations out of "
+	     << acc.count() + acc.num_omitted() << " samples.\n";
+    }
+    if (resultsDB.active()) {
+      MetaDataType md;
+      md["Row Labels"] = make_metadatavalue("Min", "Max");
+      md["Column Labels"] = make_metadatavalue(resp_labels);
+      resultsDB.insert(run_identifier(), resultsNames.extreme_values,
+		       extremeValues, md);
+    }
   }
   else { // Aleatory
-    // compute means and std deviations with confidence intervals
-    compute_moments(resp_samples);
-    // compute CDF/CCDF mappings of z to p/beta and p/beta to z
+    compute_accumulated_moments();
     if (totalLevelRequests)
-      compute_level_mappings(resp_samples);
+      compute_accumulated_level_mappings();
   }
 
   if (!subIteratorFlag) {
-    nonDSampCorr.compute_correlations(vars_samples, resp_samples);
+    size_t num_corr = corrAccumulator.means().length();
+    nonDSampCorr.compute_correlations(corrAccumulator.comoments(),
+				      num_corr - numFunctions,
+				      corrAccumulator.count());
   }
 
-  if (stdRegressionCoeffs) {
-    nonDSampCorr.compute_std_regress_coeffs(vars_samples, resp_samples);
+  // push results into finalStatistics
+  update_final_statistics();
+}
+
+
+void NonDSampling::compute_accumulated_moments()
+{
+  const StringArray& labels = iteratedModel.response_labels();
+  bool central = (finalMomentsType == Pecos::CENTRAL_MOMENTS);
+  if (momentStats.empty()) momentStats.shapeUninitialized(4, numFunctions);
+  SizetArray sample_counts(numFunctions);
+  for (size_t i=0; i<numFunctions; ++i) {
+    const MomentAccumulator& acc = momentAccumulators[i];
+    size_t num_samp = sample_counts[i] = acc.count();
+    if (acc.num_omitted())
+      Cerr << "Warning: sampling statistics for " << labels[i] << " omit "
+	   << acc.num_omitted() << " failed evaluations out of "
+	   << num_samp + acc.num_omitted() << " samples.\n";
+    if (!num_samp)
+      Cerr << "Warning: Number of samples for " << labels[i]
+	   << " must be nonzero for moment calculation in NonDSampling::"
+	   << "compute_accumulated_moments().\n";
+    acc.moments(central, momentStats[i]); // NaN if no samples
   }
+  compute_moment_confidence_intervals(momentStats, momentCIs, sample_counts,
+				      finalMomentsType);
+  functionMomentsComputed = true;
+}
 
-  if (toleranceIntervalsFlag) {
-    computeDSTIEN( resp_samples
-                 , tiCoverage
-                 , 1. - tiConfidenceLevel
-                 , tiNumValidSamples           // Output
-                 , tiDstienMus                 // Output
-                 , tiDeltaMultiplicativeFactor // Output
-                 , tiSampleSigmas              // Output
-                 , tiDstienSigmas              // Output
-                 );
+
+/** Response levels are mapped to probabilities from exact bin counts
+    and probability levels to response levels by interpolation within
+    quantile summaries, which reproduce the sorted sample interpolation
+    of compute_level_mappings() until the summary is first compressed
+    (5000 samples). */
+void NonDSampling::compute_accumulated_level_mappings()
+{
+  initialize_level_mappings();
+  archive_allocate_mappings();
+
+  size_t i, j, num_samp, bin_accumulator;
+  bool extrapolated_mappings = false,
+    central_mom = (finalMomentsType == Pecos::CENTRAL_MOMENTS);
+  if (pdfOutput) extremeValues.resize(numFunctions);
+  for (i=0; i<numFunctions; ++i) {
+
+    size_t rl_len = requestedRespLevels[i].length(),
+           pl_len = requestedProbLevels[i].length(),
+           bl_len = requestedRelLevels[i].length(),
+           gl_len = requestedGenRelLevels[i].length();
+    const MomentAccumulator& acc = momentAccumulators[i];
+    num_samp = acc.count();
+    if (pdfOutput) {
+      extremeValues[i].first  = acc.min();
+      extremeValues[i].second = acc.max();
+    }
+    Real mean = momentStats(0,i), stdev = (central_mom) ?
+      std::sqrt(momentStats(1,i)) : momentStats(1,i);
+
+    if (rl_len) {
+      switch (respLevelTarget) {
+      case PROBABILITIES: case GEN_RELIABILITIES: { // z -> p/beta* (binning)
+	const SizetArray& bins = levelBinCounts[i];
+	bin_accumulator = 0;
+	for (j=0; j<rl_len; ++j) {
+	  bin_accumulator += bins[j];
+	  Real cdf_prob = (Real)bin_accumulator/(Real)num_samp;
+	  Real computed_prob = (cdfFlag) ? cdf_prob : 1. - cdf_prob;
+	  if (respLevelTarget == PROBABILITIES)
+	    computedProbLevels[i][j] = computed_prob;
+	  else
+	    computedGenRelLevels[i][j]
+	      = -Pecos::NormalRandomVariable::inverse_std_cdf(computed_prob);
+	}
+	break;
+      }
+      case RELIABILITIES: // z -> beta (from moment projection)
+	for (j=0; j<rl_len; ++j) {
+	  Real z_bar = requestedRespLevels[i][j];
+	  if (!Pecos::is_small(stdev))
+	    computedRelLevels[i][j] = (cdfFlag) ?
+	      (mean - z_bar)/stdev : (z_bar - mean)/stdev;
+	  else
+	    computedRelLevels[i][j]
+	      = ( (cdfFlag && mean <= z_bar) || (!cdfFlag && mean > z_bar) )
+	      ? -Pecos::LARGE_NUMBER : Pecos::LARGE_NUMBER;
+	}
+	break;
+      }
+    }
+    for (j=0; j<pl_len+gl_len; ++j) { // p/beta* -> z
+      Real p = (j<pl_len) ? requestedProbLevels[i][j] :	Pecos::
+	NormalRandomVariable::std_cdf(-requestedGenRelLevels[i][j-pl_len]);
+      Real p_cdf = (cdfFlag) ? p : 1. - p;
+      // sample id = p * N as in compute_level_mappings(); index = id - 1
+      Real cdf_incr_id = p_cdf * (Real)num_samp;
+      if (cdf_incr_id < 1.) {
+	extrapolated_mappings = true;
+	Cerr << "Warning: extrapolation required for response " << i+1;
+	if (j<pl_len) Cerr <<    " for probability level " << j+1       <<".\n";
+	else Cerr << " for generalized reliability level " << j+1-pl_len<<".\n";
+      }
+      Real z = quantileSketches[i].value_at_rank(cdf_incr_id - 1.);
+      if (j<pl_len) computedRespLevels[i][j] = z;
+      else          computedRespLevels[i][j+bl_len] = z;
+    }
+    for (j=0; j<bl_len; ++j) { // beta_bar -> z
+      Real beta_bar = requestedRelLevels[i][j];
+      computedRespLevels[i][j+pl_len] = (cdfFlag) ?
+	mean - beta_bar * stdev : mean + beta_bar * stdev;
+    }
   }
 
-  // push results into finalStatistics
-  update_final_statistics();
+  if (extrapolated_mappings)
+    Cerr << "Warning: extrapolations required to evaluate inverse mappings.  "
+	 << "Consistent slope\n         (uniform density) assumed for "
+	 << "extrapolation into distribution tail.\n\n";
+
+  compute_densities(extremeValues);
 }
 
 
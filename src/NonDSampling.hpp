@@ -20,6 +20,7 @@
 #include "DakotaNonD.hpp"
 #include "LHSDriver.hpp"
 #include "SensAnalysisGlobal.hpp"
+#include "dakota_stat_util.hpp"
 
 namespace Dakota {
 
@@ -59,6 +60,16 @@ public:
   void compute_statistics(const RealMatrix&     vars_samples,
 			  const IntResponseMap& resp_samples);
 
+  /// reset the one-pass accumulators used to compute statistics
+  /// without retaining the samples, for num_vars sampled variables
+  void initialize_accumulators(size_t num_vars);
+  /// fold a set of samples into the one-pass accumulators
+  void accumulate_statistics(const RealMatrix&     vars_samples,
+			     const IntResponseMap& resp_samples);
+  /// counterpart to compute_statistics() for the samples folded into
+  /// the one-pass accumulators
+  void compute_accumulated_statistics();
+
   /// called by compute_statistics() to calculate min/max intervals
   /// using allResponses
   void compute_intervals(RealRealPairArray& extreme_fns);
@@ -385,12 +396,35 @@ protected:
   /// to archive the moments
   bool functionMomentsComputed;
 
+  /// one-pass moment and extreme value accumulators for each response
+  /// function, used by compute_accumulated_statistics()
+  std::vector<MomentAccumulator> momentAccumulators;
+  /// one-pass quantile summaries for each response function with
+  /// probability or generalized reliability levels
+  std::vector<QuantileSketch> quantileSketches;
+  /// counts of finite samples within each response level bin for each
+  /// response function mapped to probabilities
+  Sizet2DArray levelBinCounts;
+  /// running co-moments of the sampled variables and response functions
+  /// over the samples with finite responses
+  CovarianceAccumulator corrAccumulator;
+
 private:
 
   //
   //- Heading: Convenience functions
   //
   
+  /// archive the labels of the sampled variables and the responses
+  /// with the statistics
+  void archive_statistics_labels();
+
+  /// compute_accumulated_statistics() counterpart to compute_moments()
+  void compute_accumulated_moments();
+  /// compute_accumulated_statistics() counterpart to
+  /// compute_level_mappings()
+  void compute_accumulated_level_mappings();
+
   /// helper function to consolidate update code
   void sample_to_variables(const Real* sample_vars, Variables& vars,
 			   Model& model);
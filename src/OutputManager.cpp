@@ -18,6 +18,7 @@
 #include <boost/regex.hpp>
 #include "dakota_global_defs.hpp"
 #include "OutputManager.hpp"
+#include "IndexedRestart.hpp"
 #include "ProgramOptions.hpp"
 #include "ProblemDescDB.hpp"
 #include "ParamResponsePair.hpp"
@@ -226,6 +227,9 @@ void OutputManager::close_streams()
 
   // any remaining restart files will be closed at the destructor...
   //restartDestinations.clear();
+  // ...but write any pending group commits now in case of abort
+  for (size_t i=0; i<restartDestinations.size(); ++i)
+    restartDestinations[i]->flush();
 
   // After completion of timings in ParallelLibrary... 
   //
@@ -317,7 +321,9 @@ push_output_tag(const String& iterator_tag, const ProgramOptions& prog_opts,
   read_write_restart(force_rst_redirect, read_restart_flag, 
 		     prog_opts.read_restart_file() + file_tag,
 		     prog_opts.stop_restart_evals(),
-		     prog_opts.write_restart_file() + file_tag);
+		     prog_opts.write_restart_file() + file_tag,
+		     prog_opts.restart_commit_batch(),
+		     prog_opts.restart_commit_window());
 }
 
 
@@ -410,9 +416,9 @@ void OutputManager::append_restart(const ParamResponsePair& prp)
     abort_handler(-1);
   }
   std::shared_ptr<RestartWriter> rst_writer = restartDestinations.back();
-  rst_writer->append_prp(prp);
-  // flush is critical so we have a complete restart record should Dakota abort
-  rst_writer->flush();
+  // flushes (or group commits) so we have a complete restart record
+  // should Dakota abort
+  rst_writer->commit_prp(prp);
 }
 
 
@@ -689,11 +695,50 @@ void OutputManager::archive_input(const ProgramOptions &prog_opts) const {
 }
 
 
+/** Indexed restart files are decoded record-by-record (concurrently
+    for large files), reading only the records up to stop_restart_evals. */
+static void read_indexed_restart(const String& read_restart_filename,
+				 size_t stop_restart_evals, PRPCache& read_pairs)
+{
+  try {
+    IndexedRestartReader rst_reader(read_restart_filename);
+    Cout << "Reading indexed restart file '" << read_restart_filename
+	 << "' containing: " << rst_reader.version();
+    if (stop_restart_evals)// cmd_line_handler rtns 0 if no setting
+      Cout << "Stopping restart file processing at "
+	   << stop_restart_evals << " evaluations." << std::endl;
+
+    size_t num_read = rst_reader.size();
+    if (stop_restart_evals && stop_restart_evals < num_read)
+      num_read = stop_restart_evals;
+    PRPArray prps;
+    rst_reader.read_prps(num_read, prps);
+    for (size_t i=0; i<num_read; ++i) {
+      read_pairs.insert(prps[i]);
+      Cout << "\n------------------------------------------\nRestart record "
+	   << std::setw(4) << i+1 << "  (evaluation id " << std::setw(4)
+	   << prps[i].eval_id() << "):"
+	   << "\n------------------------------------------\n" << prps[i];
+    }
+    Cout << "Restart file processing completed: " << num_read
+	 << " evaluations retrieved.\n";
+  }
+  catch (const boost::archive::archive_exception& e) {
+    Cerr << "\nError reading indexed restart file '" << read_restart_filename
+	 << "' (corrupt record).\nDetails (Boost archive exception): "
+	 << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+}
+
+
 void OutputManager::read_write_restart(bool restart_requested,
 				       bool read_restart_flag,
 				       const String& read_restart_filename,
 				       size_t stop_restart_evals,
-				       const String& write_restart_filename)
+				       const String& write_restart_filename,
+				       size_t commit_batch,
+				       size_t commit_window_ms)
 {
   // If no restart requested, push back a level that doesn't open
   // files so we can later pop it
@@ -715,7 +760,11 @@ void OutputManager::read_write_restart(bool restart_requested,
 
   // Conditionally process the evaluations from the restart file
   PRPCache read_pairs;
-  if (read_restart_flag) {
+  if (read_restart_flag &&
+      IndexedRestartReader::is_indexed(read_restart_filename))
+    read_indexed_restart(read_restart_filename, stop_restart_evals,
+			 read_pairs);
+  else if (read_restart_flag) {
     
     // catch errors with opening files and reading headers
     try {
@@ -835,7 +884,8 @@ void OutputManager::read_write_restart(bool restart_requested,
 
     // create a new restart destination
     std::shared_ptr<RestartWriter>
-      rst_writer(new RestartWriter(write_restart_filename));
+      rst_writer(new RestartWriter(write_restart_filename, true,
+				   commit_batch, commit_window_ms));
     restartDestinations.push_back(rst_writer);
 
     // Write any processed records from the old restart file to the new file.
@@ -1009,14 +1059,18 @@ void ConsoleRedirector::pop_back()
 }
 
 
-RestartWriter::RestartWriter()
+RestartWriter::RestartWriter():
+  commitBatch(1), commitWindow(0), stagedRecords(0), stopCommits(false)
 {  /* empty ctor */  }
 
 
 RestartWriter::RestartWriter(const String& write_restart_filename,
-			     bool write_version):
+			     bool write_version, size_t commit_batch,
+			     size_t commit_window_ms):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  commitBatch(commit_batch), commitWindow(commit_window_ms),
+  stagedRecords(0), stopCommits(false)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1024,20 +1078,31 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
     abort_handler(IO_ERROR);
   }
 
-  restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
+  // With group commit, the archive serializes into memory and whole
+  // records are moved to the file by the commit thread
+  if (commitBatch > 1)
+    restartOutputArchive.reset(new boost::archive::binary_oarchive(stagingBuffer));
+  else
+    restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
 
   if (write_version) {
     RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
 			       DakotaBuildInfo::get_rev_number());
     restartOutputArchive->operator&(rst_version);
   }
+
+  if (commitBatch > 1) {
+    write_staged_records(); // archive and version header
+    commitThread = std::thread(&RestartWriter::group_commit_loop, this);
+  }
 }
 
 
 RestartWriter::RestartWriter(const String& write_restart_filename,
 			     const RestartVersion& rst_version):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  commitBatch(1), commitWindow(0), stagedRecords(0), stopCommits(false)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1052,7 +1117,8 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
 
 
 RestartWriter::RestartWriter(std::ostream& write_restart_ostream):
-  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream))
+  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream)),
+  commitBatch(1), commitWindow(0), stagedRecords(0), stopCommits(false)
 {
   RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
 			     DakotaBuildInfo::get_rev_number());
@@ -1060,22 +1126,95 @@ RestartWriter::RestartWriter(std::ostream& write_restart_ostream):
 }
 
 
+RestartWriter::~RestartWriter()
+{
+  if (commitThread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(stagingMutex);
+      stopCommits = true;
+    }
+    commitCond.notify_one();
+    commitThread.join();
+  }
+  // remaining staged records and archive trailer (if any) are written
+  // before the file stream closes
+  restartOutputArchive.reset();
+  if (commitBatch > 1)
+    write_staged_records();
+}
+
+
 const String& RestartWriter::filename()
 { return restartOutputFilename; }
 
 
 void RestartWriter::append_prp(const ParamResponsePair& prp_in)
 { 
-  if (restartOutputArchive)  // equivalent to NULL check
+  if (restartOutputArchive) { // equivalent to NULL check
+    // the commit thread may concurrently drain the staging buffer
+    std::lock_guard<std::mutex> lock(stagingMutex);
     restartOutputArchive->operator&(prp_in);
+    ++stagedRecords;
+  }
   else {
     Cerr << "\nError: attempt to write to invalid restart file." << std::endl;
     abort_handler(IO_ERROR);
   }
 }
 
+
+void RestartWriter::commit_prp(const ParamResponsePair& prp_in)
+{
+  append_prp(prp_in);
+  if (commitBatch <= 1)
+    // flush is critical so we have a complete restart record should
+    // Dakota abort
+    restartOutputFS.flush();
+  else if (stagedRecords >= commitBatch)
+    commitCond.notify_one();
+}
+
+
 void RestartWriter::flush()
-{ restartOutputFS.flush(); }
+{
+  if (commitBatch > 1)
+    write_staged_records();
+  else
+    restartOutputFS.flush();
+}
+
+
+void RestartWriter::group_commit_loop()
+{
+  std::unique_lock<std::mutex> lock(stagingMutex);
+  while (!stopCommits) {
+    commitCond.wait_for(lock, commitWindow, [this]
+      { return stopCommits || stagedRecords >= commitBatch; });
+    if (stagedRecords) {
+      lock.unlock();
+      write_staged_records();
+      lock.lock();
+    }
+  }
+}
+
+
+void RestartWriter::write_staged_records()
+{
+  // fileMutex is taken first so that groups reach the file in the
+  // order they were staged
+  std::lock_guard<std::mutex> file_lock(fileMutex);
+  std::string records;
+  {
+    std::lock_guard<std::mutex> lock(stagingMutex);
+    records = stagingBuffer.str();
+    stagingBuffer.str(std::string());
+    stagedRecords = 0;
+  }
+  if (!records.empty())
+    restartOutputFS.write(records.data(), records.size());
+  restartOutputFS.flush();
+}
 
 
 #ifdef Want_Heartbeat /*{*/
@@ -22,7 +22,13 @@
 #include "dakota_tabular_io.hpp"
 #include "DakotaGraphics.hpp"
 #include "RestartVersion.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 
 namespace Dakota {
@@ -119,16 +125,27 @@ private:
 
 
 /** Component for writing restart files.  Creation and destruction of
-    archive and associated stream are managed here. */
+    archive and associated stream are managed here.
+
+    By default each record is flushed to the file as it is committed.
+    With group commit (commit_batch > 1), records are serialized into
+    an in-memory staging buffer and a background thread writes and
+    flushes them in groups, whenever commit_batch records are pending
+    or commit_window_ms has elapsed.  Only whole records are handed to
+    the file, so at most one durability window of evaluations is lost
+    on a hard crash and the file remains readable (up to any partial
+    trailing group, recoverable with -stop_restart). */
 class RestartWriter {
 
 public:
   /// optional default ctor allowing a non-outputting RestartWriter
   RestartWriter();
 
-  /// typical ctor taking a filename; this class encapsulates the output stream
+  /// typical ctor taking a filename; this class encapsulates the
+  /// output stream and optionally enables group commit
   RestartWriter(const String& write_restart_filename,
-		bool write_version = true);
+		bool write_version = true, size_t commit_batch = 1,
+		size_t commit_window_ms = 1000);
 
   /// alternate ctor taking non-default version info, helpful for testing
   RestartWriter(const String& write_restart_filename,
@@ -138,6 +155,9 @@ public:
   /// client manages the output stream
   RestartWriter(std::ostream& write_restart_stream);
   
+  /// destructor; writes any pending group commit
+  ~RestartWriter();
+
   /// output filename for this writer
   const String& filename();
 
@@ -149,8 +169,12 @@ public:
   /// add the passed pair to the restart file
   void append_prp(const ParamResponsePair& prp_in);
 
-  /// flush the restart stream so we have a complete restart record
-  /// should Dakota abort
+  /// commit the passed pair to the restart file: flush immediately,
+  /// or add it to the pending group when group commit is active
+  void commit_prp(const ParamResponsePair& prp_in);
+
+  /// flush the restart stream (including any pending group) so we
+  /// have a complete restart record should Dakota abort
   void flush();
 
 private:
@@ -159,6 +183,11 @@ private:
   /// assignment is disallowed due to file stream
   const RestartWriter& operator=(const RestartWriter&);
 
+  /// background thread loop writing groups of records to the file
+  void group_commit_loop();
+  /// move the staged records to the file stream and flush it
+  void write_staged_records();
+
   /// the name of the restart output file
   String restartOutputFilename;
 
@@ -169,6 +198,26 @@ private:
   /// default ctor for oarchive and may not be initialized); 
   std::unique_ptr<boost::archive::binary_oarchive> restartOutputArchive;
 
+  /// maximum number of records per group commit (<= 1: no grouping)
+  size_t commitBatch;
+  /// maximum time a committed record may remain pending
+  std::chrono::milliseconds commitWindow;
+
+  /// in-memory target of restartOutputArchive when group committing
+  std::ostringstream stagingBuffer;
+  /// number of records in stagingBuffer (read unlocked in commit_prp)
+  std::atomic<size_t> stagedRecords;
+  /// guards stagingBuffer and stopCommits
+  std::mutex stagingMutex;
+  /// serializes writes to restartOutputFS so groups stay in order
+  std::mutex fileMutex;
+  /// signals the commit thread that a group is full or to stop
+  std::condition_variable commitCond;
+  /// requests the commit thread to exit
+  bool stopCommits;
+  /// background thread performing group commits
+  std::thread commitThread;
+
 };  // class RestartWriter
 
 
@@ -380,7 +429,9 @@ private:
   void read_write_restart(bool restart_requested, bool read_restart_flag,
 			  const String& read_restart_filename,
 			  size_t stop_restart_eval,
-			  const String& write_restart_filename);
+			  const String& write_restart_filename,
+			  size_t commit_batch = 1,
+			  size_t commit_window_ms = 1000);
 
   // -----
   // Data
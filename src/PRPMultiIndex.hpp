@@ -19,12 +19,17 @@
 #include "dakota_data_types.hpp"
 #include "ParamResponsePair.hpp"
 
+#include <boost/functional/hash.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 
 #include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <unordered_map>
 
 namespace bmi = boost::multi_index;
 
@@ -344,6 +349,207 @@ lookup_by_nearby_val(PRPMultiIndexCache& prp_cache,
 }
 
 
+// ---------------------------------------------------
+// PRPGridIndex for tolerance-based PRPCache lookups
+// ---------------------------------------------------
+/// grid hash over the continuous variables of the PRPCache entries of
+/// one interface, bounding the candidates of tolerance-based lookups
+
+/** Each continuous variable v is quantized by sign and by the cell of
+    log|v| in a uniform grid, with cells wide relative to the band
+    |log|v1| - log|v2|| <= -log(1-tol) implied by nearby().  A lookup
+    hashes the cells the search point can match (a second cell only for
+    the rare coordinates within the band of a cell boundary) and tests
+    those buckets with nearby().  The index holds shallow copies of the
+    cache entries and is built on first use, so that the cost is only
+    incurred by interfaces using tolerance-based duplicate detection. */
+class PRPGridIndex
+{
+public:
+
+  /// default constructor
+  PRPGridIndex(): gridTol(0.), logBand(0.), cellWidth(1.), indexBuilt(false)
+  { }
+
+  /// true once build() has been called
+  bool built() const
+  { return indexBuilt; }
+
+  /// index the entries of prp_cache matching interface_id for lookups
+  /// within relative tolerance tol
+  void build(const PRPMultiIndexCache& prp_cache, const String& interface_id,
+	     Real tol)
+  {
+    gridTol = std::max(tol, 0.);
+    // pad for roundoff in log() and in the ratio formed by nearby()
+    logBand = -std::log1p(-std::min(gridTol, 0.5)) + 1.e-12;
+    cellWidth = 32. * logBand; // ~1/16 of coordinates straddle 2 cells
+    gridCells.clear(); nonFinitePairs.clear();
+    for (PRPCacheCIter it=prp_cache.begin(); it!=prp_cache.end(); ++it)
+      if (it->interface_id() == interface_id)
+	add(*it);
+    indexBuilt = true;
+  }
+
+  /// add a (shallow copy of a) PRPCache entry; no-op prior to build(),
+  /// which picks up the entries present at that time
+  void insert(const ParamResponsePair& prp)
+  { if (indexBuilt) add(prp); }
+
+  /// remove an entry previously added with insert()
+  void erase(const ParamResponsePair& prp)
+  {
+    size_t key;
+    if (!cell_key(prp.variables().all_continuous_variables(), key)) {
+      auto it = std::find_if(nonFinitePairs.begin(), nonFinitePairs.end(),
+	[&prp](const ParamResponsePair& p) { return same_entry(p, prp); });
+      if (it != nonFinitePairs.end()) nonFinitePairs.erase(it);
+      return;
+    }
+    auto range = gridCells.equal_range(key);
+    for (auto it=range.first; it!=range.second; ++it)
+      if (same_entry(it->second, prp))
+	{ gridCells.erase(it); return; }
+  }
+
+  /// find the PRPCache entry (lowest eval id among matches) within the
+  /// build() tolerance of search_vars and satisfying search_set; returns
+  /// prp_cache.end() if none.  Falls back to lookup_by_nearby_val() when
+  /// the tolerance is large, the search point is not finite, or more cells
+  /// would be probed than there are entries.
+  PRPCacheOIter lookup(PRPMultiIndexCache& prp_cache,
+		       const String& search_interface_id,
+		       const Variables& search_vars,
+		       const ActiveSet& search_set)
+  {
+    const RealVector& c_vars = search_vars.all_continuous_variables();
+    int i, num_cv = c_vars.length();
+    // candidate cells for each coordinate: one, or two near a cell boundary
+    std::vector<std::pair<long long, long long> > cells(num_cv);
+    size_t num_probes = 1;
+    bool scan = (gridTol >= 0.5);
+    for (i=0; i<num_cv && !scan; ++i) {
+      Real v = c_vars[i];
+      if (!std::isfinite(v))
+	scan = true;
+      else if (v == 0.) // only matched by zero/subnormal cached values
+	cells[i].first = cells[i].second = zeroCell;
+      else if (std::abs(v) <= DBL_MIN) // zero cell or normal values near v
+	scan = true;
+      else {
+	Real log_v = std::log(std::abs(v));
+	long long sgn = (v < 0.) ? 1 : 0;
+	cells[i].first = 2 * (long long)std::floor((log_v - logBand) /
+						   cellWidth) + sgn;
+	cells[i].second = 2 * (long long)std::floor((log_v + logBand) /
+						    cellWidth) + sgn;
+	if (cells[i].first != cells[i].second) num_probes *= 2;
+      }
+      if (num_probes > 1 && num_probes > gridCells.size()) scan = true;
+    }
+    if (scan)
+      return lookup_by_nearby_val(prp_cache, search_interface_id, search_vars,
+				  search_set, gridTol);
+
+    PRPCacheOIter found_it = prp_cache.end();
+    for (const ParamResponsePair& prp : nonFinitePairs)
+      test_candidate(prp_cache, prp, search_vars, search_set, found_it);
+    std::vector<long long> probe(num_cv);
+    for (size_t p=0; p<num_probes; ++p) {
+      size_t bits = p;
+      for (i=0; i<num_cv; ++i)
+	if (cells[i].first == cells[i].second)
+	  probe[i] = cells[i].first;
+	else {
+	  probe[i] = (bits & 1) ? cells[i].second : cells[i].first;
+	  bits >>= 1;
+	}
+      auto range = gridCells.equal_range(
+	boost::hash_range(probe.begin(), probe.end()));
+      for (auto it=range.first; it!=range.second; ++it)
+	test_candidate(prp_cache, it->second, search_vars, search_set,
+		       found_it);
+    }
+    return found_it;
+  }
+
+private:
+
+  /// hash and store a PRPCache entry
+  void add(const ParamResponsePair& prp)
+  {
+    size_t key;
+    if (cell_key(prp.variables().all_continuous_variables(), key))
+      gridCells.insert(std::make_pair(key, prp));
+    else
+      nonFinitePairs.push_back(prp);
+  }
+
+  /// hash of the grid cells of c_vars; false if a value is not finite
+  bool cell_key(const RealVector& c_vars, size_t& key) const
+  {
+    int i, num_cv = c_vars.length();
+    std::vector<long long> cell(num_cv);
+    for (i=0; i<num_cv; ++i) {
+      Real v = c_vars[i];
+      if (!std::isfinite(v))
+	return false;
+      else if (std::abs(v) < DBL_MIN) // treated as zero by nearby()
+	cell[i] = zeroCell;
+      else
+	cell[i] = 2 * (long long)std::floor(std::log(std::abs(v)) / cellWidth)
+	        + ((v < 0.) ? 1 : 0);
+    }
+    key = boost::hash_range(cell.begin(), cell.end());
+    return true;
+  }
+
+  /// true if p1 and p2 are copies of the same PRPCache entry
+  static bool same_entry(const ParamResponsePair& p1,
+			 const ParamResponsePair& p2)
+  { return p1.eval_interface_ids() == p2.eval_interface_ids() &&
+      p1.variables() == p2.variables(); }
+
+  /// if candidate matches the search data and is still present in
+  /// prp_cache with a lower eval id than found_it, update found_it
+  void test_candidate(PRPMultiIndexCache& prp_cache,
+		      const ParamResponsePair& candidate,
+		      const Variables& search_vars, const ActiveSet& search_set,
+		      PRPCacheOIter& found_it) const
+  {
+    if (!nearby(candidate.variables(), search_vars, gridTol) ||
+	!set_compare(candidate, search_set) ||
+	( found_it != prp_cache.end() &&
+	  found_it->eval_interface_ids() <= candidate.eval_interface_ids() ))
+      return;
+    // the cache may have been modified outside this index (e.g., erased)
+    std::pair<PRPCacheOIter, PRPCacheOIter> range
+      = prp_cache.get<ordered>().equal_range(candidate.eval_interface_ids());
+    for (PRPCacheOIter it=range.first; it!=range.second; ++it)
+      if (it->variables() == candidate.variables())
+	{ found_it = it; return; }
+  }
+
+  /// cell of values treated as zero by nearby() (|v| < DBL_MIN)
+  static const long long zeroCell = LLONG_MIN;
+
+  /// relative tolerance of lookups
+  Real gridTol;
+  /// bound on |log|v1| - log|v2|| for values matching within gridTol
+  Real logBand;
+  /// width of the grid cells in log|v|
+  Real cellWidth;
+  /// true once build() has populated the index
+  bool indexBuilt;
+
+  /// entries hashed by the grid cells of their continuous variables
+  std::unordered_multimap<size_t, ParamResponsePair> gridCells;
+  /// entries with non-finite continuous variables, which nearby() may
+  /// match to any search point; tested on every lookup
+  std::vector<ParamResponsePair> nonFinitePairs;
+};
+
+
 // ------------------------------------
 // lookup_by_ids for PRPMultiIndexCache
 // ------------------------------------
@@ -16,6 +16,7 @@
 #include "ProgramOptions.hpp"
 #include "dakota_results_types.hpp"
 #include "ResultsManager.hpp"
+#include "util_threads.hpp"
 
 #ifdef DAKOTA_UTILIB
 #include <utilib/exception_mngr.h>
@@ -89,6 +90,17 @@ void ParallelLibrary::init_mpi_comm()
     pl.procsPerServer   = pl.serverCommSize;
     // initialize MPI timer
     startMPITime        = MPI_Wtime();
+    // ranks placed on the same node share its hardware threads among
+    // their threaded loops (see dakota::util::thread_budget())
+    int node_ranks = pl.serverCommSize;
+#if MPI_VERSION >= 3
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(pl.serverIntraComm, MPI_COMM_TYPE_SHARED,
+			pl.serverCommRank, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_size(node_comm, &node_ranks);
+    MPI_Comm_free(&node_comm);
+#endif
+    dakota::util::set_thread_shares(node_ranks);
   }
   else // most default ParallelLevel values apply
     pl.serverId         = pl.numServers       = pl.procsPerServer = 1;
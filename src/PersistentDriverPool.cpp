@@ -0,0 +1,263 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        PersistentDriverPool
+//- Description:  Class implementation
+
+#include "PersistentDriverPool.hpp"
+#include "dakota_global_defs.hpp"
+#include "DataMethod.hpp" // output level enums
+#include "WorkdirHelper.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Dakota {
+
+PersistentDriverPool::
+PersistentDriverPool(const String& driver_command, short output_level):
+  driverArgs(WorkdirHelper::tokenize_driver(driver_command)),
+  outputLevel(output_level)
+{
+  if (driverArgs.empty()) {
+    Cerr << "Error: persistent_driver requires a non-empty analysis_driver."
+	 << std::endl;
+    abort_handler(-1);
+  }
+}
+
+
+/** Closing a worker's connection signals it to exit.  A worker that
+    is still busy (e.g., when Dakota terminates early) is also sent
+    SIGTERM, since its evaluation will never be collected. */
+PersistentDriverPool::~PersistentDriverPool()
+{
+  for (size_t i=0; i<workers.size(); ++i) {
+    close(workers[i].sockFd);
+    if (workers[i].busy)
+      kill(workers[i].pid, SIGTERM);
+  }
+  for (size_t i=0; i<workers.size(); ++i) {
+    int status;
+    while (waitpid(workers[i].pid, &status, 0) == -1 && errno == EINTR)
+      { }
+    if (outputLevel >= DEBUG_OUTPUT)
+      Cout << "Persistent analysis driver process " << workers[i].pid
+	   << " terminated." << std::endl;
+  }
+}
+
+
+pid_t PersistentDriverPool::
+submit(const String& work_dir, const String& params_file,
+       const String& results_file)
+{
+  size_t i, num_workers = workers.size();
+  for (i=0; i<num_workers; ++i)
+    if (!workers[i].busy)
+      break;
+  if (i == num_workers)
+    i = launch();
+
+  Worker& worker = workers[i];
+  String msg(work_dir);
+  msg += '\n'; msg += params_file; msg += '\n'; msg += results_file;
+  msg += '\n';
+  send_all(worker, msg);
+  worker.busy = true;
+  return worker.pid;
+}
+
+
+void PersistentDriverPool::wait(pid_t pid)
+{
+  size_t i, num_workers = workers.size();
+  for (i=0; i<num_workers; ++i)
+    if (workers[i].pid == pid)
+      break;
+  if (i == num_workers || !workers[i].busy) {
+    Cerr << "Error: no outstanding request for persistent analysis driver "
+	 << "process " << pid << '.' << std::endl;
+    abort_handler(-1);
+  }
+  // the connection is blocking, so receive() waits for data to arrive
+  while (!receive(workers[i]))
+    { }
+}
+
+
+pid_t PersistentDriverPool::wait_any(bool block_flag)
+{
+  std::vector<struct pollfd> poll_fds;
+  std::vector<size_t> poll_workers;
+  size_t i, num_workers = workers.size();
+  for (i=0; i<num_workers; ++i)
+    if (workers[i].busy) {
+      struct pollfd pfd;
+      pfd.fd = workers[i].sockFd; pfd.events = POLLIN; pfd.revents = 0;
+      poll_fds.push_back(pfd);
+      poll_workers.push_back(i);
+    }
+  if (poll_fds.empty())
+    return 0;
+
+  while (true) {
+    int rc = poll(&poll_fds[0], poll_fds.size(), (block_flag) ? -1 : 0);
+    if (rc == -1) {
+      if (errno == EINTR)
+	continue;
+      Cerr << "Error: poll on persistent analysis driver connections failed ("
+	   << std::strerror(errno) << ")." << std::endl;
+      abort_handler(-1);
+    }
+    if (rc == 0) // no replies within a nonblocking test
+      return 0;
+    for (i=0; i<poll_fds.size(); ++i)
+      if (poll_fds[i].revents && receive(workers[poll_workers[i]]))
+	return workers[poll_workers[i]].pid;
+    // only partial replies were available
+    if (!block_flag)
+      return 0;
+  }
+}
+
+
+/** Between fork() and execvp(), the child only closes the parent end
+    of its socket pair; argument and environment setup are performed
+    beforehand in the parent. */
+size_t PersistentDriverPool::launch()
+{
+  int sv[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == -1) {
+    Cerr << "Error: could not create connection for persistent analysis "
+	 << "driver (" << std::strerror(errno) << ")." << std::endl;
+    abort_handler(-1);
+  }
+  // keep Dakota's end out of this and any later child process
+  fcntl(sv[0], F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+  int on = 1;
+  setsockopt(sv[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+  std::vector<const char*> av(driverArgs.size() + 1, NULL);
+  for (size_t i=0; i<driverArgs.size(); ++i)
+    av[i] = driverArgs[i].c_str();
+
+  // workers start in the startup directory with the same PATH as other
+  // analysis drivers; each request carries its working directory
+  WorkdirHelper::set_preferred_path();
+  WorkdirHelper::set_environment("DAKOTA_PERSISTENT_DRIVER_FD",
+				 std::to_string(sv[1]));
+  Cout << std::flush;
+
+  pid_t pid = 0;
+#ifdef HAVE_WORKING_FORK
+  pid = fork();
+#else
+  Cerr << "Error: fork not supported under this OS." << std::endl;
+  abort_handler(-1);
+#endif
+  if (pid == -1) {
+    Cerr << "\nCould not fork; error code " << errno << " ("
+	 << std::strerror(errno) << ")" << std::endl;
+    abort_handler(-1);
+  }
+
+  if (pid == 0) { // child: replace process with the persistent driver
+    close(sv[0]);
+    execvp(av[0], (char*const*)&av[0]);
+    // if execvp returns then it failed; Dakota sees the closed connection
+    _exit(-1);
+  }
+
+  close(sv[1]);
+  unsetenv("DAKOTA_PERSISTENT_DRIVER_FD");
+
+  if (outputLevel >= VERBOSE_OUTPUT)
+    Cout << "Launched persistent analysis driver process " << pid << " ("
+	 << workers.size() + 1 << " total)." << std::endl;
+
+  Worker worker = { pid, sv[0], false, String() };
+  workers.push_back(worker);
+  return workers.size() - 1;
+}
+
+
+bool PersistentDriverPool::receive(Worker& worker)
+{
+  char buf[256];
+  ssize_t num_read;
+  while ((num_read = read(worker.sockFd, buf, sizeof(buf))) == -1 &&
+	 errno == EINTR)
+    { }
+  if (num_read <= 0) {
+    Cerr << "Error: persistent analysis driver process " << worker.pid;
+    if (num_read == 0)
+      Cerr << " exited or closed its connection";
+    else
+      Cerr << " connection failed (" << std::strerror(errno) << ")";
+    Cerr << " before replying." << std::endl;
+    abort_handler(-1);
+  }
+  worker.recvBuf.append(buf, num_read);
+
+  size_t pos = worker.recvBuf.find('\n');
+  if (pos == String::npos)
+    return false;
+  String line(worker.recvBuf, 0, pos);
+  worker.recvBuf.erase(0, pos + 1);
+
+  char* end;
+  long status = std::strtol(line.c_str(), &end, 10);
+  if (end == line.c_str()) {
+    Cerr << "Error: invalid status \"" << line << "\" returned by persistent "
+	 << "analysis driver process " << worker.pid << '.' << std::endl;
+    abort_handler(-1);
+  }
+  // as for a forked driver, only a status of -1 is fatal; other failures
+  // are communicated through the results file
+  if (status == -1) {
+    Cerr << "Persistent analysis driver failure, aborting." << std::endl;
+    abort_handler(-1);
+  }
+  worker.busy = false;
+  return true;
+}
+
+
+void PersistentDriverPool::send_all(const Worker& worker, const String& msg)
+{
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL; // report a closed connection as EPIPE, not SIGPIPE
+#endif
+  const char* data = msg.data();
+  size_t remaining = msg.size();
+  while (remaining) {
+    ssize_t num_sent = send(worker.sockFd, data, remaining, flags);
+    if (num_sent == -1) {
+      if (errno == EINTR)
+	continue;
+      Cerr << "Error: could not send request to persistent analysis driver "
+	   << "process " << worker.pid << " (" << std::strerror(errno) << ")."
+	   << std::endl;
+      abort_handler(-1);
+    }
+    data += num_sent; remaining -= num_sent;
+  }
+}
+
+} // namespace Dakota
@@ -0,0 +1,112 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        PersistentDriverPool
+//- Description:  Pool of long-lived analysis driver processes that serve
+//-               evaluation requests over local sockets
+
+#ifndef PERSISTENT_DRIVER_POOL_H
+#define PERSISTENT_DRIVER_POOL_H
+
+#include "dakota_data_types.hpp"
+#include <sys/types.h>
+
+
+namespace Dakota {
+
+/// Pool of persistent analysis driver processes used by the fork
+/// interface when persistent_driver is specified.
+
+/** Each worker is launched once with fork()/execvp() using the
+    analysis driver command (without parameters/results file
+    arguments) and is connected to Dakota through one end of a local
+    socket pair, whose descriptor is published in the worker's
+    DAKOTA_PERSISTENT_DRIVER_FD environment variable.  A request
+    consists of three newline-terminated lines: the absolute working
+    directory, parameters file, and results file of the evaluation.
+    The worker writes the results file in the usual format and then
+    replies with a single line containing an integer status, where -1
+    aborts Dakota as for a forked driver exiting with -1.  A worker
+    exits when it reads end of file on its descriptor.  Workers are
+    launched on demand, so the pool grows to the evaluation
+    concurrency used by the scheduler. */
+
+class PersistentDriverPool
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor
+  PersistentDriverPool(const String& driver_command, short output_level);
+  /// destructor: closes the worker connections and reaps the workers
+  ~PersistentDriverPool();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// send an evaluation request to an idle worker, launching a new
+  /// worker if none is idle, and return the worker process id
+  pid_t submit(const String& work_dir, const String& params_file,
+	       const String& results_file);
+
+  /// block until the worker with process id pid replies
+  void wait(pid_t pid);
+  /// return the process id of a busy worker that has replied, blocking
+  /// for at least one reply if block_flag is true; returns 0 if no
+  /// reply is available and block_flag is false
+  pid_t wait_any(bool block_flag);
+
+  /// number of workers launched so far
+  size_t size() const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// state of a single persistent worker
+  struct Worker {
+    pid_t  pid;       ///< worker process id
+    int    sockFd;    ///< Dakota end of the worker's socket pair
+    bool   busy;      ///< whether a request is outstanding
+    String recvBuf;   ///< partial reply received from the worker
+  };
+
+  /// fork/exec a new worker and return its index in workers
+  size_t launch();
+  /// read available reply data from a busy worker; returns true and
+  /// marks the worker idle once a complete status line has arrived
+  bool receive(Worker& worker);
+  /// write the full message to a worker, aborting on failure
+  void send_all(const Worker& worker, const String& msg);
+
+  //
+  //- Heading: Data
+  //
+
+  /// driver command tokenized for execvp
+  StringArray driverArgs;
+  /// output verbosity of the owning interface
+  short outputLevel;
+  /// the launched workers
+  std::vector<Worker> workers;
+};
+
+
+inline size_t PersistentDriverPool::size() const
+{ return workers.size(); }
+
+} // namespace Dakota
+
+#endif
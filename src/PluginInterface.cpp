@@ -11,8 +11,11 @@
 #include "ProblemDescDB.hpp"
 
 #include <boost/dll/import.hpp>
+#include <boost/dll/shared_library.hpp>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+
 // Boost 1.76 and newer avoid the C++20 import keyword
 // RATIONALE: Using preprocessor as isolated to this compilation unit
 #if BOOST_VERSION >= 107600
@@ -43,9 +46,21 @@ void copy_hessian(std::vector<std::vector<double>> const& source,
   }
 }
 
+/// size buffer to num_rows x num_cols and point the matrix view at it
+template <typename T, typename U>
+void view_batch_matrix(std::vector<U>& buffer, size_t num_rows,
+  size_t num_cols, DakotaPlugins::StridedMatrix<T>& matrix) {
+  buffer.resize(num_rows * num_cols);
+  matrix.data = buffer.data();
+  matrix.numRows = num_rows;
+  matrix.numCols = num_cols;
+  matrix.rowStride = num_cols;
+}
+
 PluginInterface::PluginInterface(const ProblemDescDB& problem_db):
   ApplicationInterface(problem_db),
   pluginPath(problem_db.get_string("interface.plugin_library_path")),
+  batchPlugin(nullptr), threadSafePlugin(false),
   analysisDrivers(
     problem_db.get_sa("interface.application.analysis_drivers"))
 {
@@ -76,21 +91,37 @@ void PluginInterface::derived_map(const Variables& vars, const ActiveSet& set,
 
 void PluginInterface::derived_map_asynch(const ParamResponsePair& pair)
 {
-  // This interface only supports bulk synchronous batch evals for now
-  // TODO: Catch this at construct time
-  if (!batchEval) {
-    Cerr << "\nError: Plugin interfaces support single or batch evaluations, "
-	 << "but not\nasynchronous.\n";
-    abort_handler(INTERFACE_ERROR);
-  }
+  // no-op: batch and asynchronous (threaded) jobs are both launched
+  // from wait_local_evaluations()
 }
 
 
+/** Asynchronous (non-batch) plugin evaluations are dispatched onto
+    asynch evaluation_concurrency threads when the plugin declares its
+    single evaluate() thread safe, and are evaluated in turn otherwise
+    (e.g., Python plugins, which would contend for the GIL). */
 void PluginInterface::wait_local_evaluations(PRPQueue& prp_queue)
 {
-  // loading at first map to head off conflicting Python issues
+  // loading at first map to head off conflicting Python issues; this
+  // must also precede any concurrent derived_map() invocations
   load_plugin();
 
+  if (!batchEval) {
+    thread_local_evaluations(prp_queue, (threadSafePlugin) ? SZ_MAX : 1);
+    return;
+  }
+
+  if (prp_queue.empty())
+    return;
+
+  // one columnar batch request, shared labels and contiguous matrices,
+  // when the plugin exports the optional batch API
+  if (batchPlugin && form_batch_request(prp_queue)) {
+    batchPlugin->evaluate_batch(batchRequest, batchResponse);
+    populate_batch_responses(prp_queue);
+    return;
+  }
+
   // prepare requests
   std::vector<DakotaPlugins::EvalRequest> plugin_requests;
   plugin_requests.reserve(prp_queue.size());
@@ -114,6 +145,10 @@ void PluginInterface::wait_local_evaluations(PRPQueue& prp_queue)
 }
 
 
+void PluginInterface::test_local_evaluations(PRPQueue& prp_queue)
+{ wait_local_evaluations(prp_queue); }
+
+
 /** Load plugin if not already active */
 void PluginInterface::load_plugin()
 {
@@ -126,6 +161,16 @@ void PluginInterface::load_plugin()
 	 //boost::dll::load_mode::append_decorations
 	 //     boost::dll::load_mode::rtld_now
 	 );
+    // the columnar batch API is optional and exported by its own factory,
+    // leaving the layout of DakotaInterfaceAPI unchanged
+    pluginLibrary.load(pluginPath);
+    if (pluginLibrary.has("dakota_interface_batch_plugin"))
+      batchPlugin = pluginLibrary.get<DakotaPlugins::DakotaInterfaceBatchAPI*()>
+	("dakota_interface_batch_plugin")();
+    // likewise, concurrent evaluate() calls require an explicit opt-in
+    if (pluginLibrary.has("dakota_interface_thread_safe"))
+      threadSafePlugin = pluginLibrary.get<bool()>
+	("dakota_interface_thread_safe")();
   }
   catch (const boost::system::system_error& e) {
     Cerr << "\nError: Could not load symbol dakota_interface_plugin from "
@@ -134,8 +179,17 @@ void PluginInterface::load_plugin()
 	 << e.what() << std::endl;
     abort_handler(INTERFACE_ERROR);
   }
-  if (outputLevel >= VERBOSE_OUTPUT)
+  if (outputLevel >= VERBOSE_OUTPUT) {
     Cout << "Loading plugin interface from '" << pluginPath << "'" << std::endl;
+    if (batchEval)
+      Cout << "Plugin batch evaluations use the "
+	   << ((batchPlugin) ? "columnar batch API" : "per-request API")
+	   << std::endl;
+    else if (asynchLocalEvalConcurrency != 1)
+      Cout << "Plugin asynchronous evaluations are "
+	   << ((threadSafePlugin) ? "threaded" : "serialized (plugin is not "
+	       "declared thread safe)") << std::endl;
+  }
   pluginInterface->set_analysis_drivers(analysisDrivers);
   pluginInterface->initialize();
 }
@@ -193,6 +247,125 @@ void PluginInterface::populate_response
 }
 
 
+/** The queued evaluations are gathered into contiguous row-per-evaluation
+    buffers that persist across batches; labels are formed once per
+    variables configuration. */
+bool PluginInterface::form_batch_request(const PRPQueue& prp_queue)
+{
+  if (prp_queue.empty())
+    return false;
+
+  const ParamResponsePair& first_prp = *prp_queue.begin();
+  const Variables& first_vars = first_prp.variables();
+  const SizetArray& dvv = first_prp.active_set().derivative_vector();
+  size_t num_evals = prp_queue.size(), num_cv = first_vars.acv(),
+    num_div = first_vars.adiv(), num_dsv = first_vars.adsv(),
+    num_drv = first_vars.adrv(), num_derivs = dvv.size(),
+    num_fns = first_prp.active_set().request_vector().size();
+  short asv_union = 0;
+  for (const auto& prp : prp_queue) {
+    const ActiveSet& set = prp.active_set();
+    if (set.derivative_vector() != dvv ||
+	set.request_vector().size() != num_fns)
+      return false;
+    for (short a : set.request_vector())
+      asv_union |= a;
+  }
+
+  if (first_vars.variables_id() != batchVarsId) {
+    copy_data(first_vars.all_continuous_variable_labels(),
+	      batchLabels.continuousLabels);
+    copy_data(first_vars.all_discrete_int_variable_labels(),
+	      batchLabels.discreteIntLabels);
+    copy_data(first_vars.all_discrete_string_variable_labels(),
+	      batchLabels.discreteStringLabels);
+    copy_data(first_vars.all_discrete_real_variable_labels(),
+	      batchLabels.discreteRealLabels);
+    batchLabels.inputOrderedLabels = first_vars.ordered_labels();
+    batchVarsId = first_vars.variables_id();
+  }
+  batchRequest.labels = &batchLabels;
+  batchRequest.derivativeVars = dvv;
+
+  view_batch_matrix(batchCV,  num_evals, num_cv,  batchRequest.continuousVars);
+  view_batch_matrix(batchDIV, num_evals, num_div, batchRequest.discreteIntVars);
+  view_batch_matrix(batchDSV, num_evals, num_dsv,
+		    batchRequest.discreteStringVars);
+  view_batch_matrix(batchDRV, num_evals, num_drv, batchRequest.discreteRealVars);
+  view_batch_matrix(batchASV, num_evals, num_fns, batchRequest.activeSet);
+  batchEvalIds.resize(num_evals);
+  batchRequest.functionEvalIds = batchEvalIds.data();
+
+  size_t e = 0, i;
+  for (const auto& prp : prp_queue) {
+    const Variables& vars = prp.variables();
+    const RealVector& acv  = vars.all_continuous_variables();
+    const IntVector&  adiv = vars.all_discrete_int_variables();
+    const RealVector& adrv = vars.all_discrete_real_variables();
+    StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+    const ShortArray& asv = prp.active_set().request_vector();
+    Real*   cv  = &batchCV[e * num_cv];
+    int*    div = &batchDIV[e * num_div];
+    String* dsv = &batchDSV[e * num_dsv];
+    Real*   drv = &batchDRV[e * num_drv];
+    for (i=0; i<num_cv; ++i)  cv[i]  = acv[i];
+    for (i=0; i<num_div; ++i) div[i] = adiv[i];
+    for (i=0; i<num_dsv; ++i) dsv[i] = adsv[i];
+    for (i=0; i<num_drv; ++i) drv[i] = adrv[i];
+    std::copy(asv.begin(), asv.end(), batchASV.begin() + e * num_fns);
+    batchEvalIds[e] = prp.eval_id();
+    ++e;
+  }
+
+  // outputs are only allocated when requested by some evaluation
+  view_batch_matrix(batchFns, num_evals, (asv_union & 1) ? num_fns : 0,
+		    batchResponse.functions);
+  view_batch_matrix(batchGrads, num_evals,
+		    (asv_union & 2) ? num_fns * num_derivs : 0,
+		    batchResponse.gradients);
+  view_batch_matrix(batchHessians, num_evals,
+		    (asv_union & 4) ? num_fns * num_derivs * num_derivs : 0,
+		    batchResponse.hessians);
+  return true;
+}
+
+
+void PluginInterface::populate_batch_responses(PRPQueue& prp_queue)
+{
+  const size_t num_derivs = batchRequest.derivativeVars.size();
+  size_t e = 0, i, j, k;
+  for (auto& prp : prp_queue) {
+    // non-const envelope sharing the representation, as for the
+    // per-request batch above
+    Response resp = prp.response();
+    auto const& asv = resp.active_set_request_vector();
+    auto resp_fns = resp.function_values_view();
+    auto resp_gradients = resp.function_gradients_view();
+    auto resp_hessians = resp.function_hessians_view();
+
+    size_t const num_fns = resp.num_functions();
+    for (i=0; i<num_fns; ++i) {
+      if (asv[i] & 1)
+	resp_fns[i] = batchResponse.functions(e, i);
+      if (asv[i] & 2) {
+	const Real* grad = batchResponse.gradients.row(e) + i * num_derivs;
+	for (j=0; j<num_derivs; ++j)
+	  resp_gradients(j, i) = grad[j];
+      }
+      if (asv[i] & 4) {
+	const Real* hess
+	  = batchResponse.hessians.row(e) + i * num_derivs * num_derivs;
+	for (j=0; j<num_derivs; ++j)
+	  for (k=0; k<=j; ++k)
+	    resp_hessians[i](j, k) = hess[j * num_derivs + k];
+      }
+    }
+    completionSet.insert(prp.eval_id());
+    ++e;
+  }
+}
+
+
 void PluginInterface::check_plugin_exists()
 {
   // This only accounts for user-provided path case
@@ -13,6 +13,7 @@
 #include "ApplicationInterface.hpp"
 #include "plugins/DakotaInterfaceAPI.hpp"
 
+#include <boost/dll/shared_library.hpp>
 #include <boost/shared_ptr.hpp> // blech
 
 
@@ -30,12 +31,17 @@ public:
   void derived_map(const Variables& vars, const ActiveSet& set,
 		   Response& response, int fn_eval_id);
 
+  /// asynchronous jobs are deferred to wait_local_evaluations()
   void derived_map_asynch(const ParamResponsePair& pair);
 
   /// For plugins, implements blocking bulk-synchronous evaluation of
-  /// batch (PRPQueue)
+  /// batch (PRPQueue), or evaluation of the queued jobs on local
+  /// threads (when the plugin is thread safe) for asynchronous interfaces
   void wait_local_evaluations(PRPQueue& prp_queue);
 
+  /// Threaded evaluations complete as a unit, so this blocks
+  void test_local_evaluations(PRPQueue& prp_queue);
+
 
 protected:
 
@@ -50,17 +56,55 @@ protected:
   void populate_response
   (const DakotaPlugins::EvalResponse& plugin_response, Response& response) const;
 
+  /// gather the queued evaluations into the columnar batch request;
+  /// false if there are none or they cannot share one (differing
+  /// derivative variables)
+  bool form_batch_request(const PRPQueue& prp_queue);
+
+  /// scatter the columnar batch response to the queued Responses
+  void populate_batch_responses(PRPQueue& prp_queue);
+
   /// path to the plugin to load, e.g., /path/to/libuser_plugin.so
   String pluginPath;
 
   /// the interface class loaded via plugin
   boost::shared_ptr<DakotaPlugins::DakotaInterfaceAPI> pluginInterface;
+  /// the plugin library, held open for batchPlugin
+  boost::dll::shared_library pluginLibrary;
+  /// optional columnar batch evaluator exported by the plugin (via
+  /// dakota_interface_batch_plugin); null if not provided
+  DakotaPlugins::DakotaInterfaceBatchAPI* batchPlugin;
+  /// whether the plugin's evaluate() may be called concurrently (via
+  /// dakota_interface_thread_safe); false if not declared
+  bool threadSafePlugin;
 
 
   /// list of drivers to perform core simulation mappings (can
   /// potentially be executed concurrently via MPI)
   StringArray analysisDrivers;
 
+  /// columnar batch request, viewing the batch buffers below
+  DakotaPlugins::EvalBatchRequest batchRequest;
+  /// columnar batch response, viewing the batch buffers below
+  DakotaPlugins::EvalBatchResponse batchResponse;
+  /// variable labels shared by the batch requests
+  DakotaPlugins::EvalLabels batchLabels;
+  /// variables id for which batchLabels were formed
+  String batchVarsId;
+
+  /// batch continuous / discrete real variables, one row per evaluation
+  RealArray batchCV, batchDRV;
+  /// batch discrete integer variables, one row per evaluation
+  IntArray batchDIV;
+  /// batch discrete string variables, one row per evaluation
+  StringArray batchDSV;
+  /// batch active set vectors, one row per evaluation
+  ShortArray batchASV;
+  /// evaluation ids of the batch
+  IntArray batchEvalIds;
+  /// batch function values, gradients, and Hessians, one row per evaluation
+  RealArray batchFns, batchGrads, batchHessians;
+
 private:
 
   /// validate that the plugin exists on the filesystem
@@ -2317,6 +2317,7 @@ int ProblemDescDB::get_int(const String& entry_name) const
       {"asynch_local_analysis_concurrency", P_INT asynchLocalAnalysisConcurrency},
       {"asynch_local_evaluation_concurrency", P_INT asynchLocalEvalConcurrency},
       {"direct.processors_per_analysis", P_INT procsPerAnalysis},
+      {"evaluation_prefetch", P_INT evalPrefetch},
       {"evaluation_servers", P_INT evalServers},
       {"failure_capture.retry_limit", P_INT retryLimit},
       {"processors_per_evaluation", P_INT procsPerEval}
@@ -2540,6 +2541,7 @@ size_t ProblemDescDB::get_sizet(const String& entry_name) const
       {"nond.expansion_samples", P_MET expansionSamples},
       {"nond.max_refinement_iterations", P_MET maxRefineIterations},
       {"nond.max_solver_iterations", P_MET maxSolverIterations},
+      {"nond.streaming_chunk_size", P_MET streamingChunkSize},
       {"num_candidate_designs", P_MET numCandidateDesigns},
       {"num_candidates", P_MET numCandidates},
       {"num_prediction_configs", P_MET numPredConfigs}
@@ -2690,6 +2692,7 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"scaling", P_MET methodScaling},
       {"speculative", P_MET speculativeFlag},
       {"std_regression_coeffs", P_MET stdRegressionCoeffs},
+      {"streaming_statistics", P_MET streamingStatsFlag},
       {"tolerance_intervals", P_MET toleranceIntervalsFlag},
       {"variance_based_decomp", P_MET vbdFlag},
       {"wilks", P_MET wilksFlag}
@@ -2730,6 +2733,7 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"application.aprepro", P_INT apreproFlag},
       {"application.file_save", P_INT fileSaveFlag},
       {"application.file_tag", P_INT fileTagFlag},
+      {"application.persistent_driver", P_INT persistentDriverFlag},
       {"application.verbatim", P_INT verbatimFlag},
       {"asynch", P_INT asynchFlag},
       {"batch", P_INT batchEvalFlag},
@@ -2737,6 +2741,7 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"dirTag", P_INT dirTag},
       {"evaluation_cache", P_INT evalCacheFlag},
       {"nearby_evaluation_cache", P_INT nearbyEvalCacheFlag},
+      {"python.columnar_batch", P_INT columnarBatchFlag},
       {"python.numpy", P_INT numpyFlag},
       {"restart_file", P_INT restartFileFlag},
       {"templateReplace", P_INT templateReplace},
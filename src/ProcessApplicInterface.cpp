@@ -206,7 +206,11 @@ ProcessApplicInterface(const ProblemDescDB& problem_db):
 
 
 ProcessApplicInterface::~ProcessApplicInterface() 
-{  /* empty dtor */  }
+{
+  // complete any background work_directory removals
+  if (useWorkdir && !dirSave)
+    WorkdirHelper::wait_async_removals();
+}
 
 
 // -------------------------------------------------------
@@ -1042,7 +1046,8 @@ file_and_workdir_cleanup(const bfs::path &params_path,
   if (removing_workdir) {
     if (outputLevel > NORMAL_OUTPUT)
       Cout << "Removing work_directory " << workdir_path << std::endl;
-    WorkdirHelper::recursive_remove(workdir_path, FILEOP_ERROR);
+    // removal of large directories proceeds in the background
+    WorkdirHelper::recursive_remove_async(workdir_path, FILEOP_ERROR);
   }
 
 }
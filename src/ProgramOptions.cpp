@@ -15,6 +15,7 @@
 #include "ProgramOptions.hpp"
 #include "CommandLineHandler.hpp"
 #include "ProblemDescDB.hpp"
+#include <algorithm>
 
 namespace Dakota {
 
@@ -32,6 +33,7 @@ namespace Dakota {
 ProgramOptions::ProgramOptions():
   worldRank(0),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartCommitBatch(1), restartCommitWindow(1000),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -44,6 +46,7 @@ ProgramOptions::ProgramOptions():
 ProgramOptions::ProgramOptions(int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartCommitBatch(1), restartCommitWindow(1000),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -56,6 +59,7 @@ ProgramOptions::ProgramOptions(int world_rank):
 ProgramOptions::ProgramOptions(int argc, char* argv[], int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartCommitBatch(1), restartCommitWindow(1000),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -101,6 +105,11 @@ ProgramOptions::ProgramOptions(int argc, char* argv[], int world_rank):
   if (clh.retrieve("write_restart"))
     writeRestartFile = clh.retrieve("write_restart");
   stopRestartEvals = clh.read_restart_evals();
+  if (clh.retrieve("restart_batch"))
+    restartCommitBatch = std::max(1, std::atoi(clh.retrieve("restart_batch")));
+  if (clh.retrieve("restart_window"))
+    restartCommitWindow =
+      std::max(1, std::atoi(clh.retrieve("restart_window")));
 
   manage_run_modes(clh);
 
@@ -153,6 +162,12 @@ size_t ProgramOptions::stop_restart_evals() const
 String ProgramOptions::write_restart_file() const
 { return writeRestartFile.empty() ? "dakota.rst" : writeRestartFile; }
 
+size_t ProgramOptions::restart_commit_batch() const
+{ return restartCommitBatch; }
+
+size_t ProgramOptions::restart_commit_window() const
+{ return restartCommitWindow; }
+
 
 bool ProgramOptions::help() const
 { return helpFlag; }
@@ -285,6 +300,12 @@ void ProgramOptions::stop_restart_evals(size_t stop_rst)
 void ProgramOptions::write_restart_file(const String& write_rst)
 { writeRestartFile = write_rst; }
 
+void ProgramOptions::restart_commit_batch(size_t commit_batch)
+{ restartCommitBatch = commit_batch; }
+
+void ProgramOptions::restart_commit_window(size_t commit_window_ms)
+{ restartCommitWindow = commit_window_ms; }
+
 
 void ProgramOptions::help(bool help_flag)
 { helpFlag = help_flag; }
@@ -400,7 +421,8 @@ void ProgramOptions::read(MPIUnpackBuffer& s)
   // core files and options
   s >> inputFile >> inputString >> echoInput >> parserOptions 
     >> outputFile >> errorFile 
-    >> readRestartFile >> stopRestartEvals >> writeRestartFile;
+    >> readRestartFile >> stopRestartEvals >> writeRestartFile
+    >> restartCommitBatch >> restartCommitWindow;
   // run mode controls
   s >> helpFlag >> versionFlag >> checkFlag >> preRunFlag >> runFlag 
     >> postRunFlag >> userModesFlag;
@@ -417,7 +439,8 @@ void ProgramOptions::write(MPIPackBuffer& s) const
   // core files and options
   s << inputFile << inputString << echoInput << parserOptions 
     << outputFile << errorFile 
-    << readRestartFile << stopRestartEvals << writeRestartFile;
+    << readRestartFile << stopRestartEvals << writeRestartFile
+    << restartCommitBatch << restartCommitWindow;
   // run mode controls
   s << helpFlag << versionFlag << checkFlag << preRunFlag << runFlag 
     << postRunFlag << userModesFlag;
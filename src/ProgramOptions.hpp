@@ -84,6 +84,10 @@ public:
   size_t stop_restart_evals() const;
   /// write retart (user-provided or default) file base name (no tag)
   String write_restart_file() const;
+  /// maximum number of restart records per group commit (1 = flush each)
+  size_t restart_commit_batch() const;
+  /// maximum milliseconds a grouped restart record may remain pending
+  size_t restart_commit_window() const;
 
   /// is help mode active?
   bool help() const;
@@ -161,6 +165,10 @@ public:
   void stop_restart_evals(size_t stop_rst);
   /// set base file name for restart file to write
   void write_restart_file(const String& write_rst);
+  /// set maximum number of restart records per group commit
+  void restart_commit_batch(size_t commit_batch);
+  /// set maximum milliseconds a grouped restart record may remain pending
+  void restart_commit_window(size_t commit_window_ms);
 
   /// set true to print help information and exit
   void help(bool help_flag);
@@ -246,6 +254,8 @@ private:
   String readRestartFile;    ///< e.g., "dakota.old.rst"
   size_t stopRestartEvals;   ///< eval number at which to stop restart read
   String writeRestartFile;   ///< e.g., "dakota.new.rst"
+  size_t restartCommitBatch;  ///< max restart records per group commit
+  size_t restartCommitWindow; ///< max milliseconds before a group commit
 
   // Run mode flags; intially only valid on rank 0.
   // Could condense flags into a bit-wise short, but using bool for
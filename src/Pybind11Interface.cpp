@@ -26,6 +26,7 @@ namespace Dakota {
 Pybind11Interface::Pybind11Interface(const ProblemDescDB& problem_db)
   : DirectApplicInterface(problem_db),
     userNumpyFlag(problem_db.get_bool("interface.python.numpy")),
+    columnarBatchFlag(problem_db.get_bool("interface.python.columnar_batch")),
     ownPython(false),
     py11Active(false)
 {
@@ -40,6 +41,11 @@ Pybind11Interface::Pybind11Interface(const ProblemDescDB& problem_db)
 	 << "exactly one\nanalysis_driver string\n";
     abort_handler(INTERFACE_ERROR);
   }
+  if (columnarBatchFlag && !batchEval) {
+    Cerr << "\nError: interface > python > columnar_batch requires the batch "
+	 << "option.\n";
+    abort_handler(INTERFACE_ERROR);
+  }
 
   if (!Py_IsInitialized()) {
     py::initialize_interpreter();
@@ -56,10 +62,11 @@ Pybind11Interface::Pybind11Interface(const ProblemDescDB& problem_db)
     }
   }
 
-  if (userNumpyFlag) {
+  if (userNumpyFlag || columnarBatchFlag) {
 #ifndef DAKOTA_PYTHON_NUMPY
-    Cerr << "\nError: Direct Python interface 'numpy' option requested, but "
-	 << "Dakota was not built with numpy support enabled."
+    Cerr << "\nError: Direct Python interface 'numpy' or 'columnar_batch' "
+	 << "option requested, but\nDakota was not built with numpy support "
+	 << "enabled."
          << std::endl;
     abort_handler(-1);
 #endif
@@ -130,6 +137,14 @@ void Pybind11Interface::wait_local_evaluations(PRPQueue& prp_queue)
 
   initialize_driver(analysisDrivers[0]);
 
+  if (columnarBatchFlag) {
+    // the user's python function is called once with the batch stacked
+    // into 2-D arrays and returns stacked response arrays
+    py::dict py_response = py11CallBack(batch_params_to_dict(prp_queue));
+    unpack_python_batch_response(py_response, prp_queue);
+    return;
+  }
+
   // in this case the user's python function is to be called with
   // list<dict>, one list entry per eval
 
@@ -259,6 +274,188 @@ py::dict Pybind11Interface::pack_kwargs() const
 }
 
 
+/** Labels, counts, the DVV, and analysis components are sent once for
+    the batch; values and ASVs are stacked one row per evaluation into
+    numpy arrays that are filled directly from the Variables, without
+    intermediate copies. */
+py::dict Pybind11Interface::batch_params_to_dict(const PRPQueue& prp_queue)
+{
+  // labels and counts are common to the batch
+  const ParamResponsePair& first_prp = *prp_queue.begin();
+  set_local_data(first_prp.variables(), first_prp.active_set(),
+		 first_prp.response());
+
+  const size_t num_evals = prp_queue.size();
+  py::array_t<double> cv({num_evals, numACV}), drv({num_evals, numADRV});
+  py::array_t<int> div({num_evals, numADIV}), asv({num_evals, numFns}),
+    eval_ids(num_evals);
+  py::list dsv;
+  double *cv_data = cv.mutable_data(), *drv_data = drv.mutable_data();
+  int *div_data = div.mutable_data(), *asv_data = asv.mutable_data(),
+    *id_data = eval_ids.mutable_data();
+
+  size_t e = 0, i;
+  for (const auto& prp : prp_queue) {
+    const ActiveSet& set = prp.active_set();
+    const ShortArray& eval_asv = set.request_vector();
+    if (eval_asv.size() != numFns || set.derivative_vector() != directFnDVV)
+      throw(std::runtime_error("Pybind11 Direct Interface: columnar_batch "
+			       "requires the same functions and derivative "
+			       "variables for each evaluation in the batch"));
+    const Variables& vars = prp.variables();
+    const RealVector& acv  = vars.all_continuous_variables();
+    const IntVector&  adiv = vars.all_discrete_int_variables();
+    const RealVector& adrv = vars.all_discrete_real_variables();
+    StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+    for (i=0; i<numACV; ++i)
+      *cv_data++ = acv[i];
+    for (i=0; i<numADIV; ++i)
+      *div_data++ = adiv[i];
+    for (i=0; i<numADRV; ++i)
+      *drv_data++ = adrv[i];
+    for (i=0; i<numFns; ++i)
+      *asv_data++ = eval_asv[i];
+    dsv.append(copy_array_to_pybind11<py::list,StringMultiArrayConstView,
+	       String>(adsv));
+    id_data[e++] = prp.eval_id();
+  }
+
+  py::list all_var_labels = copy_array_to_pybind11<py::list,StringArray,String>(xAllLabels);
+  py::list cv_labels  = copy_array_to_pybind11<py::list,StringMultiArray,String>(xCLabels);
+  py::list div_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDILabels);
+  py::list dsv_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDSLabels);
+  py::list drv_labels = copy_array_to_pybind11<py::list,StringMultiArray,String>(xDRLabels);
+  py::array dvv       = copy_array_to_pybind11<py::array,SizetArray,size_t>(directFnDVV);
+  py::list an_comps   = (analysisComponents.size() > 0)
+                      ? copy_array_to_pybind11<py::list,StringArray,String>(analysisComponents[analysisDriverIndex])
+                      : py::list();
+  py::list fn_labels  = copy_array_to_pybind11<py::list,StringArray,String>(fnLabels);
+  py::list md_labels  = copy_array_to_pybind11<py::list,StringArray,String>(metaDataLabels);
+
+  py::dict kwargs = py::dict(
+      "evaluations"_a           = num_evals,
+      "variables"_a             = numVars,
+      "functions"_a             = numFns,
+      "metadata"_a              = metaData.size(),
+      "variable_labels"_a       = all_var_labels,
+      "function_labels"_a       = fn_labels,
+      "metadata_labels"_a       = md_labels,
+      "cv"_a                    = cv,
+      "cv_labels"_a             = cv_labels,
+      "div"_a                   = div,
+      "div_labels"_a            = div_labels,
+      "dsv"_a                   = dsv,
+      "dsv_labels"_a            = dsv_labels,
+      "drv"_a                   = drv,
+      "drv_labels"_a            = drv_labels,
+      "asv"_a                   = asv,
+      "dvv"_a                   = dvv,
+      "analysis_components"_a   = an_comps,
+      "eval_ids"_a              = eval_ids);
+
+  return kwargs;
+}
+
+
+/// return the C-contiguous double array stored under key, converting
+/// (copying) only if the returned object is not one already
+static py::array_t<double, py::array::c_style | py::array::forcecast>
+batch_response_array(const pybind11::dict& py_response, const char* key,
+		     const std::vector<size_t>& shape)
+{
+  std::string err_key = std::string("Pybind11 Direct Interface [\"") + key
+    + "\"]: ";
+  if (!py_response.contains(key))
+    throw(std::runtime_error("Pybind11 Direct Interface: required key [\""
+			     + std::string(key) + "\"] absent in dict "
+			     "returned to Dakota"));
+  auto array = py::array_t<double, py::array::c_style | py::array::forcecast>
+    ::ensure(py::object(py_response[key]));
+  if (!array)
+    throw(std::runtime_error(err_key + "not convertible to a numpy array"));
+  if ((size_t)array.ndim() != shape.size())
+    throw(std::runtime_error(err_key + "expected a "
+			     + std::to_string(shape.size()) + "-D array"));
+  for (size_t d=0; d<shape.size(); ++d)
+    if ((size_t)array.shape(d) != shape[d])
+      throw(std::runtime_error(err_key + "incorrect size of dimension "
+			       + std::to_string(d)));
+  return array;
+}
+
+
+/** Expects "fns" shaped (evaluations, functions), "fnGrads"
+    (evaluations, functions, derivatives), "fnHessians" (evaluations,
+    functions, derivatives, derivatives), and "metadata" (evaluations,
+    metadata), each required when requested for any evaluation.  The
+    data are copied directly into the Responses. */
+void Pybind11Interface::
+unpack_python_batch_response(const pybind11::dict& py_response,
+			     PRPQueue& prp_queue)
+{
+  const size_t num_evals = prp_queue.size(), num_derivs = directFnDVV.size(),
+    num_md = metaData.size();
+  short asv_union = 0;
+  for (const auto& prp : prp_queue)
+    for (short a : prp.active_set().request_vector())
+      asv_union |= a;
+
+  py::array_t<double, py::array::c_style | py::array::forcecast>
+    fns, grads, hess, md;
+  const double *fns_data = NULL, *grads_data = NULL, *hess_data = NULL,
+    *md_data = NULL;
+  if (asv_union & 1) {
+    fns = batch_response_array(py_response, "fns", {num_evals, numFns});
+    fns_data = fns.data();
+  }
+  if (asv_union & 2) {
+    grads = batch_response_array(py_response, "fnGrads",
+				 {num_evals, numFns, num_derivs});
+    grads_data = grads.data();
+  }
+  if (asv_union & 4) {
+    hess = batch_response_array(py_response, "fnHessians",
+				{num_evals, numFns, num_derivs, num_derivs});
+    hess_data = hess.data();
+  }
+  if (num_md > 0) {
+    md = batch_response_array(py_response, "metadata", {num_evals, num_md});
+    md_data = md.data();
+  }
+
+  size_t e = 0, i, j, k;
+  for (auto& prp : prp_queue) {
+    const ShortArray& asv = prp.active_set().request_vector();
+    // shallow copy technically violates const-ness
+    Response resp = prp.response();
+    for (i=0; i<numFns; ++i) {
+      size_t fn_offset = e * numFns + i;
+      if (asv[i] & 1)
+	resp.function_value(fns_data[fn_offset], i);
+      if (asv[i] & 2) {
+	RealVector grad = resp.function_gradient_view(i);
+	const double* py_grad = grads_data + fn_offset * num_derivs;
+	for (j=0; j<num_derivs; ++j)
+	  grad[j] = py_grad[j];
+      }
+      if (asv[i] & 4) {
+	RealSymMatrix hessian = resp.function_hessian_view(i);
+	const double* py_hess = hess_data + fn_offset * num_derivs * num_derivs;
+	for (j=0; j<num_derivs; ++j)
+	  for (k=0; k<=j; ++k)
+	    hessian(j, k) = py_hess[j * num_derivs + k];
+      }
+    }
+    if (num_md > 0) {
+      metaData.assign(md_data + e * num_md, md_data + (e+1) * num_md);
+      resp.metadata(metaData);
+    }
+    completionSet.insert(prp.eval_id());
+    ++e;
+  }
+}
+
+
 void Pybind11Interface::unpack_python_response
 (const ShortArray& asv, const size_t num_derivs,
  const pybind11::dict& py_response, RealVector& fn_values,
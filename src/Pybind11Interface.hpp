@@ -67,6 +67,9 @@ class Pybind11Interface: public DirectApplicInterface
 
     /// whether the user requested numpy data structures in the input file
     bool userNumpyFlag;
+    /// whether batches are passed as one dict of 2-D arrays (vs. a
+    /// list of per-evaluation dicts)
+    bool columnarBatchFlag;
     /// true if this class created the interpreter instance
     bool ownPython;
     /// callback function for analysis driver
@@ -91,6 +94,15 @@ class Pybind11Interface: public DirectApplicInterface
     template<typename T>
     py::dict pack_kwargs() const;
 
+    /// Translate the parameters of a batch of evaluations into a single
+    /// Python dictionary of 2-D (evaluation x variable) numpy arrays
+    py::dict batch_params_to_dict(const PRPQueue& prp_queue);
+
+    /// populate values, gradients, Hessians of each evaluation in the
+    /// batch from the stacked numpy arrays returned from Python
+    void unpack_python_batch_response(const pybind11::dict& py_response,
+				      PRPQueue& prp_queue);
+
     /// populate values, gradients, Hessians from Python to Dakota
     void unpack_python_response
     (const ShortArray& asv, const size_t num_derivs,
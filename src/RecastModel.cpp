@@ -515,12 +515,11 @@ void RecastModel::derived_evaluate(const ActiveSet& set)
 
   // the incoming set is for the recast problem, which must be converted
   // back to the underlying response set for evaluation by the subModel.
-  ActiveSet sub_model_set;
-  transform_set(currentVariables, set, sub_model_set);
+  transform_set(currentVariables, set, subModelSet);
 
   // evaluate the subModel in the original fn set definition.  Doing this here 
   // eliminates the need for eval tracking logic within the separate eval fns.
-  subModel.evaluate(sub_model_set);
+  subModel.evaluate(subModelSet);
 
   // recast the subModel response ("user space") into the currentResponse
   // ("iterator space")
@@ -549,12 +548,11 @@ void RecastModel::derived_evaluate_nowait(const ActiveSet& set)
 
   // the incoming set is for the recast problem, which must be converted
   // back to the underlying response set for evaluation by the subModel.
-  ActiveSet sub_model_set;
-  transform_set(currentVariables, set, sub_model_set);
+  transform_set(currentVariables, set, subModelSet);
 
   // evaluate the subModel in the original fn set definition.  Doing this here 
   // eliminates the need for eval tracking logic within the separate eval fns.
-  subModel.evaluate_nowait(sub_model_set);
+  subModel.evaluate_nowait(subModelSet);
   // in almost all cases, use of the subModel eval ids is sufficient, but
   // protect against the rare case where not all subModel evaluations being
   // scheduled were spawned from the RecastModel (e.g., a HierarchicalModel
@@ -657,7 +655,9 @@ transform_set(const Variables& recast_vars, const ActiveSet& recast_set,
   // input/output mappings, the recast_asv request is augmented with
   // additional data requirements derived from chain rule differentiation.
   // The default sub-model DVV is just a copy of the recast DVV.
-  ShortArray sub_model_asv(subModel.response_size(), 0);
+  // (assembled in place to reuse the storage of a persistent sub_model_set)
+  ShortArray& sub_model_asv = sub_model_set.request_vector();
+  sub_model_asv.assign(subModel.response_size(), 0);
   for (i=0; i<num_recast_fns; i++) {
     short asv_val = recast_asv[i];
     // For nonlinear variable mappings, gradient required to transform Hessian.
@@ -687,7 +687,6 @@ transform_set(const Variables& recast_vars, const ActiveSet& recast_set,
       sub_model_asv[recast_fn_contributors[j]] |= sub_model_asv_val;
     }
   }
-  sub_model_set.request_vector(sub_model_asv);
 
   // For different views, we still want the same derivative component ids.
   // For variablesMapping, we will assume 1-to-1 at this level.
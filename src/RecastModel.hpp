@@ -392,6 +392,10 @@ protected:
   /// evaluation (request forwarded to subModel)
   bool derived_master_overload() const;
 
+  /// forwarded to subModel, since evaluate_nowait() and synchronize()
+  /// are forwarded to it
+  bool batch_evaluation_available() const;
+
   IntIntPair estimate_partition_bounds(int max_eval_concurrency);
 
   /// set up RecastModel for parallel operations (request forwarded to subModel)
@@ -543,6 +547,9 @@ protected:
 
   /// the sub-model underlying the transformations
   Model subModel;
+  /// sub-model active set reused across evaluations to avoid
+  /// reallocating its request and derivative vectors
+  ActiveSet subModelSet;
 
   /// local evaluation id counter used for id mapping
   int recastModelEvalCntr;
@@ -1072,6 +1079,10 @@ inline bool RecastModel::derived_master_overload() const
 { return subModel.derived_master_overload(); }
 
 
+inline bool RecastModel::batch_evaluation_available() const
+{ return subModel.batch_evaluation_available(); }
+
+
 inline IntIntPair RecastModel::
 estimate_partition_bounds(int max_eval_concurrency)
 { return subModel.estimate_partition_bounds(max_eval_concurrency); }
@@ -0,0 +1,153 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        ResultsFileWatcher
+//- Description:  Class implementation
+
+#include "ResultsFileWatcher.hpp"
+#include <boost/filesystem/operations.hpp>
+
+#ifdef DAKOTA_HAVE_INOTIFY
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif // DAKOTA_HAVE_INOTIFY
+
+
+namespace Dakota {
+
+ResultsFileWatcher::ResultsFileWatcher(): notifyFd(-1), overflowFlag(false)
+{
+#ifdef DAKOTA_HAVE_INOTIFY
+  notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif // DAKOTA_HAVE_INOTIFY
+}
+
+
+ResultsFileWatcher::~ResultsFileWatcher()
+{
+#ifdef DAKOTA_HAVE_INOTIFY
+  if (notifyFd >= 0)
+    close(notifyFd);
+#endif // DAKOTA_HAVE_INOTIFY
+}
+
+
+void ResultsFileWatcher::
+watch(int fn_eval_id, const boost::filesystem::path& results_file)
+{
+  if (!active())
+    return;
+
+#ifdef DAKOTA_HAVE_INOTIFY
+  boost::filesystem::path abs_file = boost::filesystem::absolute(results_file);
+  std::string dir_name = abs_file.parent_path().string(),
+    file_name = abs_file.filename().string();
+
+  std::map<std::string, std::pair<int, int> >::iterator dw_it
+    = dirWatches.find(dir_name);
+  if (dw_it == dirWatches.end()) {
+    int wd = inotify_add_watch(notifyFd, dir_name.c_str(),
+			       IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) // e.g., watch limit reached: left to the periodic sweep
+      return;
+    dw_it = dirWatches.insert(std::make_pair(dir_name,
+					     std::make_pair(wd, 0))).first;
+  }
+  ++dw_it->second.second;
+
+  std::pair<int, std::string> wd_file(dw_it->second.first, file_name);
+  evalFiles[fn_eval_id] = wd_file;
+  fileEvals[wd_file]    = fn_eval_id;
+
+  // the job may have finished before the watch was established
+  if (boost::filesystem::exists(abs_file))
+    readyIds.insert(fn_eval_id);
+#endif // DAKOTA_HAVE_INOTIFY
+}
+
+
+void ResultsFileWatcher::unwatch(int fn_eval_id)
+{
+  readyIds.erase(fn_eval_id);
+
+#ifdef DAKOTA_HAVE_INOTIFY
+  std::map<int, std::pair<int, std::string> >::iterator ef_it
+    = evalFiles.find(fn_eval_id);
+  if (ef_it == evalFiles.end())
+    return;
+  int wd = ef_it->second.first;
+  fileEvals.erase(ef_it->second);
+  evalFiles.erase(ef_it);
+
+  // release the directory watch once no evaluations reference it
+  std::map<std::string, std::pair<int, int> >::iterator dw_it;
+  for (dw_it = dirWatches.begin(); dw_it != dirWatches.end(); ++dw_it)
+    if (dw_it->second.first == wd) {
+      if (--dw_it->second.second == 0) {
+	inotify_rm_watch(notifyFd, wd);
+	dirWatches.erase(dw_it);
+      }
+      break;
+    }
+#endif // DAKOTA_HAVE_INOTIFY
+}
+
+
+bool ResultsFileWatcher::ready_evaluations(IntSet& ready_ids, int timeout_ms)
+{
+#ifdef DAKOTA_HAVE_INOTIFY
+  if (active()) {
+    process_events();
+    if (readyIds.empty() && !overflowFlag && timeout_ms > 0) {
+      struct pollfd pfd;
+      pfd.fd = notifyFd; pfd.events = POLLIN; pfd.revents = 0;
+      if (poll(&pfd, 1, timeout_ms) > 0)
+	process_events();
+    }
+  }
+#endif // DAKOTA_HAVE_INOTIFY
+
+  ready_ids.insert(readyIds.begin(), readyIds.end());
+  readyIds.clear();
+  bool sweep = overflowFlag;
+  overflowFlag = false;
+  return sweep;
+}
+
+
+void ResultsFileWatcher::process_events()
+{
+#ifdef DAKOTA_HAVE_INOTIFY
+  // buffer aligned for struct inotify_event, per inotify(7)
+  char buffer[4096]
+    __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  for (;;) {
+    ssize_t len = read(notifyFd, buffer, sizeof(buffer));
+    if (len <= 0) // EAGAIN: queue drained
+      break;
+    for (char* ptr = buffer; ptr < buffer + len; ) {
+      const struct inotify_event* event = (const struct inotify_event*)ptr;
+      if (event->mask & IN_Q_OVERFLOW)
+	overflowFlag = true;
+      else if (event->len) {
+	std::map<std::pair<int, std::string>, int>::iterator fe_it
+	  = fileEvals.find(std::make_pair(event->wd, std::string(event->name)));
+	if (fe_it != fileEvals.end())
+	  readyIds.insert(fe_it->second);
+      }
+      ptr += sizeof(struct inotify_event) + event->len;
+    }
+  }
+#endif // DAKOTA_HAVE_INOTIFY
+}
+
+} // namespace Dakota
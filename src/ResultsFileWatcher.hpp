@@ -0,0 +1,105 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+//- Class:        ResultsFileWatcher
+//- Description:  Event-driven detection of completed results files
+
+#ifndef RESULTS_FILE_WATCHER_H
+#define RESULTS_FILE_WATCHER_H
+
+#include "dakota_data_types.hpp"
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <string>
+
+
+namespace Dakota {
+
+/// Utility class that reports which asynchronous evaluations may have
+/// produced their results file, without polling the file system.
+
+/** Where the kernel supports it (Linux inotify), the parent directory
+    of each watched results file is monitored for files that are closed
+    after writing (IN_CLOSE_WRITE) or renamed into place (IN_MOVED_TO,
+    the atomic-rename idiom used by many drivers).  The cost of a
+    completion test is then proportional to the number of completed
+    jobs rather than the number of jobs in flight.  Events are only a
+    hint: callers still validate the file when reading it and must
+    fall back to polling when active() is false.  Writes by other
+    hosts on a shared file system do not generate events, so callers
+    should also perform an occasional full sweep. */
+
+class ResultsFileWatcher
+{
+public:
+
+  //
+  //- Heading: Constructor and destructor
+  //
+
+  ResultsFileWatcher();   ///< constructor
+  ~ResultsFileWatcher();  ///< destructor
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// whether event-driven detection is available
+  bool active() const;
+
+  /// begin watching for results_file on behalf of fn_eval_id; an
+  /// evaluation whose file already exists is reported immediately
+  void watch(int fn_eval_id, const boost::filesystem::path& results_file);
+
+  /// stop watching on behalf of fn_eval_id
+  void unwatch(int fn_eval_id);
+
+  /// wait up to timeout_ms milliseconds (0 = nonblocking) for events
+  /// and move the evaluation ids with candidate results files into
+  /// ready_ids; returns true if a full sweep is needed (event queue
+  /// overflow)
+  bool ready_evaluations(IntSet& ready_ids, int timeout_ms);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// drain pending events from the inotify descriptor into readyIds
+  void process_events();
+
+  //
+  //- Heading: Data members
+  //
+
+  /// inotify file descriptor (-1 if unavailable)
+  int notifyFd;
+
+  /// set when the kernel event queue overflowed and events were lost
+  bool overflowFlag;
+
+  /// watch descriptor and reference count for each watched directory
+  std::map<std::string, std::pair<int, int> > dirWatches;
+  /// (watch descriptor, file name) for each watched evaluation
+  std::map<int, std::pair<int, std::string> > evalFiles;
+  /// reverse lookup from (watch descriptor, file name) to evaluation id
+  std::map<std::pair<int, std::string>, int> fileEvals;
+
+  /// evaluations with completion events not yet reported
+  IntSet readyIds;
+};
+
+
+inline bool ResultsFileWatcher::active() const
+{ return notifyFd >= 0; }
+
+} // namespace Dakota
+
+#endif
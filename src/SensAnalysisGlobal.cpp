@@ -18,6 +18,7 @@
 #include "ResultsManager.hpp"
 #include "dakota_linear_algebra.hpp"
 #include "dakota_stat_util.hpp"
+#include "util_threads.hpp"
 #include <algorithm>
 #include <boost/iterator/counting_iterator.hpp>
 
@@ -26,13 +27,6 @@ static const char rcsId[]="@(#) $Id: SensAnalysisGlobal.cpp 6170 2009-10-06 22:4
 
 namespace Dakota {
 
-RealArray SensAnalysisGlobal::rawData = RealArray();
-
-
-bool SensAnalysisGlobal::rank_sort(const int& x, const int& y)
-{ return rawData[x]<rawData[y]; }
-
-
 size_t SensAnalysisGlobal::
 find_valid_samples(const IntResponseMap& resp_samples, BoolDeque& valid_sample)
 {
@@ -100,38 +94,11 @@ valid_sample_matrix(const RealMatrix&     vars_samples,
 }
 
 
-/** When converting values to ranks, uses the average ranks of any tied values */
+/** When converting values to ranks, uses the average ranks of any tied
+    values.  Each var/resp row is sorted independently (and the rows
+    concurrently for large sample sets). */
 void SensAnalysisGlobal::values_to_ranks(RealMatrix& valid_data)
-{
-  int num_corr = valid_data.numRows(), num_valid_samples = valid_data.numCols();
-  // for each var/resp
-  for (int i=0; i<num_corr; ++i) {
-    // create a multimap from value to array index (so it is sorted by value and
-    // the ranks are given by the map order); don't need a stable sort as we are
-    // replacing the tied values by their average rank
-    RealIntMultiMap vals_inds;
-    for (int j=0; j<num_valid_samples; ++j)
-      vals_inds.insert(std::make_pair(valid_data(i,j), j));
-
-    // iterate for each unique value and find tied values
-    RealIntMultiMap::const_iterator vi_it = vals_inds.begin();
-    RealIntMultiMap::const_iterator vi_end = vals_inds.end();
-    for (int rank=0; vi_it != vi_end; ) {
-      // find a range of tied values
-      double value = vi_it->first;
-      std::pair<RealIntMultiMap::const_iterator, RealIntMultiMap::const_iterator>
-	tied_range = vals_inds.equal_range(value); 
-      int num_ties = std::distance(tied_range.first, tied_range.second);
-      double avg_rank = (rank + rank+num_ties-1) / 2.0;
-      // all tied values get assigned the average rank
-      for ( ; tied_range.first != tied_range.second; ++tied_range.first)
-	valid_data(i, tied_range.first->second) = avg_rank;
-      // increment to the next unequal value
-      vi_it = tied_range.second;
-      rank += num_ties;
-    }
-  }
-}
+{ rows_to_average_ranks(valid_data); }
 
 
 void SensAnalysisGlobal::correl_adjust(Real& corr_value)
@@ -260,6 +227,111 @@ compute_correlations(const RealMatrix&     vars_samples,
 }
 
 
+/** Used when the samples are not retained: raw correlations are formed
+    from the co-moments as for the sample data in simple_corr() and
+    partial_corr(), while rank correlations, which require the full
+    sample set, are not computed. */
+void SensAnalysisGlobal::
+compute_correlations(const RealMatrix& comoments, size_t num_vars,
+		     size_t num_obs)
+{
+  int i, j, k, num_corr = comoments.numRows(), num_in = num_vars,
+    num_out = num_corr - num_in;
+  numVars = num_vars;
+  numFns  = num_out;
+  simpleRankCorr.shape(0, 0);
+  partialRankCorr.shape(0, 0);
+  numericalIssuesRank = false;
+
+  // simple correlations: co-moments normalized by root sums of squares
+  simpleCorr.shape(num_corr, num_corr);
+  partialCorr.shape(num_in, num_out);
+  if (num_obs <= 1) {
+    simpleCorr.putScalar(std::numeric_limits<Real>::quiet_NaN());
+    partialCorr.putScalar(std::numeric_limits<Real>::quiet_NaN());
+    numericalIssuesRaw = true;
+    corrComputed = true;
+    return;
+  }
+  for (i=0; i<num_corr; ++i) {
+    for (j=0; j<i; ++j) {
+      simpleCorr(i,j) = simpleCorr(j,i) = comoments(i,j)
+	/ std::sqrt(comoments(i,i)) / std::sqrt(comoments(j,j));
+      correl_adjust(simpleCorr(i,j));
+      correl_adjust(simpleCorr(j,i));
+    }
+    simpleCorr(i,i) = comoments(i,i) / comoments(i,i);
+    if (std::isfinite(simpleCorr(i,i)))
+      simpleCorr(i,i) = 1.0;
+  }
+
+  // partial correlations: for X = [Vi | R] controlling for Z = [V~i], form
+  // X'X - (X'Z)*pinv(Z'Z)*(Z'X) from blocks of the co-moment matrix
+  numericalIssuesRaw = false;
+  if (num_in == 1) {
+    for (k=0; k<num_out; ++k)
+      partialCorr(0, k) = simpleCorr(0, k+1);
+    corrComputed = true;
+    return;
+  }
+  RealMatrix Zt_Z(num_in - 1, num_in - 1, false),
+    Zt_X(num_in - 1, 1 + num_out, false), partial_cov(1 + num_out, 1 + num_out);
+  IntArray x_ids(1 + num_out), z_ids(num_in - 1);
+  for (k=0; k<num_out; ++k)
+    x_ids[k+1] = num_in + k;
+  for (i=0; i<num_in; ++i) {
+    x_ids[0] = i;
+    for (k=0; k<i; ++k)         z_ids[k]   = k;
+    for (k=i+1; k<num_in; ++k)  z_ids[k-1] = k;
+    for (j=0; j<num_in-1; ++j) {
+      for (k=0; k<num_in-1; ++k)
+	Zt_Z(k,j) = comoments(z_ids[k], z_ids[j]);
+      for (k=0; k<1+num_out; ++k)
+	Zt_X(j,k) = comoments(z_ids[j], x_ids[k]);
+    }
+    for (j=0; j<1+num_out; ++j)
+      for (k=0; k<1+num_out; ++k)
+	partial_cov(k,j) = comoments(x_ids[k], x_ids[j]);
+
+    // pseudo-inverse of the symmetric Z'Z = V S V' via its SVD
+    RealVector sing_vals;
+    RealMatrix v_trans;
+    svd(Zt_Z, sing_vals, v_trans);
+    Real tol = std::numeric_limits<Real>::epsilon() * (num_in - 1)
+      * sing_vals[0];
+    int sv_keep = 0;
+    for ( ; sv_keep < sing_vals.length(); ++sv_keep)
+      if (!(sing_vals[sv_keep] > tol))
+	break;
+    bool numerical_except = (sv_keep == 0);
+    if (!numerical_except) {
+      // S^{-1/2} V' Z'X, so that the update is its Gramian
+      v_trans.reshape(sv_keep, num_in - 1);
+      RealMatrix Sinv_Vt_Zt_X(sv_keep, 1 + num_out, false);
+      Sinv_Vt_Zt_X.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0,
+			    v_trans, Zt_X, 0.0);
+      for (j=0; j<sv_keep; ++j)
+	for (k=0; k<1+num_out; ++k)
+	  Sinv_Vt_Zt_X(j,k) /= std::sqrt(sing_vals[j]);
+      partial_cov.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, -1.0,
+			   Sinv_Vt_Zt_X, Sinv_Vt_Zt_X, 1.0);
+    }
+    numericalIssuesRaw = numericalIssuesRaw || numerical_except;
+
+    for (k=0; k<num_out; ++k) {
+      if (numerical_except)
+	partialCorr(i,k) = std::numeric_limits<Real>::quiet_NaN();
+      else
+	partialCorr(i,k) = partial_cov(0, k+1) / std::sqrt(partial_cov(0,0)) /
+	  std::sqrt(partial_cov(k+1, k+1));
+      correl_adjust(partialCorr(i,k));
+    }
+  }
+
+  corrComputed = true;
+}
+
+
 /** Calculates simple correlation coefficients from a matrix of data
     (oriented factors x observations):
      - num_corr is number of rows of total data 
@@ -810,6 +882,11 @@ print_std_regress_coeffs(std::ostream& s, StringArray var_labels,
 #endif
 }
 
+/** The responses are ordered as allSamples: num_samples each of the
+    replicates A, B, and A_B^i for each variable i.  All variables and
+    functions are computed in one pass over the responses, with the
+    variables distributed over threads for large studies; the result
+    does not depend on the number of threads. */
 void SensAnalysisGlobal::compute_vbd_stats( const size_t           numFunctions
                                           , const size_t           num_vars
                                           , const size_t           num_samples
@@ -823,28 +900,22 @@ void SensAnalysisGlobal::compute_vbd_stats( const size_t           numFunctions
          << std::endl;
     abort_handler(METHOD_ERROR);
   }
-  
-  // BMA: for now copy the data to previous data structure 
-  //      total_fn_vals[respFn][replicate][sample]
-  // This is making the assumption that the responses are ordered as allSamples
+
+  // Reference the function values in place rather than copying them:
+  // fn_vals[i*num_samples + j] holds the values of sample j in replicate i
   // BMA TODO: compute statistics on finite samples only
-  boost::multi_array<Real,3> total_fn_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
+  const size_t num_fns = numFunctions;
+  std::vector<const Real*> fn_vals(num_samples * (num_vars+2));
   IntRespMCIter r_it = resp_samples.begin();
-  for (size_t i(0); i < (num_vars+2); ++i) {
-    for (size_t j(0); j < num_samples; ++r_it, ++j) {
-      for (size_t k(0); k < numFunctions; ++k) {
-        total_fn_vals[k][i][j] = r_it->second.function_value(k);
-      }
-    }
-  }
+  for (size_t e(0); e < fn_vals.size(); ++r_it, ++e)
+    fn_vals[e] = r_it->second.function_values().values();
 
 #ifdef DEBUG
-  //Cout << "allSamples:\n" << allSamples << '\n';
-  for (size_t k(0); k < numFunctions; ++k) {
+  for (size_t k(0); k < num_fns; ++k) {
     for (size_t i(0); i < num_vars+2; ++i) {
       for (size_t j(0); j < num_samples; ++j) {
         Cout << "Response " << k << " for replicate " << i << ", sample " << j
-             << ": " << total_fn_vals[k][i][j] << '\n';
+             << ": " << fn_vals[i*num_samples + j][k] << '\n';
       }
     }
   }
@@ -866,65 +937,87 @@ void SensAnalysisGlobal::compute_vbd_stats( const size_t           numFunctions
   indexSi.resize(numFunctions, RealVector(num_vars));
   indexTi.resize(numFunctions, RealVector(num_vars));
 
-  boost::multi_array<Real,3> total_norm_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
-
   Real dNumSamples( static_cast<Real>(num_samples) );
 
-  // Obtain sensitivity indices for each function
-  for (size_t k(0); k < numFunctions; ++k) {
-    Real mean_C(0.);
-    {
-      Real mean_hatY(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatY += total_fn_vals[k][0][j];
-      }
-      mean_hatY /= dNumSamples;
-
-      Real mean_hatB(0.); 
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatB += total_fn_vals[k][1][j];
-      }
-      mean_hatB /= dNumSamples;
-
-      Real overall_mean(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) { 
-          total_norm_vals[k][i][j]  = total_fn_vals[k][i][j];
-          overall_mean             += total_norm_vals[k][i][j];
-        } 
-      }
-      overall_mean /= static_cast<Real>( num_samples * (num_vars+2) );
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) {
-          total_norm_vals[k][i][j] -= overall_mean;
+  // Statistics of replicates A (hatY) and B (hatB).  Contiguous
+  // [sample][fn] copies of these two are the only data reused across
+  // variables; A is shifted by mean_C, which stands in for the overall
+  // mean until it is known (corrected below).
+  RealVector sum_A(num_fns), sum_B(num_fns), mean_C(num_fns),
+    var_hatYC(num_fns);
+  RealArray shifted_A(num_samples * num_fns), vals_B(num_samples * num_fns);
+  for (size_t j(0); j < num_samples; ++j) {
+    const Real* y_A = fn_vals[j];
+    const Real* y_B = fn_vals[num_samples + j];
+    for (size_t k(0); k < num_fns; ++k) {
+      sum_A[k]     += y_A[k];
+      sum_B[k]     += y_B[k];
+      var_hatYC[k] += y_A[k] * y_A[k] + y_B[k] * y_B[k];
+      vals_B[j*num_fns + k] = y_B[k];
+    }
+  }
+  for (size_t k(0); k < num_fns; ++k) {
+    mean_C[k]    = (sum_A[k] + sum_B[k]) / (2. * dNumSamples);
+    var_hatYC[k] = var_hatYC[k] / (2. * dNumSamples) - mean_C[k] * mean_C[k];
+  }
+  for (size_t j(0); j < num_samples; ++j)
+    for (size_t k(0); k < num_fns; ++k)
+      shifted_A[j*num_fns + k] = fn_vals[j][k] - mean_C[k];
+
+  // Sums over the samples of each A_B^i replicate, [var][fn]:
+  // sum_S = sum (y_A - mean_C) (y_ABi - y_B), sum_T = sum (y_ABi - y_B)^2,
+  // sum_Y = sum y_ABi
+  size_t num_sums = num_vars * num_fns;
+  RealArray sum_S(num_sums, 0.), sum_T(num_sums, 0.), sum_Y(num_sums, 0.);
+
+  // Each thread owns a contiguous range of variables.  Samples are
+  // processed in blocks so the A and B values of a block stay in cache
+  // while the thread's replicates stream past them; the sums for each
+  // (var, fn) accumulate in sample order regardless of the thread count.
+  const size_t sample_block = 1024, min_evals_per_thread = 1 << 15;
+  size_t num_threads = dakota::util::num_threads(num_vars,
+    num_vars * num_samples, min_evals_per_thread);
+  dakota::util::run_threads(num_threads, [&](size_t t) {
+    size_t v_start = t * num_vars / num_threads,
+           v_end   = (t+1) * num_vars / num_threads;
+    for (size_t j_start(0); j_start < num_samples; j_start += sample_block) {
+      size_t j_end = std::min(j_start + sample_block, num_samples);
+      for (size_t i(v_start); i < v_end; ++i) {
+        const Real* const* y_ABi = &fn_vals[(i+2) * num_samples];
+        Real *s_S = &sum_S[i*num_fns], *s_T = &sum_T[i*num_fns],
+             *s_Y = &sum_Y[i*num_fns];
+        for (size_t j(j_start); j < j_end; ++j) {
+          const Real *y = y_ABi[j], *a = &shifted_A[j*num_fns],
+                     *b = &vals_B[j*num_fns];
+          for (size_t k(0); k < num_fns; ++k) {
+            Real diff(y[k] - b[k]);
+            s_S[k] += a[k] * diff;
+            s_T[k] += diff * diff;
+            s_Y[k] += y[k];
+          }
         }
       }
-
-      mean_C = (mean_hatB + mean_hatY) / 2.;
     }
+  });
 
-    Real var_hatYC(0.);
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][0][j],2);
-    }
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][1][j],2);
-    }
-    var_hatYC = var_hatYC / (2. * dNumSamples)
-              - mean_C * mean_C;
+  // Obtain sensitivity indices for each function
+  for (size_t k(0); k < num_fns; ++k) {
+    Real overall_mean(sum_A[k] + sum_B[k]);
+    for (size_t i(0); i < num_vars; ++i)
+      overall_mean += sum_Y[i*num_fns + k];
+    overall_mean /= static_cast<Real>( num_samples * (num_vars+2) );
+    // shift A from mean_C to the overall mean:
+    // sum (y_A - mean) diff = sum_S - (mean - mean_C) sum diff
+    Real shift(overall_mean - mean_C[k]);
 
     // calculate first order sensitivity indices and first order total indices
     for (size_t i(0); i < num_vars; ++i) {
-      Real sum_S(0.);
-      Real sum_T(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        Real diff(total_norm_vals[k][i+2][j] - total_norm_vals[k][1][j]);
-        sum_S += total_norm_vals[k][0][j] * diff;
-        sum_T += std::pow(diff, 2);
-      }
-
-      indexSi[k][i] = (sum_S /       dNumSamples ) / var_hatYC;
-      indexTi[k][i] = (sum_T / (2. * dNumSamples)) / var_hatYC;
+      size_t ik = i*num_fns + k;
+      Real sum_diff(sum_Y[ik] - sum_B[k]);
+      indexSi[k][i] = ((sum_S[ik] - shift * sum_diff) /       dNumSamples )
+                    / var_hatYC[k];
+      indexTi[k][i] = ( sum_T[ik]                     / (2. * dNumSamples))
+                    / var_hatYC[k];
     }
   } // for k
 }
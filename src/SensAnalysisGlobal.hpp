@@ -60,6 +60,11 @@ public:
   void compute_correlations(const RealMatrix&     vars_samples,
                             const IntResponseMap& resp_samples);
 
+  /// computes simple and partial correlation matrices from the sums of
+  /// products of deviations of the first num_vars input and remaining
+  /// output factors over num_obs samples (e.g., a CovarianceAccumulator)
+  void compute_correlations(const RealMatrix& comoments, size_t num_vars,
+			    size_t num_obs);
   /// save correlations to database
   void archive_correlations(const StrStrSizet& run_identifier,  
                             ResultsManager& iterator_results,
@@ -78,6 +83,13 @@ public:
   /// has been invoked
   bool correlations_computed() const;
 
+  /// return the simple correlations among inputs and outputs computed
+  /// in compute_correlations()
+  const RealMatrix& simple_correlations() const;
+  /// return the partial correlations (inputs x outputs) computed in
+  /// compute_correlations()
+  const RealMatrix& partial_correlations() const;
+
   /// prints the correlations computed in compute_correlations()
   void print_correlations(std::ostream& s, const StringArray& var_labels,
 			  const StringArray& resp_labels) const;
@@ -106,6 +118,13 @@ public:
                           , const Real          vbdDropTol
                           ) const;
 
+  /// return the VBD main effect indices [fn][var] computed in
+  /// compute_vbd_stats()
+  const RealVectorArray& vbd_main_effects() const;
+  /// return the VBD total effect indices [fn][var] computed in
+  /// compute_vbd_stats()
+  const RealVectorArray& vbd_total_effects() const;
+
   /// archive VBD-based Sobol indices
   void archive_sobol_indices( const StrStrSizet & run_identifier
                             , ResultsManager    & resultsDB
@@ -141,9 +160,6 @@ private:
   /// replace sample values with their ranks, in-place
   void values_to_ranks(RealMatrix& valid_data);
 
-  /// sort algorithm to compute ranks for rank correlations
-  static bool rank_sort(const int& x, const int& y);
-
   /// if result was NaN/Inf, preserve it, otherwise truncate to [-1.0, 1.0]
   void correl_adjust(Real& corr_value);
 
@@ -201,9 +217,6 @@ void archive_partial_correlations(const StrStrSizet& run_identifier,
   /// vector to hold coefficients of determination, eg R^2 values
   RealVector stdRegressCODs;
 
-  /// array to hold temporary data before sort
-  static RealArray rawData;
-
   /// number of responses
   size_t numFns;
   /// number of inputs
@@ -236,6 +249,22 @@ inline SensAnalysisGlobal::~SensAnalysisGlobal()
 inline bool SensAnalysisGlobal::correlations_computed() const
 { return corrComputed; }
 
+
+inline const RealMatrix& SensAnalysisGlobal::simple_correlations() const
+{ return simpleCorr; }
+
+
+inline const RealMatrix& SensAnalysisGlobal::partial_correlations() const
+{ return partialCorr; }
+
+
+inline const RealVectorArray& SensAnalysisGlobal::vbd_main_effects() const
+{ return indexSi; }
+
+
+inline const RealVectorArray& SensAnalysisGlobal::vbd_total_effects() const
+{ return indexTi; }
+
 } // namespace Dakota
 
 #endif
@@ -18,18 +18,26 @@
 #include "ParallelLibrary.hpp"
 #include "CommandShell.hpp"
 #include "WorkdirHelper.hpp"
+#include <algorithm>
 #include <thread>
 
 namespace Dakota {
 
+const int SysCallApplicInterface::resultsSweepMs; // odr-used by chrono
+
 SysCallApplicInterface::
 SysCallApplicInterface(const ProblemDescDB& problem_db):
-  ProcessApplicInterface(problem_db)
+  ProcessApplicInterface(problem_db),
+  lastSweepTime(std::chrono::steady_clock::now())
 { }
 
 
 void SysCallApplicInterface::map_bookkeeping(pid_t pid, int fn_eval_id)
-{ sysCallSet.insert(fn_eval_id); } // ignores pid
+{
+  sysCallSet.insert(fn_eval_id); // ignores pid
+  resultsWatcher.watch(fn_eval_id,
+    completion_file(fileNameMap[fn_eval_id].get<1>()));
+}
 
 
 pid_t SysCallApplicInterface::create_evaluation_process(bool block_flag)
@@ -120,15 +128,44 @@ pid_t SysCallApplicInterface::create_evaluation_process(bool block_flag)
 
 
 /** Check for completion of active asynch jobs (tracked with sysCallSet).
-    Make one pass through sysCallSet & complete all jobs that have returned. */
-void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
+    Make one pass through the candidate jobs & complete all that have
+    returned.  Candidates are all of sysCallSet when polling; with
+    event-driven detection, they are the jobs with results file events
+    plus those awaiting a read retry, widened to all of sysCallSet every
+    resultsSweepMs (or on event loss) to catch results from remote
+    hosts on shared file systems. */
+void SysCallApplicInterface::
+poll_local_evaluations(PRPQueue& prp_queue, int timeout_ms)
 {
   // Convenience function for common code between wait and nowait case.
 
-  for (ISIter it=sysCallSet.begin(); it!=sysCallSet.end(); ++it) {
+  bool event_driven = resultsWatcher.active(), sweep = true;
+  IntSet event_ids;
+  if (event_driven) {
+    using namespace std::chrono;
+    int to_sweep = resultsSweepMs - (int)duration_cast<milliseconds>
+      (steady_clock::now() - lastSweepTime).count();
+    if (!failCountMap.empty()) // retry incomplete reads promptly
+      timeout_ms = std::min(timeout_ms, 1);
+    timeout_ms = std::max(0, std::min(timeout_ms, to_sweep));
+    bool overflow = resultsWatcher.ready_evaluations(event_ids, timeout_ms);
+    sweep = overflow || steady_clock::now() - lastSweepTime
+      >= milliseconds(resultsSweepMs);
+    if (sweep)
+      lastSweepTime = steady_clock::now();
+    else
+      for (IntShMIter fc_it = failCountMap.begin();
+	   fc_it != failCountMap.end(); ++fc_it)
+	event_ids.insert(fc_it->first);
+  }
+  const IntSet& candidates = (sweep) ? sysCallSet : event_ids;
+
+  for (ISCIter it=candidates.begin(); it!=candidates.end(); ++it) {
 
     // Identify the corresponding PRPair
     int fn_eval_id = *it;
+    if (!sweep && !sysCallSet.count(fn_eval_id))
+      continue; // stale event
     bool err_msg_caught = false;
 
     // Test for existence of the results file(s) corresponding to this PRPair
@@ -210,12 +247,16 @@ void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
   }
 
   // reduce processor load from DAKOTA testing if jobs are not finishing
-  if (completionSet.empty()) { // no jobs completed in pass through entire set
+  // (event-driven detection has already waited for events above)
+  if (completionSet.empty() && !event_driven) {
+    // no jobs completed in pass through entire set
     std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
   // remove completed jobs from sysCallSet
-  for (ISCIter it = completionSet.begin(); it != completionSet.end(); ++it)
+  for (ISCIter it = completionSet.begin(); it != completionSet.end(); ++it) {
     sysCallSet.erase(*it);
+    resultsWatcher.unwatch(*it);
+  }
 }
 
 
@@ -236,9 +277,7 @@ bool SysCallApplicInterface::system_call_file_test(const bfs::path& root_file)
 #else
     // Testing all files is usually overkill for sequential analyses.  It's only
     // really necessary to check the last tagged_file: root_file.[num_programs]
-    bfs::path tagged_file = 
-      WorkdirHelper::concat_path(root_file, "." + std::to_string(num_programs));
-    return bfs::exists(tagged_file);
+    return bfs::exists(completion_file(root_file));
 #endif // __SUNPRO_CC
   }
   else
@@ -246,6 +285,16 @@ bool SysCallApplicInterface::system_call_file_test(const bfs::path& root_file)
 }
 
 
+bfs::path SysCallApplicInterface::
+completion_file(const bfs::path& root_file) const
+{
+  size_t num_programs = programNames.size();
+  return ( num_programs > 1 && oFilterName.empty() ) ?
+    WorkdirHelper::concat_path(root_file, "." + std::to_string(num_programs)) :
+    root_file;
+}
+
+
 /** Put the SysCallApplicInterface to the shell.  This function is
     used when all portions of the function evaluation (i.e., all analysis
     drivers) are executed on the local processor. */
@@ -17,7 +17,8 @@
 #define SYS_CALL_APPLIC_INTERFACE_H
 
 #include "ProcessApplicInterface.hpp"
-
+#include "ResultsFileWatcher.hpp"
+#include <chrono>
 
 namespace Dakota {
 
@@ -70,6 +71,14 @@ private:
   /// detect completion of a function evaluation through existence of
   /// the necessary results file(s); return true if results files found
   bool system_call_file_test(const bfs::path& root_file);
+  /// the results file whose appearance signals completion of an evaluation
+  /// (the last tagged file for multiple drivers without an output filter)
+  bfs::path completion_file(const bfs::path& root_file) const;
+
+  /// test the active evaluations that may have completed, waiting up to
+  /// timeout_ms for a completion event when event detection is active
+  /// (0 for a nonblocking test)
+  void poll_local_evaluations(PRPQueue& prp_queue, int timeout_ms);
 
   /// spawn a complete function evaluation
   void spawn_evaluation_to_shell(bool block_flag);
@@ -84,12 +93,23 @@ private:
   //- Heading: Data
   //
 
+  /// milliseconds between full sweeps of the active results files when
+  /// event-driven completion detection is active
+  static const int resultsSweepMs = 100;
+
   /// set of function evaluation id's for active asynchronous
   /// system call evaluations
   IntSet sysCallSet;
     
   /// map linking function evaluation id's to number of response read failures
   IntShortMap failCountMap; 
+
+  /// event-driven detection of results files for sysCallSet; when
+  /// inactive, every pass tests all of sysCallSet
+  ResultsFileWatcher resultsWatcher;
+  /// time of the last test of all of sysCallSet, which catches results
+  /// written without a local file system event (e.g., by remote hosts)
+  std::chrono::steady_clock::time_point lastSweepTime;
 };
 
 
@@ -102,15 +122,25 @@ inline SysCallApplicInterface::~SysCallApplicInterface()
     This satisifies a "fairness" principle, in the sense that a completed job
     will _always_ be processed (whereas accepting only a single completion 
     could always accept the same completion - the case of very inexpensive fn.
-    evals. - and starve some servers). */
+    evals. - and starve some servers).  With event-driven detection,
+    each pass blocks until a results file event or the next full sweep. */
 inline void SysCallApplicInterface::
 wait_local_evaluation_sequence(PRPQueue& prp_queue)
 {
   while (completionSet.empty()) // complete at least one job
-    test_local_evaluation_sequence(prp_queue);
+    poll_local_evaluations(prp_queue, resultsSweepMs);
 }
 
 
+/** Make one pass over the active asynch jobs.  As for the 1 ms sleep
+    of a polling pass that completes no jobs, event-driven detection
+    waits up to 1 ms for an event, so that servers looping over this
+    (e.g., serve_evaluations_asynch()) do not spin. */
+inline void SysCallApplicInterface::
+test_local_evaluation_sequence(PRPQueue& prp_queue)
+{ poll_local_evaluations(prp_queue, 1); }
+
+
 /** This code provides the derived function used by 
     ApplicationInterface::serve_analyses_synch(). */
 inline int SysCallApplicInterface::synchronous_local_analysis(int analysis_id)
@@ -14,9 +14,15 @@
 #include "WorkdirHelper.hpp"
 #include "dakota_data_util.hpp"  // for strcontains
 #include "dakota_global_defs.hpp"
+#include "util_threads.hpp"
 #include <boost/array.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #if defined(_WIN32) || defined(_WIN64)
 
@@ -29,7 +35,13 @@
 
 #else
   #include <unistd.h>
+  #include <fcntl.h>
   #include <sys/param.h>             // for MAXPATHLEN
+  #include <sys/stat.h>
+  #if defined(__linux__)
+    #include <sys/ioctl.h>
+    #include <linux/fs.h>            // for FICLONE
+  #endif
   #define DAK_PATH_ENV_NAME "PATH"
   #define DAK_PATH_SEP ':'
   #define DAK_SLASH '/'
@@ -39,6 +51,104 @@
 
 namespace Dakota {
 
+namespace {
+
+/// minimum number of files cloned by each thread of a concurrent copy
+const size_t min_files_per_thread = 16;
+
+/// Removes renamed paths on a single background thread, recording any
+/// failures for the main thread to report
+class AsyncRemover
+{
+public:
+
+  AsyncRemover(): busy(false)
+  { worker = std::thread(&AsyncRemover::run, this); }
+
+  /// queue a path for removal
+  void push(const bfs::path& rm_path, short fileop_option)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    pending.push_back(std::make_pair(rm_path, fileop_option));
+    work.notify_one();
+  }
+
+  /// block until the queue is drained
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    idle.wait(lock, [this]{ return pending.empty() && !busy; });
+  }
+
+  /// move out the failures recorded so far as (fileop_option, message)
+  void take_failures(std::vector<std::pair<short, String> >& fail)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    fail.swap(failures);
+    failures.clear();
+  }
+
+private:
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      work.wait(lock, [this]{ return !pending.empty(); });
+      std::pair<bfs::path, short> item = pending.front();
+      pending.pop_front();
+      busy = true;
+      lock.unlock();
+      boost::system::error_code ec;
+      bfs::remove_all(item.first, ec);
+      lock.lock();
+      busy = false;
+      if (ec && item.second != FILEOP_SILENT)
+	failures.push_back(std::make_pair(item.second, "could not remove path "
+	  + item.first.string() + ";\n" + ec.message()));
+      if (pending.empty())
+	idle.notify_all();
+    }
+  }
+
+  std::thread worker;
+  std::mutex mtx;
+  std::condition_variable work, idle;
+  std::deque<std::pair<bfs::path, short> > pending;
+  std::vector<std::pair<short, String> > failures;
+  bool busy;
+};
+
+/// The remover is created on first use and never destroyed: its thread
+/// cannot be joined from static destructors run by an exiting fork child.
+/// Callers drain it with WorkdirHelper::wait_async_removals().
+AsyncRemover& async_remover()
+{
+  static AsyncRemover* remover = new AsyncRemover();
+  return *remover;
+}
+
+/// report failed background removals in the calling (main) thread
+void report_async_failures()
+{
+  std::vector<std::pair<short, String> > failures;
+  async_remover().take_failures(failures);
+  bool abort_flag = false;
+  for (size_t i=0; i<failures.size(); ++i) {
+    if (failures[i].first == FILEOP_ERROR) {
+      Cerr << "\nError: " << failures[i].second << std::endl;
+      abort_flag = true;
+    }
+    else
+      Cerr << "\nWarning: " << failures[i].second << std::endl;
+  }
+  if (abort_flag)
+    abort_handler(IO_ERROR);
+}
+
+} // anonymous namespace
+
+
 std::string WorkdirHelper::startupPWD          = ".";
 std::string WorkdirHelper::startupPATH         = ".";
 std::string WorkdirHelper::dakPreferredEnvPath = ".";
@@ -605,6 +715,38 @@ void WorkdirHelper::recursive_remove(const bfs::path& rm_path, short fileop_opt)
 }
 
 
+/** The path is first renamed to a unique sibling, which is cheap and
+    lets a path of the same name be recreated immediately (e.g., an
+    untagged work_directory); the potentially large tree is then removed
+    while evaluations proceed.  If the rename fails, the removal is
+    performed synchronously. */
+void WorkdirHelper::recursive_remove_async(const bfs::path& rm_path,
+					   short fileop_opt)
+{
+  report_async_failures();
+
+  boost::system::error_code ec;
+  if (!bfs::exists(rm_path, ec)) {
+    recursive_remove(rm_path, fileop_opt); // report per fileop_opt
+    return;
+  }
+  bfs::path tmp_path = rm_path.parent_path() /
+    bfs::unique_path(rm_path.filename().string() + ".dakota_remove_%%%%%%%%");
+  bfs::rename(rm_path, tmp_path, ec);
+  if (ec)
+    recursive_remove(rm_path, fileop_opt);
+  else
+    async_remover().push(tmp_path, fileop_opt);
+}
+
+
+void WorkdirHelper::wait_async_removals()
+{
+  async_remover().wait();
+  report_async_failures();
+}
+
+
 void WorkdirHelper::rename(const bfs::path& old_path, const bfs::path& new_path,
 			   short fileop_opt)
 {
@@ -718,8 +860,16 @@ void WorkdirHelper::copy_items(const StringArray& source_items,
 			       const bfs::path& dest_dir,
 			       bool overwrite) 
 {
-  file_op_function file_op = &WorkdirHelper::recursive_copy;
+  // plan all items first, so their files are cloned concurrently
+  std::vector<std::pair<bfs::path, bfs::path> > files;
+  file_op_function file_op =
+    [&files](const bfs::path& src_path, const bfs::path& dest_path,
+	     bool overwrite_item) {
+      plan_copy(src_path, dest_path, overwrite_item, files);
+      return false;
+    };
   file_op_items(file_op, source_items, dest_dir, false);
+  clone_files(files);
 }
 
 
@@ -792,6 +942,17 @@ bool WorkdirHelper::link(const bfs::path& src_path, const bfs::path& dest_dir,
 /// (may need to reconsider)
 bool WorkdirHelper::recursive_copy(const bfs::path& src_path, 
 				   const bfs::path& dest_dir, bool overwrite)
+{
+  std::vector<std::pair<bfs::path, bfs::path> > files;
+  plan_copy(src_path, dest_dir, overwrite, files);
+  clone_files(files);
+  return false;
+}
+
+
+void WorkdirHelper::
+plan_copy(const bfs::path& src_path, const bfs::path& dest_dir,
+	  bool overwrite, std::vector<std::pair<bfs::path, bfs::path> >& files)
 {
   try {
     // precondition: dest exists and is a dir
@@ -809,17 +970,25 @@ bool WorkdirHelper::recursive_copy(const bfs::path& src_path,
 
     if (!bfs::exists(dest_path)) {
 
-      // non-recursive copy of file or directory or symlink into dest
-      bfs::copy(src_path, dest_path);
-      //bfs::create_directory(dest_path);
-      //bfs::copy_directory(src_path, dest_path);
+      // defer regular files to clone_files(); create directories
+      // (including symlinked ones) and copy file symlinks now
+      bfs::file_status src_status = bfs::status(src_path);
+      bool src_dir = bfs::is_directory(src_status);
+      if (bfs::is_regular_file(bfs::symlink_status(src_path)))
+	files.push_back(std::make_pair(src_path, dest_path));
+      else if (src_dir) {
+	bfs::create_directory(dest_path);
+	bfs::permissions(dest_path, src_status.permissions());
+      }
+      else
+	bfs::copy(src_path, dest_path);
 
-      if (bfs::is_directory(src_path)) {
+      if (src_dir) {
 	bfs::directory_iterator dir_it(src_path);
 	bfs::directory_iterator dir_end;
 	for ( ; dir_it != dir_end; ++dir_it) {
 	  bfs::path src_item(dir_it->path());
-	  recursive_copy(src_item, dest_path, overwrite);
+	  plan_copy(src_item, dest_path, overwrite, files);
 	}
       }
     }
@@ -830,7 +999,71 @@ bool WorkdirHelper::recursive_copy(const bfs::path& src_path,
 	 << " to " << dest_dir << ";\n       " << e.what() << std::endl;
     abort_handler(IO_ERROR);
   }
-  return false;
+}
+
+
+void WorkdirHelper::
+clone_files(const std::vector<std::pair<bfs::path, bfs::path> >& files)
+{
+  size_t num_files = files.size(), num_threads
+    = dakota::util::num_threads(num_files, num_files, min_files_per_thread);
+  String error_msg;
+  std::mutex error_mtx;
+  auto clone_range = [&](size_t start, size_t step) {
+    for (size_t i=start; i<num_files; i+=step) {
+      try {
+	clone_file(files[i].first, files[i].second);
+      }
+      catch (const bfs::filesystem_error& e) {
+	std::lock_guard<std::mutex> lock(error_mtx);
+	if (error_msg.empty())
+	  error_msg = "could not recursive copy " + files[i].first.string()
+	    + " to " + files[i].second.parent_path().string() + ";\n       "
+	    + e.what();
+	return;
+      }
+    }
+  };
+
+  dakota::util::run_threads(num_threads,
+    [&](size_t t) { clone_range(t, num_threads); });
+
+  if (!error_msg.empty()) {
+    Cerr << "\nError: " << error_msg << std::endl;
+    abort_handler(IO_ERROR);
+  }
+}
+
+
+/** Copies of large template files (e.g., meshes) dominate work
+    directory setup.  A reflink (Linux FICLONE, e.g., on Btrfs or XFS)
+    shares the data blocks copy-on-write.  Otherwise the contents are
+    copied.  Either way the copy is independent of the source: a
+    hard link is never used, even for a read-only source, since a
+    driver that restores write permission on its copy would modify
+    the template.  Throws bfs::filesystem_error. */
+void WorkdirHelper::clone_file(const bfs::path& src_path,
+			       const bfs::path& dest_path)
+{
+#if defined(__linux__) && defined(FICLONE)
+  int src_fd = open(src_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (src_fd != -1) {
+    struct stat src_stat;
+    int dest_fd = (fstat(src_fd, &src_stat) == 0) ?
+      open(dest_path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+	   src_stat.st_mode & 07777) : -1;
+    if (dest_fd != -1) {
+      bool cloned = (ioctl(dest_fd, FICLONE, src_fd) == 0);
+      close(dest_fd);
+      if (cloned)
+	{ close(src_fd); return; }
+      unlink(dest_path.c_str()); // unsupported: fall back below
+    }
+    close(src_fd);
+  }
+#endif
+
+  bfs::copy_file(src_path, dest_path);
 }
 
 
@@ -178,6 +178,15 @@ public:
   /// type.  Only error if existed and there's an error in the remove.
   static void recursive_remove(const bfs::path& rm_path, short fileop_option);
 
+  /// Rename a path out of the way and remove it on a background thread,
+  /// so the caller (and any new path of the same name) need not wait
+  static void recursive_remove_async(const bfs::path& rm_path,
+				     short fileop_option);
+
+  /// Block until all removals started by recursive_remove_async() are
+  /// complete
+  static void wait_async_removals();
+
   /// Rename a file, catching any errors and optionally warning/erroring.
   static void rename(const bfs::path& old_path, const bfs::path& new_path,
 		     short fileop_option);
@@ -223,6 +232,12 @@ public:
   static bool link(const bfs::path& src_path,
 		   const bfs::path& dest_dir, bool overwrite);
  
+  /// create dest_path as a copy of the regular file src_path, sharing
+  /// storage copy-on-write with a reflink where supported, before
+  /// falling back to copying contents
+  static void clone_file(const bfs::path& src_path,
+			 const bfs::path& dest_path);
+
   /// Recrusive copy of src_path into dest_dir, with optional
   /// top-level overwrite (remove/recreate) of
   /// dest_dir/src_path.filename()
@@ -278,6 +293,18 @@ private:
   /// Tokenizes $PATH environment variable into a "list" of directories
   static std::vector<std::string> tokenize_env_path(const std::string& path);
 
+  /// create the directory structure and symlinks of a recursive copy
+  /// of src_path into dest_dir, appending the regular files to clone
+  /// as (source, destination) pairs
+  static void plan_copy(const bfs::path& src_path, const bfs::path& dest_dir,
+			bool overwrite,
+			std::vector<std::pair<bfs::path, bfs::path> >& files);
+
+  /// clone the planned (source, destination) files, concurrently when
+  /// there are many
+  static void clone_files(
+    const std::vector<std::pair<bfs::path, bfs::path> >& files);
+
   //
   //- Heading: Data
   //
@@ -15,6 +15,13 @@
 #include <boost/tokenizer.hpp>
 #include <boost/filesystem/operations.hpp>
 #include "boost/filesystem/path.hpp"
+#include <algorithm>
+#include <locale>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
 
 namespace Dakota {
 
@@ -249,4 +256,59 @@ read_covariance(const std::string& basename, int expt_num,
   copy_data(va, cov_vals);
 }
 
+//
+//- Utilities for writing tabular data
+//
+
+//----------------------------------------------------------------
+
+/** Equivalent to inserting each value through the stream with width
+    write_precision+4 and the stream's (general format) precision, but
+    formats into a local buffer using std::to_chars where available
+    (else snprintf), which is considerably faster for large tables.
+    Streams with other formatting state use the per-value insertion. */
+void write_tabular_values(std::ostream& s, const Real* values,
+			  size_t num_items)
+{
+  const std::ios::fmtflags custom_flags = std::ios::floatfield |
+    std::ios::adjustfield | std::ios::showpos | std::ios::showpoint |
+    std::ios::uppercase;
+  int width = write_precision + 4, precision = (int)s.precision();
+  // widest general format field: sign, precision digits, point, exponent
+  size_t max_field = std::max(width, precision + 8) + 1;
+  char buffer[4096];
+  if ((s.flags() & custom_flags) || s.fill() != s.widen(' ') ||
+      s.getloc() != std::locale::classic() || precision < 0 ||
+      max_field > sizeof(buffer)) {
+    for (size_t i=0; i<num_items; ++i)
+      s << std::setw(width) << values[i] << ' ';
+    return;
+  }
+
+  size_t len = 0;
+#ifdef __cpp_lib_to_chars
+  char field[sizeof(buffer)];
+#endif
+  for (size_t i=0; i<num_items; ++i) {
+    if (len + max_field > sizeof(buffer))
+      { s.write(buffer, len); len = 0; }
+#ifdef __cpp_lib_to_chars
+    std::to_chars_result result = std::to_chars(field, field + max_field,
+      values[i], std::chars_format::general, precision);
+    size_t field_len = result.ptr - field;
+    if (field_len < (size_t)width) {
+      std::memset(buffer + len, ' ', width - field_len);
+      len += width - field_len;
+    }
+    std::memcpy(buffer + len, field, field_len);
+    len += field_len;
+#else
+    len += std::snprintf(buffer + len, max_field, "%*.*g", width, precision,
+			 values[i]);
+#endif
+    buffer[len++] = ' ';
+  }
+  s.write(buffer, len);
+}
+
 } // namespace Dakota
@@ -988,16 +988,31 @@ inline void write_data_annotated(std::ostream& s, const StringMultiArray& v,
 }
 
 
+/// tabular ostream insertion of num_items values, each right-justified
+/// in write_precision+4 characters and followed by a space
+template <typename ScalarType>
+void write_tabular_values(std::ostream& s, const ScalarType* values,
+			  size_t num_items)
+{
+  for (size_t i=0; i<num_items; ++i)
+    s << std::setw(write_precision+4) << values[i] << ' ';
+}
+
+
+/// tabular ostream insertion of num_items Reals, formatted into a
+/// local buffer rather than inserted one at a time
+void write_tabular_values(std::ostream& s, const Real* values,
+			  size_t num_items);
+
+
 /// tabular ostream insertion operator for full SerialDenseVector
 template <typename OrdinalType, typename ScalarType>
 void write_data_tabular(std::ostream& s,
   const Teuchos::SerialDenseVector<OrdinalType, ScalarType>& v)
 {
-  OrdinalType i, len = v.length();
   s << std::setprecision(write_precision) 
     << std::resetiosflags(std::ios::floatfield);
-  for (i=0; i<len; ++i)
-    s << std::setw(write_precision+4) << v[i] << ' ';
+  write_tabular_values(s, v.values(), v.length());
 }
 
 
@@ -1008,8 +1023,7 @@ void write_data_tabular(std::ostream& s, const ScalarType* ptr,
 {
   s << std::setprecision(write_precision) 
     << std::resetiosflags(std::ios::floatfield);
-  for (OrdinalType i=0; i<num_items; ++i)
-    s << std::setw(write_precision+4) << ptr[i] << ' ';
+  write_tabular_values(s, ptr, num_items);
 }
 
 
@@ -1027,8 +1041,7 @@ void write_data_partial_tabular(std::ostream& s,
   }
   s << std::setprecision(write_precision) 
     << std::resetiosflags(std::ios::floatfield);
-  for (OrdinalType2 i=start_index; i<end; ++i)
-    s << std::setw(write_precision+4) << v[i] << ' ';
+  write_tabular_values(s, v.values() + start_index, num_items);
 }
 
 
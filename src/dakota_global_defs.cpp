@@ -103,6 +103,7 @@ void abort_handler(int code)
   // Clean up
   Cout << std::flush; // flush cout or ofstream redirection
   Cerr << std::flush; // flush cerr or ofstream redirection
+  evaluation_store_db.flush(); // write buffered evaluations
   iterator_results_db.close(); // flush output files/databases 
 
   if (Dak_pddb) {
@@ -9,13 +9,17 @@
 
 // Statistics-related utilities
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <utility>
 
 #include "dakota_stat_util.hpp"
 #ifdef HAVE_DAKOTA_SURROGATES
 #include "SurrogatesPolynomialRegression.hpp"
 #endif
 #include "util_metrics.hpp"
+#include "util_threads.hpp"
 
 using MatrixMap = Eigen::Map<Eigen::MatrixXd>;
 using VectorMap = Eigen::Map<Eigen::VectorXd>;
@@ -37,6 +41,358 @@ int generate_system_seed()
   return seed;
 }
 
+
+//----------------------------------------------------------------
+
+void MomentAccumulator::push(Real sample)
+{
+  if (!std::isfinite(sample)) // neither NaN nor +/-Inf
+    { ++numOmitted; return; }
+
+  Real nm1 = (Real)numSamples, ns = (Real)(++numSamples),
+    delta = sample - meanValue, delta_n = delta / ns,
+    delta_n_sq = delta_n * delta_n, term1 = delta * delta_n * nm1;
+  meanValue += delta_n;
+  sumCM4 += term1 * delta_n_sq * (ns * ns - 3. * ns + 3.)
+    + 6. * delta_n_sq * sumCM2 - 4. * delta_n * sumCM3;
+  sumCM3 += term1 * delta_n * (ns - 2.) - 3. * delta_n * sumCM2;
+  sumCM2 += term1;
+
+  if (sample < minValue) minValue = sample;
+  if (sample > maxValue) maxValue = sample;
+}
+
+
+/** Pairwise combination of Pebay (SAND2008-6212), Eqs. 3.1 and 3.2. */
+void MomentAccumulator::merge(const MomentAccumulator& other)
+{
+  numOmitted += other.numOmitted;
+  if (!other.numSamples)
+    return;
+  if (!numSamples) {
+    size_t num_omitted = numOmitted;
+    *this = other; numOmitted = num_omitted;
+    return;
+  }
+
+  Real na = (Real)numSamples, nb = (Real)other.numSamples, ns = na + nb,
+    delta = other.meanValue - meanValue, delta_sq = delta * delta,
+    nab = na * nb;
+  Real cm4 = sumCM4 + other.sumCM4
+    + delta_sq * delta_sq * nab * (na * na - nab + nb * nb) / (ns * ns * ns)
+    + 6. * delta_sq * (na * na * other.sumCM2 + nb * nb * sumCM2) / (ns * ns)
+    + 4. * delta * (na * other.sumCM3 - nb * sumCM3) / ns;
+  Real cm3 = sumCM3 + other.sumCM3
+    + delta_sq * delta * nab * (na - nb) / (ns * ns)
+    + 3. * delta * (na * other.sumCM2 - nb * sumCM2) / ns;
+  sumCM2 += other.sumCM2 + delta_sq * nab / ns;
+  sumCM3  = cm3;
+  sumCM4  = cm4;
+  meanValue += delta * nb / ns;
+  numSamples += other.numSamples;
+
+  if (other.minValue < minValue) minValue = other.minValue;
+  if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+
+void MomentAccumulator::moments(bool central, Real* moments) const
+{
+  if (!numSamples) {
+    for (size_t i=0; i<4; ++i)
+      moments[i] = std::numeric_limits<Real>::quiet_NaN();
+    return;
+  }
+
+  // biased central moment estimators
+  Real ns = (Real)numSamples, nm1 = ns - 1., nm2 = ns - 2., nm3 = ns - 3.,
+    cm2 = sumCM2 / ns, cm3 = sumCM3 / ns, cm4 = sumCM4 / ns;
+
+  moments[0] = meanValue;
+  if (central) { // unbiased central moments
+    moments[1] = cm2 * ns / nm1;
+    moments[2] = cm3 * ns * ns / (nm1 * nm2);
+    moments[3] = ( ns * (ns * ns - 2. * ns + 3.) * cm4
+		   - 3. * ns * (2. * ns - 3.) * cm2 * cm2 ) / (nm1 * nm2 * nm3);
+  }
+  else { // standardized moments (excess kurtosis)
+    moments[1] = std::sqrt(cm2 * ns / nm1);
+    moments[2] = cm3 / std::pow(cm2, 1.5) * std::sqrt(ns * nm1) / nm2;
+    moments[3] = nm1 / (nm2 * nm3) * ((ns + 1.) * cm4 / (cm2 * cm2) - 3.*nm1);
+  }
+}
+
+//----------------------------------------------------------------
+
+QuantileSketch::QuantileSketch(Real compression):
+  compressionParam(compression), numSamples(0), minValue(DBL_MAX),
+  maxValue(-DBL_MAX)
+{ }
+
+
+void QuantileSketch::push(Real sample)
+{
+  pendingSamples.push_back(sample);
+  ++numSamples;
+  if (sample < minValue) minValue = sample;
+  if (sample > maxValue) maxValue = sample;
+  // amortize the sort within compress() over many samples
+  if (pendingSamples.size() >= 10 * (size_t)compressionParam)
+    compress();
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+  if (!other.numSamples)
+    return;
+  centroidMeans.insert(centroidMeans.end(), other.centroidMeans.begin(),
+		       other.centroidMeans.end());
+  centroidWeights.insert(centroidWeights.end(), other.centroidWeights.begin(),
+			 other.centroidWeights.end());
+  pendingSamples.insert(pendingSamples.end(), other.pendingSamples.begin(),
+			other.pendingSamples.end());
+  numSamples += other.numSamples;
+  if (other.minValue < minValue) minValue = other.minValue;
+  if (other.maxValue > maxValue) maxValue = other.maxValue;
+  compress();
+}
+
+
+void QuantileSketch::compress()
+{
+  size_t i, num_cent = centroidMeans.size(), num_pend = pendingSamples.size();
+  if (!num_pend && std::is_sorted(centroidMeans.begin(), centroidMeans.end()))
+    return;
+
+  std::vector<std::pair<Real, Real> > points;
+  points.reserve(num_cent + num_pend);
+  for (i=0; i<num_cent; ++i)
+    points.push_back(std::make_pair(centroidMeans[i], centroidWeights[i]));
+  for (i=0; i<num_pend; ++i)
+    points.push_back(std::make_pair(pendingSamples[i], 1.));
+  pendingSamples.clear();
+  std::sort(points.begin(), points.end());
+
+  size_t num_pts = points.size();
+  centroidMeans.clear();  centroidMeans.reserve(num_pts);
+  centroidWeights.clear(); centroidWeights.reserve(num_pts);
+
+  // retain every sample until the first buffer is full, so that small
+  // sample sets are summarized exactly
+  if (numSamples < 10 * (size_t)compressionParam) {
+    for (i=0; i<num_pts; ++i) {
+      centroidMeans.push_back(points[i].first);
+      centroidWeights.push_back(points[i].second);
+    }
+    return;
+  }
+
+  // k_1 scale function k(q) = delta/(2 pi) asin(2q - 1): a centroid may
+  // span at most a unit increment in k
+  Real total = (Real)numSamples, two_pi = 2. * std::acos(-1.),
+    k_max = compressionParam / 4.;
+  auto q_limit = [&](Real q) {
+    Real k = compressionParam / two_pi * std::asin(2. * q - 1.) + 1.;
+    return (k >= k_max) ? 1. :
+      (std::sin(two_pi * k / compressionParam) + 1.) / 2.;
+  };
+  Real cum_wt = 0., limit = q_limit(0.),
+    cent_mean = points[0].first, cent_wt = points[0].second;
+  for (i=1; i<num_pts; ++i) {
+    Real pt_wt = points[i].second, new_wt = cent_wt + pt_wt;
+    if ((cum_wt + new_wt) / total <= limit) {
+      cent_mean += (points[i].first - cent_mean) * pt_wt / new_wt;
+      cent_wt = new_wt;
+    }
+    else {
+      centroidMeans.push_back(cent_mean); centroidWeights.push_back(cent_wt);
+      cum_wt += cent_wt;
+      limit = q_limit(cum_wt / total);
+      cent_mean = points[i].first; cent_wt = pt_wt;
+    }
+  }
+  centroidMeans.push_back(cent_mean); centroidWeights.push_back(cent_wt);
+}
+
+
+Real QuantileSketch::value_at_rank(Real rank)
+{
+  compress();
+  size_t i, num_cent = centroidMeans.size();
+  if (!num_cent)
+    return std::numeric_limits<Real>::quiet_NaN();
+
+  // interpolation knots: (sorted position, value) of each centroid,
+  // anchored by the extreme samples when the end centroids are merged
+  RealArray positions, values;
+  positions.reserve(num_cent + 2); values.reserve(num_cent + 2);
+  if (centroidWeights[0] > 1.)
+    { positions.push_back(0.); values.push_back(minValue); }
+  Real cum_wt = 0.;
+  for (i=0; i<num_cent; ++i) {
+    positions.push_back(cum_wt + (centroidWeights[i] - 1.) / 2.);
+    values.push_back(centroidMeans[i]);
+    cum_wt += centroidWeights[i];
+  }
+  if (centroidWeights[num_cent-1] > 1.)
+    { positions.push_back(cum_wt - 1.); values.push_back(maxValue); }
+
+  size_t num_knots = positions.size();
+  if (num_knots == 1 || rank >= positions[num_knots-1])
+    return values[num_knots-1];
+  // first knot beyond rank (extrapolate left of the first knot)
+  size_t hi = std::upper_bound(positions.begin(), positions.end(), rank)
+    - positions.begin();
+  if (hi == 0) hi = 1;
+  size_t lo = hi - 1;
+  return values[lo] + (rank - positions[lo]) * (values[hi] - values[lo])
+    / (positions[hi] - positions[lo]);
+}
+
+//----------------------------------------------------------------
+
+void CovarianceAccumulator::initialize(size_t num_factors)
+{
+  numSamples = 0;
+  factorMeans.size(num_factors);                      // init to 0
+  factorComoments.shape(num_factors, num_factors);    // init to 0
+}
+
+
+void CovarianceAccumulator::push(const RealMatrix& samples)
+{
+  int i, j, num_factors = factorMeans.length(), num_block = samples.numCols();
+  if (!num_block)
+    return;
+
+  RealVector block_means(num_factors);
+  for (j=0; j<num_block; ++j)
+    for (i=0; i<num_factors; ++i)
+      block_means[i] += samples(i,j);
+  block_means.scale(1. / (Real)num_block);
+
+  RealMatrix centered(samples);
+  for (j=0; j<num_block; ++j)
+    for (i=0; i<num_factors; ++i)
+      centered(i,j) -= block_means[i];
+  RealMatrix block_comoments(num_factors, num_factors, false);
+  block_comoments.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1., centered,
+			   centered, 0.);
+
+  merge(num_block, block_means, block_comoments);
+}
+
+
+void CovarianceAccumulator::merge(const CovarianceAccumulator& other)
+{
+  if (other.numSamples)
+    merge(other.numSamples, other.factorMeans, other.factorComoments);
+}
+
+
+/** Chan, Golub, and LeVeque (1979) pairwise update. */
+void CovarianceAccumulator::
+merge(size_t num_block, const RealVector& block_means,
+      const RealMatrix& block_comoments)
+{
+  int i, j, num_factors = factorMeans.length();
+  if (!numSamples) {
+    numSamples = num_block;
+    factorMeans.assign(block_means);
+    factorComoments.assign(block_comoments);
+    return;
+  }
+
+  Real na = (Real)numSamples, nb = (Real)num_block, ns = na + nb,
+    scale = na * nb / ns;
+  RealVector delta(block_means);
+  delta -= factorMeans;
+  for (j=0; j<num_factors; ++j)
+    for (i=0; i<num_factors; ++i)
+      factorComoments(i,j) += block_comoments(i,j) + scale * delta[i]*delta[j];
+  for (i=0; i<num_factors; ++i)
+    factorMeans[i] += delta[i] * nb / ns;
+  numSamples += num_block;
+}
+
+
+//----------------------------------------------------------------
+
+/// (value, original index) pairs, contiguous so the sort does not
+/// chase indices back into the (possibly strided) source data
+typedef std::vector<std::pair<Real, size_t> > ValueIndexArray;
+
+/** Sorting the pairs lexicographically orders tied values by index, so
+    the result does not depend on the sort implementation. */
+static void sort_values(const Real* values, size_t num_values, size_t stride,
+			ValueIndexArray& sorted)
+{
+  sorted.resize(num_values);
+  for (size_t j=0; j<num_values; ++j)
+    sorted[j] = std::make_pair(values[j*stride], j);
+  std::sort(sorted.begin(), sorted.end());
+}
+
+
+static void sorted_to_average_ranks(const ValueIndexArray& sorted, Real* ranks,
+				    size_t stride)
+{
+  size_t num_values = sorted.size();
+  for (size_t rank=0; rank<num_values; ) {
+    // find the range of values tied with the current one
+    size_t num_ties = 1;
+    while (rank + num_ties < num_values &&
+	   sorted[rank + num_ties].first == sorted[rank].first)
+      ++num_ties;
+    // all tied values get assigned the average rank
+    Real avg_rank = (rank + rank+num_ties-1) / 2.0;
+    for (size_t k=rank; k<rank+num_ties; ++k)
+      ranks[sorted[k].second*stride] = avg_rank;
+    rank += num_ties;
+  }
+}
+
+
+void ordinal_ranks(const Real* values, size_t num_values, SizetArray& ranks,
+		   size_t stride)
+{
+  ValueIndexArray sorted;
+  sort_values(values, num_values, stride, sorted);
+  ranks.resize(num_values);
+  for (size_t rank=0; rank<num_values; ++rank)
+    ranks[sorted[rank].second] = rank;
+}
+
+
+/** Rows are independent, so they are distributed round-robin over
+    threads when the matrix is large enough to amortize starting them.
+    Each thread owns its sort workspace and writes only its own rows,
+    so the result is independent of the number of threads. */
+void rows_to_average_ranks(RealMatrix& data)
+{
+  size_t num_rows = data.numRows(), num_cols = data.numCols(),
+    stride = data.stride();
+  if (!num_rows || !num_cols)
+    return;
+
+  // below this many entries per thread, threading costs more than it saves
+  const size_t min_entries_per_thread = 1 << 15;
+  size_t num_threads = dakota::util::num_threads(num_rows,
+    num_rows * num_cols, min_entries_per_thread);
+
+  // allocate the workspaces here so the threads cannot fail
+  std::vector<ValueIndexArray> workspaces(num_threads,
+					  ValueIndexArray(num_cols));
+  Real* data_ptr = data.values();
+  dakota::util::run_threads(num_threads, [&](size_t t) {
+    for (size_t i=t; i<num_rows; i+=num_threads) {
+      sort_values(data_ptr + i, num_cols, stride, workspaces[t]);
+      sorted_to_average_ranks(workspaces[t], data_ptr + i, stride);
+    }
+  });
+}
+
 #ifdef HAVE_DAKOTA_SURROGATES
 //----------------------------------------------------------------
 
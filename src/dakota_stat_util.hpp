@@ -20,6 +20,201 @@ namespace Dakota {
 /// clock microseconds-based random seed in [1, 1000000]
 int generate_system_seed();
 
+
+/// One-pass accumulator of the first four central moments of a scalar
+
+/** Samples are folded in with the Welford/Pebay updates, so the sample
+    set need not be stored, and two accumulators for disjoint sample
+    sets can be merged.  Non-finite samples (failed evaluations) are
+    counted but omitted from the moments and extremes. */
+class MomentAccumulator
+{
+public:
+
+  MomentAccumulator();  ///< constructor
+
+  /// fold a sample into the accumulator
+  void push(Real sample);
+  /// fold the samples of another accumulator into this one
+  void merge(const MomentAccumulator& other);
+
+  /// number of finite samples accumulated
+  size_t count() const;
+  /// number of non-finite samples omitted
+  size_t num_omitted() const;
+  /// minimum finite sample
+  Real min() const;
+  /// maximum finite sample
+  Real max() const;
+
+  /// populate moments[0:3] with the mean and the standard deviation,
+  /// skewness, and excess kurtosis (central = false) or the variance,
+  /// third, and fourth central moments (central = true), using the
+  /// same estimators as Pecos::accumulate_moments()
+  void moments(bool central, Real* moments) const;
+
+private:
+
+  size_t numSamples; ///< number of finite samples
+  size_t numOmitted; ///< number of non-finite samples
+  Real meanValue;    ///< running mean
+  Real sumCM2;       ///< running sum of squared deviations from the mean
+  Real sumCM3;       ///< running sum of cubed deviations from the mean
+  Real sumCM4;       ///< running sum of 4th power deviations from the mean
+  Real minValue;     ///< running minimum
+  Real maxValue;     ///< running maximum
+};
+
+
+inline MomentAccumulator::MomentAccumulator():
+  numSamples(0), numOmitted(0), meanValue(0.), sumCM2(0.), sumCM3(0.),
+  sumCM4(0.), minValue(DBL_MAX), maxValue(-DBL_MAX)
+{ }
+
+
+inline size_t MomentAccumulator::count() const
+{ return numSamples; }
+
+
+inline size_t MomentAccumulator::num_omitted() const
+{ return numOmitted; }
+
+
+inline Real MomentAccumulator::min() const
+{ return minValue; }
+
+
+inline Real MomentAccumulator::max() const
+{ return maxValue; }
+
+
+/// Mergeable streaming summary of a sample distribution for quantile
+/// (inverse CDF) estimation
+
+/** A merging t-digest: samples are buffered and periodically merged
+    into a sorted set of weighted centroids whose sizes are limited by
+    an arcsine scale function, so that centroids near the tails stay
+    small and tail quantiles are resolved more accurately than central
+    ones.  Storage is O(compression), independent of the sample count.
+    While fewer samples than the buffer size have been pushed, the
+    centroids are the samples themselves and value_at_rank() reproduces
+    order statistic interpolation on the full sorted sample. */
+class QuantileSketch
+{
+public:
+
+  /// constructor; larger compression gives more, smaller centroids
+  QuantileSketch(Real compression = 500.);
+
+  /// fold a finite sample into the sketch
+  void push(Real sample);
+  /// fold the samples of another sketch into this one
+  void merge(const QuantileSketch& other);
+
+  /// number of samples summarized
+  size_t count() const;
+
+  /// estimate the sample value at (0-based, fractional) position
+  /// rank within the sorted samples, interpolating linearly between
+  /// neighboring centroids and extrapolating left of the first
+  /// sample using the slope of the first two centroids
+  Real value_at_rank(Real rank);
+
+private:
+
+  /// merge pendingSamples into centroidMeans/centroidWeights
+  void compress();
+
+  /// compression parameter (delta) for the scale function
+  Real compressionParam;
+  /// centroid means, sorted in ascending order
+  RealArray centroidMeans;
+  /// number of samples represented by each centroid
+  RealArray centroidWeights;
+  /// samples not yet merged into the centroids
+  RealArray pendingSamples;
+  /// total number of samples
+  size_t numSamples;
+  /// minimum sample
+  Real minValue;
+  /// maximum sample
+  Real maxValue;
+};
+
+
+inline size_t QuantileSketch::count() const
+{ return numSamples; }
+
+
+/// One-pass accumulator of the sample means and co-moments of a set
+/// of factors
+
+/** Blocks of samples are reduced to their means and centered cross
+    products, which are combined with the running values using the
+    pairwise update of Chan, Golub, and LeVeque.  The co-moment matrix
+    is (num samples - 1) times the sample covariance matrix. */
+class CovarianceAccumulator
+{
+public:
+
+  /// constructor
+  CovarianceAccumulator(size_t num_factors = 0);
+
+  /// reset to num_factors factors and no samples
+  void initialize(size_t num_factors);
+
+  /// fold a block of samples (factors x samples) into the accumulator
+  void push(const RealMatrix& samples);
+  /// fold the samples of another accumulator into this one
+  void merge(const CovarianceAccumulator& other);
+
+  /// number of samples accumulated
+  size_t count() const;
+  /// running factor means
+  const RealVector& means() const;
+  /// running sums of products of deviations from the means
+  const RealMatrix& comoments() const;
+
+private:
+
+  /// combine a block of num_block samples with the running values
+  void merge(size_t num_block, const RealVector& block_means,
+	     const RealMatrix& block_comoments);
+
+  /// number of samples
+  size_t numSamples;
+  /// running means
+  RealVector factorMeans;
+  /// running co-moments
+  RealMatrix factorComoments;
+};
+
+
+inline CovarianceAccumulator::CovarianceAccumulator(size_t num_factors):
+  numSamples(0)
+{ initialize(num_factors); }
+
+
+inline size_t CovarianceAccumulator::count() const
+{ return numSamples; }
+
+
+inline const RealVector& CovarianceAccumulator::means() const
+{ return factorMeans; }
+
+
+inline const RealMatrix& CovarianceAccumulator::comoments() const
+{ return factorComoments; }
+
+/// rank num_values values (read with the given stride) with 0-based
+/// ordinal ranks, ranking tied values in order of appearance
+void ordinal_ranks(const Real* values, size_t num_values, SizetArray& ranks,
+		   size_t stride = 1);
+
+/// replace the values in each row of data with their 0-based ranks,
+/// assigning tied values their average rank, ranking the rows concurrently
+void rows_to_average_ranks(RealMatrix& data);
+
 #ifdef HAVE_DAKOTA_SURROGATES
 /// Compute (non-standardized) linear regression coefficients and return R^2
 void compute_regression_coeffs( const RealMatrix & samples,
@@ -12,6 +12,19 @@
 #include "DakotaVariables.hpp"
 #include "DakotaResponse.hpp"
 #include "ParamResponsePair.hpp"
+#include "MappedFile.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
 
 namespace Dakota {
 
@@ -510,6 +523,316 @@ void print_expected_labels(bool active_only,
 }
 
 
+//
+//- Utilities for the concurrent read of well-formed tabular data
+//
+
+namespace {
+
+/// kinds of whitespace-delimited fields in a tabular row, by the
+/// extraction each emulates
+enum { STREAM_REAL_FIELD,   // std::istream >> Real
+       ATOF_REAL_FIELD,     // std::atof(token)
+       STREAM_INT_FIELD,    // std::istream >> int
+       STREAM_SIZET_FIELD,  // std::istream >> size_t (value discarded)
+       LABEL_FIELD };       // std::istream >> String
+
+/// minimum bytes of row data per thread in a concurrent read
+const size_t min_bytes_per_thread = 1 << 20;
+
+
+/// Fields of consecutive rows of a tabular file
+struct TabularRows
+{
+  /// default constructor
+  TabularRows(): numRows(0) { }
+
+  /// number of rows read
+  size_t numRows;
+  /// numeric fields of each row, row-major
+  RealArray values;
+  /// LABEL_FIELD fields of each row, row-major
+  StringArray labels;
+};
+
+
+/// whether [first, last) has the form of a decimal floating point
+/// number, e.g., "-1.5e+3", which stream extraction reads in full
+bool is_decimal_real(const char* first, const char* last)
+{
+  const char* p = first;
+  if (p != last && (*p == '+' || *p == '-')) ++p;
+  const char* digits = p;
+  while (p != last && std::isdigit((unsigned char)*p)) ++p;
+  size_t num_digits = p - digits;
+  if (p != last && *p == '.') {
+    digits = ++p;
+    while (p != last && std::isdigit((unsigned char)*p)) ++p;
+    num_digits += p - digits;
+  }
+  if (num_digits == 0)
+    return false;
+  if (p != last && (*p == 'e' || *p == 'E')) {
+    ++p;
+    if (p != last && (*p == '+' || *p == '-')) ++p;
+    digits = p;
+    while (p != last && std::isdigit((unsigned char)*p)) ++p;
+    if (p == digits)
+      return false;
+  }
+  return p == last;
+}
+
+
+/// the value of [first, last) as given by std::atof, using the faster
+/// std::from_chars where available and it consumes the whole token
+Real atof_value(const char* first, const char* last)
+{
+#ifdef __cpp_lib_to_chars
+  // from_chars accepts a leading minus, but not a plus
+  const char* p = (last - first > 1 && *first == '+' && first[1] != '-') ?
+    first + 1 : first;
+  Real value;
+  std::from_chars_result result = std::from_chars(p, last, value);
+  if (result.ec == std::errc() && result.ptr == last)
+    return value;
+#endif
+  // atof requires a terminated copy of the token
+  char token[64];
+  size_t len = last - first;
+  if (len >= sizeof(token))
+    return std::atof(std::string(first, last).c_str());
+  std::memcpy(token, first, len);
+  token[len] = '\0';
+  return std::atof(token);
+}
+
+
+/// parse [first, last) as an integer of the form [+-]digits (digits
+/// only if !is_signed) with magnitude at most max_value
+bool parse_integer(const char* first, const char* last, bool is_signed,
+		   unsigned long long max_value, Real& value)
+{
+  bool negative = false;
+  if (first != last && (*first == '+' || (is_signed && *first == '-')))
+    negative = (*first++ == '-');
+  if (first == last)
+    return false;
+  unsigned long long magnitude = 0;
+  for (; first != last; ++first) {
+    if (!std::isdigit((unsigned char)*first))
+      return false;
+    unsigned long long digit = *first - '0';
+    if (magnitude > (max_value - digit) / 10)
+      return false;
+    magnitude = 10 * magnitude + digit;
+  }
+  value = (negative) ? -(Real)magnitude : (Real)magnitude;
+  return true;
+}
+
+
+/** Parse the rows (lines) in [first, last), each of which must consist
+    of fields of field_kinds separated by spaces or tabs, skipping blank
+    lines.  Returns false if any row is of another form, or contains a
+    value the corresponding stream extraction would not read in full,
+    in which case the caller reverts to the stream-based read. */
+bool parse_rows(const char* first, const char* last,
+		const std::vector<short>& field_kinds, TabularRows& rows)
+{
+  size_t num_fields = field_kinds.size();
+  Real value;
+  while (first < last) {
+    const char* line_end =
+      static_cast<const char*>(std::memchr(first, '\n', last - first));
+    if (!line_end) line_end = last;
+    // as for strsplit(), trim leading and trailing whitespace
+    const char *p = first, *end = line_end;
+    first = (line_end < last) ? line_end + 1 : last;
+    while (p < end && std::isspace((unsigned char)*p)) ++p;
+    while (end > p && std::isspace((unsigned char)end[-1])) --end;
+    if (p == end)
+      continue; // blank line
+
+    for (size_t f=0; f<num_fields; ++f) {
+      if (p == end)
+	return false; // too few fields
+      const char* token = p;
+      while (p < end && !std::isspace((unsigned char)*p)) ++p;
+      switch (field_kinds[f]) {
+      case STREAM_REAL_FIELD:
+	if (!is_decimal_real(token, p))
+	  return false;
+	value = atof_value(token, p);
+	if (!std::isfinite(value))
+	  return false; // overflow fails stream extraction
+	rows.values.push_back(value);
+	break;
+      case ATOF_REAL_FIELD:
+	rows.values.push_back(atof_value(token, p));
+	break;
+      case STREAM_INT_FIELD:
+	if (!parse_integer(token, p, true, INT_MAX, value) ||
+	    value < (Real)INT_MIN)
+	  return false;
+	rows.values.push_back(value);
+	break;
+      case STREAM_SIZET_FIELD:
+	if (!parse_integer(token, p, false, SIZE_MAX, value))
+	  return false;
+	break;
+      case LABEL_FIELD:
+	rows.labels.push_back(String(token, p));
+	break;
+      }
+      // strsplit() separates fields only by spaces and tabs
+      while (p < end && (*p == ' ' || *p == '\t')) ++p;
+      if (p < end && std::isspace((unsigned char)*p))
+	return false;
+    }
+    if (p != end)
+      return false; // too many fields
+    ++rows.numRows;
+  }
+  return true;
+}
+
+
+/** Read the rows of the named file following byte offset data_start
+    (e.g., following its header), concurrently over newline-aligned
+    blocks of the file for large files.  The rows of blocks[b] precede
+    those of blocks[b+1].  Returns false if any row is not well formed
+    per parse_rows(), or the file cannot be mapped. */
+bool read_rows(const std::string& input_filename, std::streamoff data_start,
+	       const std::vector<short>& field_kinds,
+	       std::vector<TabularRows>& blocks)
+{
+  blocks.clear();
+  MappedFile tabular_file(input_filename);
+  if (!tabular_file.data() || data_start < 0 ||
+      (size_t)data_start > tabular_file.size())
+    return false;
+  const char *begin = tabular_file.data() + data_start,
+    *end = tabular_file.data() + tabular_file.size();
+
+  size_t num_bytes = end - begin, num_threads
+    = dakota::util::num_threads(num_bytes, num_bytes, min_bytes_per_thread);
+  blocks.resize(num_threads);
+  if (num_threads == 1)
+    return parse_rows(begin, end, field_kinds, blocks[0]);
+
+  // split into blocks at line boundaries
+  std::vector<const char*> bounds(num_threads + 1, end);
+  bounds[0] = begin;
+  for (size_t t=1; t<num_threads; ++t) {
+    const char* split
+      = std::max(bounds[t-1], begin + t * (num_bytes / num_threads));
+    const char* line_end =
+      static_cast<const char*>(std::memchr(split, '\n', end - split));
+    bounds[t] = (line_end) ? line_end + 1 : end;
+  }
+
+  std::vector<char> parsed(num_threads, 0);
+  dakota::util::run_threads(num_threads, [&](size_t t) {
+    try {
+      parsed[t] = parse_rows(bounds[t], bounds[t+1], field_kinds, blocks[t]);
+    }
+    catch (...) { parsed[t] = false; } // e.g., bad_alloc; use stream read
+  });
+  return std::find(parsed.begin(), parsed.end(), 0) == parsed.end();
+}
+
+
+/// total number of rows over the blocks
+size_t total_rows(const std::vector<TabularRows>& blocks)
+{
+  size_t num_rows = 0;
+  for (const TabularRows& block : blocks)
+    num_rows += block.numRows;
+  return num_rows;
+}
+
+
+/// append the kinds of the leading (eval and interface ID) fields
+void leading_field_kinds(unsigned short tabular_format,
+			 std::vector<short>& field_kinds)
+{
+  if (tabular_format & TABULAR_EVAL_ID)
+    field_kinds.push_back(STREAM_INT_FIELD);
+  if (tabular_format & TABULAR_IFACE_ID)
+    field_kinds.push_back(LABEL_FIELD);
+}
+
+
+/** Determine where Variables::read_tabular() stores each variable
+    field of a row (after any reordering by var_inds) by reading the
+    field positions into a copy of vars.  Appends the field kinds and
+    returns, for the active (active_positions) or all continuous,
+    discrete integer, and discrete real variables, the position of its
+    field among the variable fields.  Returns false if string variables
+    are present, which the concurrent read does not support. */
+bool vars_field_positions(const Variables& vars, bool active_only,
+			  const std::vector<size_t>& var_inds,
+			  bool active_positions,
+			  std::vector<short>& field_kinds, SizetArray& c_pos,
+			  SizetArray& di_pos, SizetArray& dr_pos)
+{
+  if ( (active_only && vars.dsv()) || (!active_only && vars.adsv()) )
+    return false;
+  size_t i, num_vars = active_only ? vars.total_active() : vars.tv();
+
+  // reorder_row() places file field var_inds[k] at row field k
+  std::ostringstream positions;
+  for (i=0; i<num_vars; ++i)
+    positions << (var_inds.empty() ? i : var_inds[i]) << ' ';
+  std::istringstream positions_iss(positions.str());
+  Variables pos_vars = vars.copy();
+  pos_vars.read_tabular(positions_iss, (active_only ? ACTIVE_VARS : ALL_VARS));
+
+  // kinds of the fields read
+  const RealVector& c_vars  = active_only ? pos_vars.continuous_variables()
+    : pos_vars.all_continuous_variables();
+  const IntVector&  di_vars = active_only ? pos_vars.discrete_int_variables()
+    : pos_vars.all_discrete_int_variables();
+  const RealVector& dr_vars = active_only ? pos_vars.discrete_real_variables()
+    : pos_vars.all_discrete_real_variables();
+  size_t num_cv = c_vars.length(), num_div = di_vars.length(),
+    num_drv = dr_vars.length();
+  if (num_cv + num_div + num_drv != num_vars)
+    return false;
+  std::vector<short> vars_kinds(num_vars, -1);
+  for (i=0; i<num_cv; ++i)
+    vars_kinds[(size_t)c_vars[i]] = STREAM_REAL_FIELD;
+  for (i=0; i<num_div; ++i)
+    vars_kinds[(size_t)di_vars[i]] = STREAM_INT_FIELD;
+  for (i=0; i<num_drv; ++i)
+    vars_kinds[(size_t)dr_vars[i]] = STREAM_REAL_FIELD;
+  if (std::find(vars_kinds.begin(), vars_kinds.end(), -1) != vars_kinds.end())
+    return false;
+  field_kinds.insert(field_kinds.end(), vars_kinds.begin(), vars_kinds.end());
+
+  // positions of the requested variables
+  const RealVector& c_dest  = active_positions ?
+    pos_vars.continuous_variables() : c_vars;
+  const IntVector&  di_dest = active_positions ?
+    pos_vars.discrete_int_variables() : di_vars;
+  const RealVector& dr_dest = active_positions ?
+    pos_vars.discrete_real_variables() : dr_vars;
+  c_pos.resize(c_dest.length());
+  for (i=0; i<c_pos.size(); ++i)
+    c_pos[i] = (size_t)c_dest[i];
+  di_pos.resize(di_dest.length());
+  for (i=0; i<di_pos.size(); ++i)
+    di_pos[i] = (size_t)di_dest[i];
+  dr_pos.resize(dr_dest.length());
+  for (i=0; i<dr_pos.size(); ++i)
+    dr_pos[i] = (size_t)dr_dest[i];
+  return true;
+}
+
+} // anonymous namespace
+
+
 // NOTE: Passing all these args around begs for a class to
 // encapsulate, BMA TODO: refactor procedural code
 std::vector<size_t>
@@ -682,6 +1005,40 @@ void read_data_tabular(const std::string& input_filename,
     size_t num_vars = active_only ? vars.total_active() : vars.tv();
     size_t num_cols = num_lead + num_vars + num_fns;;
 
+    // well-formed files are parsed concurrently from a memory map
+    std::vector<short> field_kinds;
+    leading_field_kinds(tabular_format, field_kinds);
+    SizetArray c_pos, di_pos, dr_pos;
+    std::vector<TabularRows> blocks;
+    if (vars_field_positions(vars, active_only, var_inds, active_only,
+			     field_kinds, c_pos, di_pos, dr_pos)) {
+      field_kinds.insert(field_kinds.end(), num_fns, STREAM_REAL_FIELD);
+      if (read_rows(input_filename, input_stream.tellg(), field_kinds,
+		    blocks)) {
+	size_t i, row = 0, num_rows = total_rows(blocks), num_cv = c_pos.size(),
+	  num_div = di_pos.size(), num_drv = dr_pos.size(),
+	  num_lead_values = (tabular_format & TABULAR_EVAL_ID) ? 1 : 0,
+	  num_values = num_lead_values + num_vars + num_fns;
+	vars_matrix.shape(num_rows, (num_rows) ? num_vars : 0);
+	resp_matrix.shape(num_rows, (num_rows) ? num_fns  : 0);
+	for (const TabularRows& block : blocks)
+	  for (size_t r=0; r<block.numRows; ++r, ++row) {
+	    const Real* vals
+	      = block.values.data() + r*num_values + num_lead_values;
+	    for (i=0; i<num_cv; ++i)
+	      vars_matrix(row, i) = vals[c_pos[i]];
+	    for (i=0; i<num_div; ++i)
+	      vars_matrix(row, num_cv + i) = vals[di_pos[i]];
+	    for (i=0; i<num_drv; ++i)
+	      vars_matrix(row, num_cv + num_div + i) = vals[dr_pos[i]];
+	    for (i=0; i<num_fns; ++i)
+	      resp_matrix(row, i) = vals[num_vars + i];
+	  }
+	close_file(input_stream, input_filename, context_message);
+	return;
+      }
+    }
+
     input_stream >> std::ws;
     while (input_stream.good() && !input_stream.eof()) {
 
@@ -875,6 +1232,64 @@ void read_data_tabular(const std::string& input_filename,
   if (tabular_format & TABULAR_IFACE_ID) ++num_lead;
   size_t num_vars = active_only ? vars.total_active() : vars.tv();
   size_t num_cols = num_lead + num_vars + resp.num_functions();;
+
+  // well-formed files are parsed concurrently from a memory map
+  std::vector<short> field_kinds;
+  leading_field_kinds(tabular_format, field_kinds);
+  SizetArray c_pos, di_pos, dr_pos;
+  std::vector<TabularRows> blocks;
+  if (vars_field_positions(vars, active_only, var_inds, active_only,
+			   field_kinds, c_pos, di_pos, dr_pos)) {
+    size_t i, num_fns = resp.num_functions();
+    field_kinds.insert(field_kinds.end(), num_fns, ATOF_REAL_FIELD);
+    if (read_rows(input_filename, data_stream.tellg(), field_kinds, blocks)) {
+      size_t num_lead_values = (tabular_format & TABULAR_EVAL_ID) ? 1 : 0,
+	num_values = num_lead_values + num_vars + num_fns;
+      iface_id = "NO_ID";
+      for (const TabularRows& block : blocks)
+	for (size_t r=0; r<block.numRows; ++r) {
+	  const Real* vals = block.values.data() + r*num_values;
+	  if (tabular_format & TABULAR_EVAL_ID)
+	    eval_id = (int)*vals++;
+	  else
+	    ++eval_id;
+	  if (tabular_format & TABULAR_IFACE_ID) {
+	    iface_id = block.labels[r];
+	    // (Dakota 6.1 used EMPTY for missing ID)
+	    if (iface_id == "EMPTY")
+	      iface_id = "NO_ID";
+	  }
+	  if (active_only) {
+	    for (i=0; i<c_pos.size(); ++i)
+	      vars.continuous_variable(vals[c_pos[i]], i);
+	    for (i=0; i<di_pos.size(); ++i)
+	      vars.discrete_int_variable((int)vals[di_pos[i]], i);
+	    for (i=0; i<dr_pos.size(); ++i)
+	      vars.discrete_real_variable(vals[dr_pos[i]], i);
+	  }
+	  else {
+	    for (i=0; i<c_pos.size(); ++i)
+	      vars.all_continuous_variable(vals[c_pos[i]], i);
+	    for (i=0; i<di_pos.size(); ++i)
+	      vars.all_discrete_int_variable((int)vals[di_pos[i]], i);
+	    for (i=0; i<dr_pos.size(); ++i)
+	      vars.all_discrete_real_variable(vals[dr_pos[i]], i);
+	  }
+	  for (i=0; i<num_fns; ++i)
+	    resp.function_value(vals[num_vars + i], i);
+	  if (verbose) {
+	    Cout << "Variables read:\n" << vars;
+	    if (!iface_id.empty())
+	      Cout << "\nInterface identifier = " << iface_id << '\n';
+	    Cout << "\nResponse read:\n" << resp;
+	  }
+	  input_prp.push_back(ParamResponsePair(vars, iface_id, resp, eval_id));
+	}
+      close_file(data_stream, input_filename, context_message);
+      return;
+    }
+  }
+
   // shouldn't need both good and eof checks
   data_stream >> std::ws;
   while (data_stream.good() && !data_stream.eof()) {
@@ -952,6 +1367,29 @@ void read_data_tabular(const std::string& input_filename,
 
   read_header_tabular(input_stream, tabular_format);
 
+  // well-formed files are parsed concurrently from a memory map
+  std::vector<short> field_kinds;
+  if (tabular_format & TABULAR_EVAL_ID)
+    field_kinds.push_back(STREAM_SIZET_FIELD);
+  field_kinds.insert(field_kinds.end(), num_cols, STREAM_REAL_FIELD);
+  std::vector<TabularRows> blocks;
+  if (read_rows(input_filename, input_stream.tellg(), field_kinds, blocks)) {
+    size_t num_read = total_rows(blocks);
+    if (num_read >= num_rows) {
+      input_matrix.shapeUninitialized(num_rows, num_cols);
+      size_t row = 0;
+      for (const TabularRows& block : blocks)
+	for (size_t r=0; r<block.numRows && row<num_rows; ++r, ++row)
+	  for (size_t col_ind = 0; col_ind < num_cols; ++col_ind)
+	    input_matrix(row, col_ind) = block.values[r*num_cols + col_ind];
+      if (num_read > num_rows)
+	print_unexpected_data(Cout, input_filename, context_message,
+			      tabular_format);
+      close_file(input_stream, input_filename, context_message);
+      return;
+    }
+  }
+
   input_matrix.shapeUninitialized(num_rows, num_cols);	
   for (size_t row_ind = 0; row_ind < num_rows; ++row_ind) {
     try {
@@ -1051,30 +1489,64 @@ size_t read_data_tabular(const std::string& input_filename,
 
     read_header_tabular(input_stream, tabular_format);
 
-    input_stream >> std::ws;  // advance to next readable input
-    while (input_stream.good() && !input_stream.eof()) {
-      // discard the row labels (typically eval and iface ID)
-      read_leading_columns(input_stream, tabular_format);
-
-      // read all or active, but set only the active variables into the lists
-      vars.read_tabular(input_stream, (active_only ? ACTIVE_VARS : ALL_VARS) );
-      ++num_evals;
-
-      // the Variables object vars passed in is a deep copy, but these
-      // accessors return views; force a deep copy of each vector for
-      // storage in array
-      RealVector c_vars(Teuchos::Copy, vars.continuous_variables().values(), 
-			vars.continuous_variables().length());
-      cva.push_back(c_vars);
-      IntVector di_vars(Teuchos::Copy, vars.discrete_int_variables().values(),
-			vars.discrete_int_variables().length());
-      diva.push_back(di_vars);
-      list_dsv_points.push_back(vars.discrete_string_variables());
-      RealVector dr_vars(Teuchos::Copy, vars.discrete_real_variables().values(),
-			 vars.discrete_real_variables().length());
-      drva.push_back(dr_vars);
-
+    // well-formed files are parsed concurrently from a memory map
+    std::vector<short> field_kinds;
+    leading_field_kinds(tabular_format, field_kinds);
+    SizetArray c_pos, di_pos, dr_pos;
+    std::vector<TabularRows> blocks;
+    if (vars_field_positions(vars, active_only, std::vector<size_t>(), true,
+			     field_kinds, c_pos, di_pos, dr_pos) &&
+	read_rows(input_filename, input_stream.tellg(), field_kinds, blocks)) {
+      size_t i, num_lead_values = (tabular_format & TABULAR_EVAL_ID) ? 1 : 0,
+	num_values = num_lead_values +
+	(active_only ? vars.total_active() : num_vars);
+      for (const TabularRows& block : blocks)
+	for (size_t r=0; r<block.numRows; ++r) {
+	  const Real* vals
+	    = block.values.data() + r*num_values + num_lead_values;
+	  RealVector c_vars(c_pos.size(), false);
+	  for (i=0; i<c_pos.size(); ++i)
+	    c_vars[i] = vals[c_pos[i]];
+	  cva.push_back(c_vars);
+	  IntVector di_vars(di_pos.size(), false);
+	  for (i=0; i<di_pos.size(); ++i)
+	    di_vars[i] = (int)vals[di_pos[i]];
+	  diva.push_back(di_vars);
+	  list_dsv_points.push_back(vars.discrete_string_variables());
+	  RealVector dr_vars(dr_pos.size(), false);
+	  for (i=0; i<dr_pos.size(); ++i)
+	    dr_vars[i] = vals[dr_pos[i]];
+	  drva.push_back(dr_vars);
+	  ++num_evals;
+	}
+    }
+    else {
       input_stream >> std::ws;  // advance to next readable input
+      while (input_stream.good() && !input_stream.eof()) {
+	// discard the row labels (typically eval and iface ID)
+	read_leading_columns(input_stream, tabular_format);
+
+	// read all or active, but set only the active variables into the lists
+	vars.read_tabular(input_stream, (active_only ? ACTIVE_VARS : ALL_VARS) );
+	++num_evals;
+
+	// the Variables object vars passed in is a deep copy, but these
+	// accessors return views; force a deep copy of each vector for
+	// storage in array
+	RealVector c_vars(Teuchos::Copy, vars.continuous_variables().values(), 
+			  vars.continuous_variables().length());
+	cva.push_back(c_vars);
+	IntVector di_vars(Teuchos::Copy, vars.discrete_int_variables().values(),
+			  vars.discrete_int_variables().length());
+	diva.push_back(di_vars);
+	list_dsv_points.push_back(vars.discrete_string_variables());
+	RealVector dr_vars(Teuchos::Copy,
+			   vars.discrete_real_variables().values(),
+			   vars.discrete_real_variables().length());
+	drva.push_back(dr_vars);
+
+	input_stream >> std::ws;  // advance to next readable input
+      }
     }
   }
   catch (const std::ios_base::failure& failorbad_except) {
@@ -10,6 +10,7 @@
 #ifndef DAKOTA_INTERFACE_API_H
 #define DAKOTA_INTERFACE_API_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -52,6 +53,84 @@ public:
 };
 
 
+/** Strided, row-major view of a matrix stored elsewhere: element
+    (i, j) is data[i*rowStride + j]. */
+template <typename T>
+class StridedMatrix {
+
+public:
+  T* data = nullptr;
+  size_t numRows = 0;
+  size_t numCols = 0;
+  /// number of elements between the starts of consecutive rows
+  size_t rowStride = 0;
+
+  T& operator()(size_t i, size_t j) const { return data[i*rowStride + j]; }
+  /// pointer to the start of row i
+  T* row(size_t i) const { return data + i*rowStride; }
+
+};
+
+
+/** Variable and function labels shared by all requests in a batch */
+class EvalLabels {
+
+public:
+  std::vector<std::string> continuousLabels;
+  std::vector<std::string> discreteIntLabels;
+  std::vector<std::string> discreteStringLabels;
+  std::vector<std::string> discreteRealLabels;
+  std::vector<std::string> inputOrderedLabels;
+
+};
+
+
+/** A batch of evaluation requests in columnar form: row e of each
+    matrix belongs to evaluation e.  All storage (including the labels)
+    is owned by Dakota and only valid during the evaluate_batch() call. */
+class EvalBatchRequest {
+
+public:
+  StridedMatrix<const double> continuousVars;
+  StridedMatrix<const int> discreteIntVars;
+  StridedMatrix<const std::string> discreteStringVars;
+  StridedMatrix<const double> discreteRealVars;
+
+  /// active set vector of each evaluation (batch size x num functions)
+  StridedMatrix<const short> activeSet;
+  /// 1-based IDs of derivative variables, common to the batch
+  std::vector<size_t> derivativeVars;
+
+  /// labels, common to the batch
+  const EvalLabels* labels = nullptr;
+
+  /// evaluation ID of each evaluation
+  const int* functionEvalIds = nullptr;
+
+  /// number of evaluations in the batch
+  size_t size() const { return activeSet.numRows; }
+
+};
+
+
+/** Output storage for a batch of evaluations, allocated by Dakota.
+    For evaluation e, function i, and derivative variables j, k (with
+    num_derivs = derivativeVars.size()):
+      functions(e, i),
+      gradients(e, i*num_derivs + j),
+      hessians(e, (i*num_derivs + j)*num_derivs + k),
+    where only the lower triangle (k <= j) of each Hessian is read.
+    Only the entries requested by the active set need be assigned. */
+class EvalBatchResponse {
+
+public:
+  StridedMatrix<double> functions;
+  StridedMatrix<double> gradients;
+  StridedMatrix<double> hessians;
+
+};
+
+
 /** API for Dakota plugin Interfaces. Only std c++ allowed as
     specializations must be able to compile without Dakota.
  */
@@ -85,7 +164,10 @@ public:
   std::vector<std::string> function_labels()
     { return std::vector<std::string>(); }
 
-  /// single evaluator
+  /// single evaluator; when the Dakota interface is asynchronous (and
+  /// not batch), this is invoked concurrently from multiple threads if
+  /// the plugin exports dakota_interface_thread_safe() returning true
+  /// (see below), and in turn on one thread otherwise
   virtual EvalResponse evaluate(EvalRequest const& request) = 0;
 
   // DTS: add batch ID as argument or put into request object?
@@ -127,6 +209,39 @@ protected:
 
 };
 
+
+/** Optional thread-safety capability of a Dakota plugin Interface.  A
+    plugin whose DakotaInterfaceAPI::evaluate(EvalRequest const&) may
+    be called concurrently (e.g., it holds no per-evaluation state and
+    does not call into an interpreter lock such as Python's GIL) exports
+      extern "C" bool dakota_interface_thread_safe();
+    returning true.  Only then does Dakota evaluate asynchronous
+    requests on multiple threads. */
+
+
+/** Optional columnar batch API for Dakota plugin Interfaces.  It is
+    kept apart from DakotaInterfaceAPI so that plugins built against
+    that class keep their layout.  A plugin supporting it exports, in
+    addition to dakota_interface_plugin, the factory
+      extern "C" DakotaPlugins::DakotaInterfaceBatchAPI*
+        dakota_interface_batch_plugin();
+    returning its batch evaluator (typically the same object).  Dakota
+    probes for this symbol when loading the plugin; without it, batches
+    are evaluated through DakotaInterfaceAPI::evaluate(requests).
+ */
+class DakotaInterfaceBatchAPI
+{
+
+public:
+
+  virtual ~DakotaInterfaceBatchAPI() {}
+
+  /// columnar batch evaluator, used by Dakota for batch interfaces
+  virtual void evaluate_batch(EvalBatchRequest const& batch,
+                              EvalBatchResponse& responses) = 0;
+
+};
+
 }
 
 #endif
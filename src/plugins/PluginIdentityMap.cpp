@@ -36,6 +36,37 @@ DP::EvalResponse PluginIdentityMap::evaluate(DP::EvalRequest const& request) {
 
 }
 
+void PluginIdentityMap::evaluate_batch(DP::EvalBatchRequest const& batch,
+    DP::EvalBatchResponse& responses) {
+
+  size_t const num_evals = batch.size();
+  size_t const num_fns = batch.activeSet.numCols;
+  auto const& dvv = batch.derivativeVars;
+  size_t const num_derivs = dvv.size();
+
+  for (size_t e = 0; e < num_evals; ++e) {
+    short const* asv = batch.activeSet.row(e);
+    for (size_t i = 0; i < num_fns; ++i) {
+      if (asv[i] & 1) {
+        responses.functions(e, i) = batch.continuousVars(e, i);
+      }
+      if (asv[i] & 2) {
+        double* grad = responses.gradients.row(e) + i*num_derivs;
+        for (size_t j = 0; j < num_derivs; ++j) {
+          grad[j] = (dvv[j] == i + 1) ? 1. : 0.;
+        }
+      }
+      if (asv[i] & 4) {
+        double* hess = responses.hessians.row(e) + i*num_derivs*num_derivs;
+        for (size_t j = 0; j < num_derivs*num_derivs; ++j) {
+          hess[j] = 0.;
+        }
+      }
+    }
+  }
+
+}
+
 void PluginIdentityMap::evaluate_functions(size_t const idx,
     DP::EvalRequest const& request,
     DP::EvalResponse& response) {
@@ -77,3 +108,16 @@ void PluginIdentityMap::evaluate_hessians(size_t const idx,
 
 extern "C" DAKOTA_SYMBOL_EXPORT PluginIdentityMap dakota_interface_plugin;
 PluginIdentityMap dakota_interface_plugin;
+
+// evaluate() holds no state, so asynchronous evaluations may use threads
+extern "C" DAKOTA_SYMBOL_EXPORT bool dakota_interface_thread_safe() {
+  return true;
+}
+
+// without the batch factory, Dakota evaluates batches per request
+#ifndef DAKOTA_PLUGIN_NO_BATCH_API
+extern "C" DAKOTA_SYMBOL_EXPORT DP::DakotaInterfaceBatchAPI*
+dakota_interface_batch_plugin() {
+  return &dakota_interface_plugin;
+}
+#endif
@@ -14,12 +14,17 @@
 
 
 /** Demo plug-in that returns f_i(x) = x_i for all i */
-class PluginIdentityMap: public DakotaPlugins::DakotaInterfaceAPI
+class PluginIdentityMap: public DakotaPlugins::DakotaInterfaceAPI,
+                         public DakotaPlugins::DakotaInterfaceBatchAPI
 {
 public:
   DakotaPlugins::EvalResponse evaluate(
       DakotaPlugins::EvalRequest const& request) override;
 
+  /// columnar batch evaluation, without per-request copies
+  void evaluate_batch(DakotaPlugins::EvalBatchRequest const& batch,
+      DakotaPlugins::EvalBatchResponse& responses) override;
+
 private:
   void evaluate_functions(size_t const idx,
       DakotaPlugins::EvalRequest const& request,
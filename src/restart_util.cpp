@@ -23,6 +23,8 @@
 #include "ParamResponsePair.hpp"
 #include "PRPMultiIndex.hpp"
 #include "RestartVersion.hpp"
+#include "IndexedRestart.hpp"
+#include "DakotaBuildInfo.hpp"
 #ifdef HAVE_PDB_H
 #include <pdb.h>
 #endif
@@ -51,6 +53,8 @@ void read_neutral(StringArray pos_args);
 void repair_restart(StringArray pos_args, String identifier_type);
 /// concatenate multiple restart files
 void concatenate_restart(StringArray pos_args);
+/// convert a restart file to or from the indexed restart format
+void convert_restart(StringArray pos_args, bool to_indexed);
 
 } // namespace Dakota
 
@@ -59,7 +63,8 @@ void concatenate_restart(StringArray pos_args);
 
 /** Parse command line inputs and invoke the appropriate utility
     function (print_restart(), print_restart_tabular(),
-    read_neutral(), repair_restart(), or concatenate_restart()). */
+    read_neutral(), repair_restart(), concatenate_restart(), or
+    convert_restart()). */
 
 int main(int argc, char* argv[])
 {
@@ -170,6 +175,10 @@ int main(int argc, char* argv[])
     repair_restart(pos_args, "by_id");
   else if (util_command == "cat")
     concatenate_restart(pos_args);
+  else if (util_command == "to_indexed")
+    convert_restart(pos_args, true);
+  else if (util_command == "from_indexed")
+    convert_restart(pos_args, false);
   else {
     Cerr << "Error: command '" << util_command << "' not supported." << endl;
     print_usage(Cerr);
@@ -194,7 +203,9 @@ void print_usage(std::ostream& s)
     << "    dakota_restart_util to_tabular <restart_file> <text_file> [--custom_annotated [header] [eval_id] [interface_id]] [--output_precision <int>]\n"
     << "    dakota_restart_util remove <double> <old_restart_file> <new_restart_file>\n"
     << "    dakota_restart_util remove_ids <int_1> ... <int_n> <old_restart_file> <new_restart_file>\n"
-    << "    dakota_restart_util cat <restart_file_1> ... <restart_file_n> <new_restart_file>" 
+    << "    dakota_restart_util cat <restart_file_1> ... <restart_file_n> <new_restart_file>\n"
+    << "    dakota_restart_util to_indexed <restart_file> <indexed_restart_file>\n"
+    << "    dakota_restart_util from_indexed <indexed_restart_file> <restart_file>"
     << endl;
 }
 
@@ -227,6 +238,40 @@ void print_restart(StringArray pos_args, String print_dest)
 
   try {
 
+    std::ofstream neutral_file_stream;
+    if (print_dest == "neutral_file") {
+      cout << "Writing neutral file " << pos_args[1] << '\n';
+      neutral_file_stream.open(pos_args[1].c_str());
+    }
+
+    // override default to output data in full precision (double = 16 digits)
+    write_precision = 16;
+
+    int cntr = 0;
+    if (IndexedRestartReader::is_indexed(read_restart_filename)) {
+      IndexedRestartReader rst_reader(read_restart_filename);
+      cout << "Reading indexed restart file '" << read_restart_filename
+	   << "' containing: " << rst_reader.version();
+      for (size_t i=0; i<rst_reader.size(); ++i) {
+	ParamResponsePair current_pair;
+	rst_reader.read_prp(i, current_pair);
+	cntr++;
+	if (print_dest == "stdout")
+	  cout << "------------------------------------------\nRestart record "
+	       << setw(4) << cntr << "  (evaluation id " << setw(4)
+	       << current_pair.eval_id()
+	       << "):\n------------------------------------------\n"
+	       << current_pair;
+	else if (print_dest == "neutral_file")
+	  current_pair.write_annotated(neutral_file_stream);
+      }
+      if (print_dest == "neutral_file")
+	neutral_file_stream.close();
+      cout << "Restart file processing completed: " << cntr
+	   << " evaluations retrieved.\n";
+      return;
+    }
+
     RestartVersion rst_ver =
       RestartVersion::check_restart_version(read_restart_filename);
 
@@ -246,16 +291,6 @@ void print_restart(StringArray pos_args, String print_dest)
     cout << "Reading restart file '" << read_restart_filename << "'."
 	 << std::endl;
 
-    std::ofstream neutral_file_stream;
-    if (print_dest == "neutral_file") {
-      cout << "Writing neutral file " << pos_args[1] << '\n';
-      neutral_file_stream.open(pos_args[1].c_str());
-    }
-
-    // override default to output data in full precision (double = 16 digits)
-    write_precision = 16;
-
-    int cntr = 0;
     restart_input_fs.peek();  // peek to force EOF if no records in restart file
     while (restart_input_fs.good() && !restart_input_fs.eof()) {
 
@@ -481,28 +516,7 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
-
-    cout << "Reading restart file '" << read_restart_filename << "'."
-	 << std::endl;
-
     size_t num_evals = 0;
-    cout << "Writing tabular text file " << pos_args[1] << '\n';
-    std::ofstream tabular_text(pos_args[1].c_str());
     // to track changes in interface and/or labels
     String curr_interf;
     StringMultiArray curr_acv_labels;
@@ -510,30 +524,10 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
     StringMultiArray curr_adsv_labels;
     StringMultiArray curr_adrv_labels;
     StringArray curr_resp_labels;
+    std::ofstream tabular_text;
 
-    // Note: tabular defaults to write_precision from global defs
-    // Note: setprecision(write_precision) and std::ios::floatfield are embedded
-    //       in write_data_tabular() functions.
-
-    int wp_save = write_precision;  // later restore since this is global data
-    write_precision = tabular_precision;
-
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
-
-      ParamResponsePair current_pair;
-      try {
-	restart_input_archive & current_pair;
-      }
-      catch(const boost::archive::archive_exception& e) {
-	// No current way a user can recover from this with remove_ids
-	Cerr << "\nError reading restart file '" << read_restart_filename
-	     << "'.\nDetails (boost::archive exception):      "
-	     << e.what() << std::endl;
-	abort_handler(-1);
-      }
-      // serialization functions no longer throw strings
-
+    // write one evaluation, preceded by a header when needed
+    auto tabulate_pair = [&](const ParamResponsePair& current_pair) {
       // The number of variables or responses may differ across
       // different interfaces.  Output the header when needed due to
       // label or length changes.
@@ -562,9 +556,74 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
       }
       current_pair.write_tabular(tabular_text, tabular_format);  // also writes IDs
       ++num_evals;
+    };
 
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
+    // Note: tabular defaults to write_precision from global defs
+    // Note: setprecision(write_precision) and std::ios::floatfield are embedded
+    //       in write_data_tabular() functions.
+
+    int wp_save = write_precision;  // later restore since this is global data
+
+    if (IndexedRestartReader::is_indexed(read_restart_filename)) {
+      IndexedRestartReader rst_reader(read_restart_filename);
+      cout << "Reading indexed restart file '" << read_restart_filename
+	   << "' containing: " << rst_reader.version();
+
+      cout << "Writing tabular text file " << pos_args[1] << '\n';
+      tabular_text.open(pos_args[1].c_str());
+      write_precision = tabular_precision;
+
+      for (size_t i=0; i<rst_reader.size(); ++i) {
+	ParamResponsePair current_pair;
+	rst_reader.read_prp(i, current_pair);
+	tabulate_pair(current_pair);
+      }
+    }
+    else {
+      RestartVersion rst_ver =
+	RestartVersion::check_restart_version(read_restart_filename);
+
+      std::ifstream restart_input_fs(read_restart_filename.c_str(),
+				     std::ios::binary);
+      if (!restart_input_fs.good()) {
+	Cerr << "\nError: could not open restart file '"
+	     << read_restart_filename << "' for reading."<< std::endl;
+	exit(-1);
+      }
+      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+
+      // re-read the full, correct version info from the new stream
+      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
+	restart_input_archive & rst_ver;
+
+      cout << "Reading restart file '" << read_restart_filename << "'."
+	   << std::endl;
+
+      cout << "Writing tabular text file " << pos_args[1] << '\n';
+      tabular_text.open(pos_args[1].c_str());
+      write_precision = tabular_precision;
+
+      restart_input_fs.peek();  // peek to force EOF if no records in file
+      while (restart_input_fs.good() && !restart_input_fs.eof()) {
+
+	ParamResponsePair current_pair;
+	try {
+	  restart_input_archive & current_pair;
+	}
+	catch(const boost::archive::archive_exception& e) {
+	  // No current way a user can recover from this with remove_ids
+	  Cerr << "\nError reading restart file '" << read_restart_filename
+	       << "'.\nDetails (boost::archive exception):      "
+	       << e.what() << std::endl;
+	  abort_handler(-1);
+	}
+	// serialization functions no longer throw strings
+
+	tabulate_pair(current_pair);
+
+	// peek to force EOF if the last restart record was read
+	restart_input_fs.peek();
+      }
     }
 
     cout << "Restart file processing completed: " << num_evals
@@ -662,7 +721,8 @@ void read_neutral(StringArray pos_args)
     identifier for evaluation removal can be either a double precision
     number (all evaluations having a matching response function value
     are removed) or a list of integers (all evaluations with matching
-    evaluation ids are removed). */
+    evaluation ids are removed).  An indexed restart file is repaired
+    into an indexed restart file. */
 void repair_restart(StringArray pos_args, String identifier_type)
 {
   double  remove_val;
@@ -716,6 +776,51 @@ void repair_restart(StringArray pos_args, String identifier_type)
     exit(-1);
   }
 
+  // An indexed restart file is repaired into a new indexed file.  Removal
+  // by id consults only the index and copies the retained records without
+  // decoding them; removal by value decodes each record.
+  if (IndexedRestartReader::is_indexed(read_restart_filename)) {
+    try {
+      IndexedRestartReader rst_reader(read_restart_filename);
+      IndexedRestartWriter rst_writer(write_restart_filename,
+				      rst_reader.version());
+      cout << "Writing new indexed restart file " << write_restart_filename
+	   << '\n';
+      size_t cntr = rst_reader.size();
+      for (size_t i=0; i<cntr; ++i) {
+	if (by_value) {
+	  ParamResponsePair current_pair;
+	  rst_reader.read_prp(i, current_pair);
+	  const Response& resp      = current_pair.response();
+	  const RealVector& fn_vals = resp.function_values();
+	  const ShortArray& asv     = resp.active_set_request_vector();
+	  bool bad_flag = false;
+	  for (size_t j=0; j<fn_vals.length(); ++j)
+	    if ((asv[j] & 1) && fn_vals[j] == remove_val)
+	      { bad_flag = true; break; }
+	  if (!bad_flag)
+	    rst_writer.append_prp(current_pair);
+	}
+	else if (!contains(bad_ids, rst_reader.eval_id(i))) {
+	  std::pair<const char*, size_t> record = rst_reader.record_data(i);
+	  rst_writer.append_record(record.first, record.second,
+				   rst_reader.eval_id(i));
+	}
+      }
+      size_t good_cntr = rst_writer.size();
+      rst_writer.close();
+      cout << "Restart repair completed: " << cntr << " evaluations retrieved"
+	   << ", " << cntr-good_cntr << " removed, " << good_cntr
+	   << " saved.\n";
+    }
+    catch (const std::exception& e) {
+      Cerr << "Error repairing indexed restart file '" << read_restart_filename
+	   << "'.\nDetails: " << e.what() << '\n';
+      abort_handler(IO_ERROR);
+    }
+    return;
+  }
+
   try {
 
     RestartVersion rst_ver =
@@ -810,7 +915,8 @@ void repair_restart(StringArray pos_args, String identifier_type)
 /** \b Usage: "dakota_restart_util cat dakota_1.rst ... dakota_n.rst
                  dakota_new.rst"
 
-    Combines multiple restart files into a single restart database. */
+    Combines multiple restart files, sequential or indexed, into a
+    single (sequential) restart database. */
 void concatenate_restart(StringArray pos_args)
 {
   if (pos_args.size() < 3) {
@@ -835,6 +941,20 @@ void concatenate_restart(StringArray pos_args)
 
     for(const String& rst_file : pos_args) {
 
+      // records of an indexed restart file are decoded from its index
+      if (IndexedRestartReader::is_indexed(rst_file)) {
+	IndexedRestartReader rst_reader(rst_file);
+	size_t cntr = rst_reader.size();
+	for (size_t i=0; i<cntr; ++i) {
+	  ParamResponsePair current_pair;
+	  rst_reader.read_prp(i, current_pair);
+	  restart_output_archive & current_pair;
+	}
+	cout << rst_file << " processing completed: " << cntr
+	     << " evaluations retrieved.\n";
+	continue;
+      }
+
       RestartVersion rst_ver =
 	RestartVersion::check_restart_version(rst_file);
 
@@ -893,4 +1013,121 @@ void concatenate_restart(StringArray pos_args)
 
 }
 
+
+
+/** \b Usage: "dakota_restart_util to_indexed dakota.rst dakota.rstx"\n
+              "dakota_restart_util from_indexed dakota.rstx dakota.rst"
+
+    Converts between the sequential restart archive written by Dakota
+    and the indexed restart format, which supports random access to
+    records and concurrent decoding when restarting large studies. */
+void convert_restart(StringArray pos_args, bool to_indexed)
+{
+  if (pos_args.size() != 2) {
+    if (to_indexed)
+      Cerr << "Usage: dakota_restart_util to_indexed <restart_file> "
+	   << "<indexed_restart_file>." << endl;
+    else
+      Cerr << "Usage: dakota_restart_util from_indexed <indexed_restart_file> "
+	   << "<restart_file>." << endl;
+    exit(-1);
+  }
+
+  const String& read_restart_filename  = pos_args[0];
+  const String& write_restart_filename = pos_args[1];
+  if (read_restart_filename == write_restart_filename) {
+    Cerr << "Error: old and new restart filenames must differ." << endl;
+    exit(-1);
+  }
+
+  try {
+
+    int cntr = 0;
+    if (to_indexed) {
+      RestartVersion rst_ver =
+	RestartVersion::check_restart_version(read_restart_filename);
+
+      std::ifstream restart_input_fs(read_restart_filename.c_str(),
+				     std::ios::binary);
+      if (!restart_input_fs.good()) {
+	Cerr << "\nError: could not open restart file '"
+	     << read_restart_filename << "' for reading."<< std::endl;
+	exit(-1);
+      }
+      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+
+      // re-read the full, correct version info from the new stream
+      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
+	restart_input_archive & rst_ver;
+
+      // retain the version of the Dakota that wrote the source file
+      IndexedRestartWriter rst_writer(write_restart_filename, rst_ver);
+      cout << "Writing new indexed restart file " << write_restart_filename
+	   << '\n';
+
+      restart_input_fs.peek();  // peek to force EOF if no records in restart file
+      while (restart_input_fs.good() && !restart_input_fs.eof()) {
+	ParamResponsePair current_pair;
+	try {
+	  restart_input_archive & current_pair;
+	}
+	catch(const boost::archive::archive_exception& e) {
+	  Cerr << "\nError reading restart file '" << read_restart_filename
+	       << "'.\nDetails (boost::archive exception):      "
+	       << e.what() << std::endl;
+	  abort_handler(-1);
+	}
+	rst_writer.append_prp(current_pair);
+	cntr++;
+
+	// peek to force EOF if the last restart record was read
+	restart_input_fs.peek();
+      }
+      rst_writer.close();
+    }
+    else {
+      IndexedRestartReader rst_reader(read_restart_filename);
+      cout << "Reading indexed restart file '" << read_restart_filename
+	   << "' containing: " << rst_reader.version();
+
+      std::ofstream restart_output_fs(write_restart_filename.c_str(),
+				      std::ios::binary);
+      if (!restart_output_fs.good()) {
+	Cerr << "\nError: could not open restart file '"
+	     << write_restart_filename << "' for writing."<< std::endl;
+	exit(-1);
+      }
+      boost::archive::binary_oarchive restart_output_archive(restart_output_fs);
+      // records are re-encoded by this Dakota, so tag with its version
+      RestartVersion rst_ver(DakotaBuildInfo::get_release_num(),
+			     DakotaBuildInfo::get_rev_number());
+      restart_output_archive & rst_ver;
+
+      cout << "Writing new restart file " << write_restart_filename << '\n';
+
+      for (size_t i=0; i<rst_reader.size(); ++i) {
+	ParamResponsePair current_pair;
+	rst_reader.read_prp(i, current_pair);
+	restart_output_archive & current_pair;
+	cntr++;
+      }
+      restart_output_fs.close();
+    }
+
+    cout << "Restart conversion completed: " << cntr
+	 << " evaluations converted.\n";
+  }
+  catch (const boost::archive::archive_exception& e) {
+    Cerr << "\nError converting restart file '" << read_restart_filename
+	 << "' (possibly empty or corrupt file).\nDetails (Boost archive "
+	 << "exception): " << e.what() << std::endl;
+    abort_handler(IO_ERROR);
+  }
+  catch (const std::exception& e) {
+    Cerr << "Unknown error converting restart file '" << read_restart_filename
+	 << "'.\nDetails: " << e.what() << '\n';
+    abort_handler(IO_ERROR);
+  }
+}
+
 } // namespace Dakota
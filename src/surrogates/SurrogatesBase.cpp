@@ -11,6 +11,11 @@
 
 #include "util_math_tools.hpp"
 #include "util_metrics.hpp"
+#include "util_threads.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 
 namespace dakota {
 namespace surrogates {
@@ -93,68 +98,145 @@ VectorXd Surrogate::cross_validate(const MatrixXd& samples,
                                    const int num_folds, const int seed) {
   const int num_metrics = mnames.size();
   VectorXd cv_results = VectorXd::Zero(num_metrics);
-  VectorXd metrics_values(num_metrics);
 
   const int num_samples = samples.rows();
-  const int num_features = samples.cols();
   std::vector<VectorXi> cv_folds;
-  VectorXi fold_indices;
-  MatrixXd train_samples, train_response;
-  MatrixXd val_samples, val_response;
-
-  int num_train_samples, num_val_samples;
-  int samples_index, train_index;
-
   util::create_cv_folds(num_folds, num_samples, cv_folds, seed);
 
-  // clone the surrogate's configuration so CV doesn't invalidate *this
-  std::shared_ptr<Surrogate> cv_surrogate = this->clone();
-  // ParameterList cv_surrogate_options;
-  // cv_surrogate->get_options(cv_surrogate_options);
-  // int verbosity_level = cv_surrogate_options.get<int>("verbosity");
-  int verbosity_level = configOptions.get<int>("verbosity");
+  std::vector<VectorXd> fold_predictions(num_folds);
+  if (!cross_validation_predictions(samples, response, cv_folds,
+                                    fold_predictions))
+    build_cv_folds(samples, response, cv_folds, fold_predictions);
 
+  /* accumulate the metrics in fold order */
+  VectorXd val_response;
   for (int i = 0; i < num_folds; i++) {
-    if (verbosity_level > 0) {
-      std::cout << "\nCross-validation fold " << i + 1 << "/" << num_folds
-                << "\n\n";
-    }
-    /* validation samples */
-    fold_indices = cv_folds[i];
-    num_val_samples = fold_indices.size();
-    val_samples.resize(num_val_samples, num_features);
-    val_response.resize(num_val_samples, 1);
-    for (int j = 0; j < num_val_samples; j++) {
-      samples_index = fold_indices(j);
-      val_samples.row(j) = samples.row(samples_index);
-      val_response(j, 0) = response(samples_index, 0);
-    }
+    const VectorXi& fold_indices = cv_folds[i];
+    val_response.resize(fold_indices.size());
+    for (int j = 0; j < fold_indices.size(); j++)
+      val_response(j) = response(fold_indices(j), 0);
+    for (int m = 0; m < num_metrics; m++)
+      cv_results(m) += util::compute_metric(fold_predictions[i], val_response,
+                                            mnames[m]);
+  }
+
+  cv_results /= double(num_folds);
+  return cv_results;
+}
+
+void Surrogate::build_cv_folds(const MatrixXd& samples,
+                               const MatrixXd& response,
+                               const std::vector<VectorXi>& cv_folds,
+                               std::vector<VectorXd>& fold_predictions) {
+  const int num_folds = cv_folds.size();
+  const int num_samples = samples.rows();
+  const int num_features = samples.cols();
+  int verbosity_level = configOptions.get<int>("verbosity");
 
-    /* training samples */
-    num_train_samples = num_samples - num_val_samples;
-    train_samples.resize(num_train_samples, num_features);
-    train_response.resize(num_train_samples, 1);
-    train_index = 0;
-    for (int k = 0; k < num_folds; k++) {
-      if (k != i) {
-        fold_indices = cv_folds[k];
-        for (int j = 0; j < fold_indices.size(); j++) {
-          samples_index = fold_indices(j);
-          train_samples.row(train_index) = samples.row(samples_index);
-          train_response(train_index, 0) = response(samples_index, 0);
-          train_index++;
+  /* each fold is a full build; threaded builds (e.g., GP restarts or
+   * basis assembly) within a fold share that fold's thread budget */
+  const int num_threads = util::num_threads(std::max(1, num_folds), 0, 0);
+
+  /* clone the surrogate's configuration so CV doesn't invalidate *this;
+   * each thread builds its folds with its own clone.  The clones are made
+   * here since Teuchos::ParameterList copies are not thread-safe. */
+  std::vector<std::shared_ptr<Surrogate>> cv_surrogates(num_threads);
+  for (auto& cv_surrogate : cv_surrogates) {
+    cv_surrogate = this->clone();
+    /* keep the concurrent builds quiet */
+    if (num_threads > 1) cv_surrogate->configOptions.set("verbosity", 0);
+  }
+  if (num_threads > 1 && verbosity_level > 0)
+    std::cout << "\nCross-validation: building " << num_folds
+              << " folds on " << num_threads << " threads\n\n";
+
+  std::vector<std::exception_ptr> thread_errors(num_threads);
+  std::atomic<int> next_fold(0);
+
+  auto run_folds = [&](const int t) {
+    try {
+      Surrogate& cv_surrogate = *cv_surrogates[t];
+      MatrixXd train_samples, train_response, val_samples;
+      for (int i = next_fold++; i < num_folds; i = next_fold++) {
+        if (num_threads == 1 && verbosity_level > 0) {
+          std::cout << "\nCross-validation fold " << i + 1 << "/" << num_folds
+                    << "\n\n";
+        }
+        /* validation samples */
+        const VectorXi& fold_indices = cv_folds[i];
+        const int num_val_samples = fold_indices.size();
+        val_samples.resize(num_val_samples, num_features);
+        for (int j = 0; j < num_val_samples; j++)
+          val_samples.row(j) = samples.row(fold_indices(j));
+
+        /* training samples */
+        const int num_train_samples = num_samples - num_val_samples;
+        train_samples.resize(num_train_samples, num_features);
+        train_response.resize(num_train_samples, 1);
+        int train_index = 0;
+        for (int k = 0; k < num_folds; k++) {
+          if (k != i) {
+            const VectorXi& train_indices = cv_folds[k];
+            for (int j = 0; j < train_indices.size(); j++) {
+              const int samples_index = train_indices(j);
+              train_samples.row(train_index) = samples.row(samples_index);
+              train_response(train_index, 0) = response(samples_index, 0);
+              train_index++;
+            }
+          }
         }
+
+        cv_surrogate.build(train_samples, train_response);
+        fold_predictions[i] = cv_surrogate.value(val_samples);
       }
+    } catch (...) {
+      thread_errors[t] = std::current_exception();
+      /* stop the other threads from claiming further folds */
+      next_fold = num_folds;
     }
+  };
 
-    cv_surrogate->build(train_samples, train_response);
-    metrics_values =
-        cv_surrogate->evaluate_metrics(mnames, val_samples, val_response);
-    cv_results += metrics_values;
-  }
+  if (num_threads > 1) Eigen::initParallel();
+  util::run_threads(num_threads, run_folds);
+  for (const auto& error : thread_errors)
+    if (error) std::rethrow_exception(error);
+}
 
-  cv_results /= double(num_folds);
-  return cv_results;
+bool Surrogate::cross_validation_predictions(
+    const MatrixXd& samples, const MatrixXd& response,
+    const std::vector<VectorXi>& cv_folds,
+    std::vector<VectorXd>& fold_predictions) {
+  silence_unused_args(samples, response, cv_folds, fold_predictions);
+  return false;
+}
+
+bool Surrogate::fold_block_residuals(const MatrixXd& a_mat,
+                                     const VectorXd& b_vec,
+                                     const std::vector<VectorXi>& cv_folds,
+                                     std::vector<VectorXd>& fold_residuals) {
+  const int num_folds = cv_folds.size();
+  fold_residuals.resize(num_folds);
+  MatrixXd a_block;
+  VectorXd b_block;
+  Eigen::LDLT<MatrixXd> block_fact;
+  const double rcond_tol = 1.0e-12;
+  for (int i = 0; i < num_folds; i++) {
+    const VectorXi& fold_indices = cv_folds[i];
+    const int num_val_samples = fold_indices.size();
+    a_block.resize(num_val_samples, num_val_samples);
+    b_block.resize(num_val_samples);
+    for (int j = 0; j < num_val_samples; j++) {
+      b_block(j) = b_vec(fold_indices(j));
+      for (int k = 0; k < num_val_samples; k++)
+        a_block(j, k) = a_mat(fold_indices(j), fold_indices(k));
+    }
+    block_fact.compute(a_block);
+    if (block_fact.info() != Eigen::Success ||
+        block_fact.rcond() < rcond_tol)
+      return false;
+    fold_residuals[i] = block_fact.solve(b_block);
+  }
+  return true;
 }
 
 }  // namespace surrogates
@@ -209,7 +209,21 @@ class Surrogate {
   VectorXd evaluate_metrics(const StringArray& mnames, const MatrixXd& points,
                             const MatrixXd& ref_values);
 
-  /// Perform K-folds cross-validation (within surrogates)
+  /**
+   *  \brief Perform K-folds cross-validation (within surrogates).
+   *
+   *  Surrogates that can compute the held-out predictions in closed
+   *  form (see cross_validation_predictions) do so from a single fit;
+   *  otherwise a clone is built for each fold, with the folds spread
+   *  over the threads of dakota::util::thread_budget().
+   *  \param[in] samples Matrix of data for surrogate construction -
+   *  (num_samples by num_features).
+   *  \param[in] response Vector of targets - (num_samples by 1).
+   *  \param[in] mnames List of metrics names.
+   *  \param[in] num_folds Number of folds.
+   *  \param[in] seed Seed for the random assignment of samples to folds.
+   *  \returns Metrics averaged over the folds - (num_metrics).
+   */
   VectorXd cross_validate(const MatrixXd& samples, const MatrixXd& response,
                           const StringArray& mnames, const int num_folds = 5,
                           const int seed = 20);
@@ -238,7 +252,52 @@ class Surrogate {
   /// clone derived Surrogate class for use in cross-validation
   virtual std::shared_ptr<Surrogate> clone() const = 0;
 
+  /**
+   *  \brief Compute the held-out predictions of K-folds cross-validation
+   *  without building the surrogate for each fold.
+   *  \param[in] samples Matrix of data for surrogate construction -
+   *  (num_samples by num_features).
+   *  \param[in] response Vector of targets - (num_samples by 1).
+   *  \param[in] cv_folds Sample indices of each fold.
+   *  \param[out] fold_predictions Predictions at the samples of each fold
+   *  by the surrogate built on the remaining folds.
+   *  \returns Whether the predictions were computed; the base class
+   *  returns false, in which case cross_validate builds each fold.
+   */
+  virtual bool cross_validation_predictions(
+      const MatrixXd& samples, const MatrixXd& response,
+      const std::vector<VectorXi>& cv_folds,
+      std::vector<VectorXd>& fold_predictions);
+
+  /**
+   *  \brief Held-out residuals of a linear smoother for each fold,
+   *  r_F = (A_FF)^{-1} b_F, where A_FF is the diagonal block of A for
+   *  the samples in fold F.
+   *  \param[in] a_mat Symmetric matrix A - (num_samples by num_samples).
+   *  \param[in] b_vec Vector b - (num_samples).
+   *  \param[in] cv_folds Sample indices of each fold.
+   *  \param[out] fold_residuals Residuals r_F for each fold.
+   *  \returns false if a diagonal block of A is numerically singular.
+   */
+  static bool fold_block_residuals(const MatrixXd& a_mat,
+                                   const VectorXd& b_vec,
+                                   const std::vector<VectorXi>& cv_folds,
+                                   std::vector<VectorXd>& fold_residuals);
+
  private:
+  /**
+   *  \brief Build a clone of the surrogate on the complement of each fold
+   *  and predict the fold's samples, with the folds spread over threads.
+   *  \param[in] samples Matrix of data for surrogate construction -
+   *  (num_samples by num_features).
+   *  \param[in] response Vector of targets - (num_samples by 1).
+   *  \param[in] cv_folds Sample indices of each fold.
+   *  \param[out] fold_predictions Predictions at the samples of each fold.
+   */
+  void build_cv_folds(const MatrixXd& samples, const MatrixXd& response,
+                      const std::vector<VectorXi>& cv_folds,
+                      std::vector<VectorXd>& fold_predictions);
+
   /// Allow serializers access to private class data
   friend class boost::serialization::access;
   /// Serializer for base class data (call from dervied with base_object)
@@ -22,9 +22,20 @@ void SquaredExponentialKernel::compute_gram(const std::vector<MatrixXd>& dists2,
                                             const VectorXd& theta_values,
                                             MatrixXd& gram) {
   compute_Dbar(dists2, theta_values, false);
+  gram_from_Dbar2(theta_values, gram);
+}
+
+void SquaredExponentialKernel::gram_from_Dbar2(const VectorXd& theta_values,
+                                               MatrixXd& gram) {
   gram = exp(2.0 * theta_values(0)) * (-0.5 * Dbar2.array()).exp();
 }
 
+void SquaredExponentialKernel::compute_length_scale_factor(
+    const MatrixXd& gram, const VectorXd& theta_values, MatrixXd& factor) {
+  silence_unused_args(theta_values);
+  factor = gram;
+}
+
 void SquaredExponentialKernel::compute_gram_derivs(
     const MatrixXd& gram, const std::vector<MatrixXd>& dists2,
     const VectorXd& theta_values, std::vector<MatrixXd>& gram_derivs) {
@@ -63,12 +74,26 @@ Matern32Kernel::~Matern32Kernel() {}
 void Matern32Kernel::compute_gram(const std::vector<MatrixXd>& dists2,
                                   const VectorXd& theta_values,
                                   MatrixXd& gram) {
-  compute_Dbar(dists2, theta_values);
+  compute_Dbar(dists2, theta_values, false);
+  gram_from_Dbar2(theta_values, gram);
+}
+
+void Matern32Kernel::gram_from_Dbar2(const VectorXd& theta_values,
+                                     MatrixXd& gram) {
+  Dbar = Dbar2.cwiseSqrt();
   Dbar *= sqrt3;
   gram = exp(2.0 * theta_values(0)) *
          (1.0 + Dbar.array()).cwiseProduct((-Dbar).array().exp());
 }
 
+void Matern32Kernel::compute_length_scale_factor(const MatrixXd& gram,
+                                                 const VectorXd& theta_values,
+                                                 MatrixXd& factor) {
+  silence_unused_args(gram);
+  const double sig2 = exp(2.0 * theta_values(0));
+  factor = sig2 * 3.0 * (-Dbar).array().exp();
+}
+
 void Matern32Kernel::compute_gram_derivs(const MatrixXd& gram,
                                          const std::vector<MatrixXd>& dists2,
                                          const VectorXd& theta_values,
@@ -115,13 +140,27 @@ Matern52Kernel::~Matern52Kernel() {}
 void Matern52Kernel::compute_gram(const std::vector<MatrixXd>& dists2,
                                   const VectorXd& theta_values,
                                   MatrixXd& gram) {
-  compute_Dbar(dists2, theta_values);
+  compute_Dbar(dists2, theta_values, false);
+  gram_from_Dbar2(theta_values, gram);
+}
+
+void Matern52Kernel::gram_from_Dbar2(const VectorXd& theta_values,
+                                     MatrixXd& gram) {
+  Dbar = Dbar2.cwiseSqrt();
   Dbar *= sqrt5;
   gram = exp(2.0 * theta_values(0)) *
          (1.0 + Dbar.array() + Dbar.array().square() / 3.0)
              .cwiseProduct((-Dbar).array().exp());
 }
 
+void Matern52Kernel::compute_length_scale_factor(const MatrixXd& gram,
+                                                 const VectorXd& theta_values,
+                                                 MatrixXd& factor) {
+  silence_unused_args(gram);
+  const double sig2 = exp(2.0 * theta_values(0));
+  factor = sig2 * 5.0 / 3.0 * (1.0 + Dbar.array()) * ((-Dbar).array()).exp();
+}
+
 void Matern52Kernel::compute_gram_derivs(const MatrixXd& gram,
                                          const std::vector<MatrixXd>& dists2,
                                          const VectorXd& theta_values,
@@ -215,6 +254,62 @@ void Kernel::compute_Dbar(const std::vector<MatrixXd>& dists2,
   if (take_sqrt) Dbar = Dbar2.cwiseSqrt();
 }
 
+void Kernel::compute_symmetric_Dbar2(const MatrixXd& points,
+                                     const VectorXd& theta_values) {
+  const int num_points = points.rows();
+  const int num_variables = points.cols();
+  VectorXd weights(num_variables);
+  for (int k = 0; k < num_variables; k++)
+    weights(k) = exp(-2.0 * theta_values(k + 1));
+
+  /* accumulate the strictly lower triangle column by column; each column
+   * segment stays in cache across the variables and its update is a
+   * contiguous (vectorizable) array expression */
+  Dbar2.setZero(num_points, num_points);
+  for (int j = 0; j < num_points - 1; j++) {
+    const int len = num_points - j - 1;
+    auto dbar2_col = Dbar2.col(j).tail(len).array();
+    for (int k = 0; k < num_variables; k++) {
+      dbar2_col +=
+          (points.col(k).tail(len).array() - points(j, k)).square() *
+          weights(k);
+    }
+  }
+  /* mirror into the strictly upper triangle */
+  for (int j = 1; j < num_points; j++)
+    Dbar2.col(j).head(j) = Dbar2.row(j).head(j).transpose();
+}
+
+void Kernel::compute_symmetric_gram(const MatrixXd& points,
+                                    const VectorXd& theta_values,
+                                    MatrixXd& gram) {
+  compute_symmetric_Dbar2(points, theta_values);
+  gram_from_Dbar2(theta_values, gram);
+}
+
+void Kernel::compute_length_scale_inner_products(const MatrixXd& points,
+                                                 const MatrixXd& weights,
+                                                 const VectorXd& theta_values,
+                                                 VectorXd& inner_products) {
+  const int num_points = points.rows();
+  const int num_variables = points.cols();
+  /* sum over the strictly lower triangle of the symmetric weights; the
+   * diagonal does not contribute since the distances vanish there */
+  inner_products.setZero(num_variables);
+  for (int j = 0; j < num_points - 1; j++) {
+    const int len = num_points - j - 1;
+    const auto weights_col = weights.col(j).tail(len).array();
+    for (int k = 0; k < num_variables; k++) {
+      inner_products(k) +=
+          (weights_col *
+           (points.col(k).tail(len).array() - points(j, k)).square())
+              .sum();
+    }
+  }
+  for (int k = 0; k < num_variables; k++)
+    inner_products(k) *= 2.0 * exp(-2.0 * theta_values(k + 1));
+}
+
 std::shared_ptr<Kernel> kernel_factory(const std::string& kernel_type) {
   if (kernel_type == "squared exponential") {
     return std::make_shared<SquaredExponentialKernel>();
@@ -83,6 +83,45 @@ class Kernel {
       const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
       const VectorXd& theta_values, const int index_i, const int index_j) = 0;
 
+  /**
+   *  \brief Compute the (symmetric) Gram matrix of a set of points directly
+   *  from their coordinates. Only the lower triangle of scaled squared
+   *  distances is accumulated, one contiguous column segment at a time, so
+   *  no component-wise distance matrices are formed.
+   *  \param[in] points Matrix of points (num_points by num_variables).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] gram Gram matrix.
+   */
+  void compute_symmetric_gram(const MatrixXd& points,
+                              const VectorXd& theta_values, MatrixXd& gram);
+
+  /**
+   *  \brief Compute the matrix F for which the derivative of the Gram matrix
+   *  with respect to length-scale hyperparameter k is F .* D2_k * exp(-2
+   *  theta_k), where D2_k holds the squared distances in component k. Uses
+   *  the scaled distances of the preceding Gram matrix computation.
+   *  \param[in] gram Gram matrix (without nugget terms).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] factor Length-scale derivative factor.
+   */
+  virtual void compute_length_scale_factor(const MatrixXd& gram,
+                                           const VectorXd& theta_values,
+                                           MatrixXd& factor) = 0;
+
+  /**
+   *  \brief Compute sum(dK/dtheta_k .* Q) for each length-scale
+   *  hyperparameter without forming the Gram matrix derivatives.
+   *  \param[in] points Matrix of points (num_points by num_variables).
+   *  \param[in] weights Symmetric matrix F .* Q, with F from
+   *  compute_length_scale_factor.
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] inner_products Vector of num_variables inner products.
+   */
+  void compute_length_scale_inner_products(const MatrixXd& points,
+                                           const MatrixXd& weights,
+                                           const VectorXd& theta_values,
+                                           VectorXd& inner_products);
+
  protected:
   /**
    *  \brief Compute the ``Dbar'' matrices of scaled distances
@@ -94,6 +133,24 @@ class Kernel {
   void compute_Dbar(const std::vector<MatrixXd>& cw_dists2,
                     const VectorXd& theta_values, bool take_sqrt = true);
 
+  /**
+   *  \brief Compute the symmetric ``Dbar2'' matrix of scaled squared
+   *  distances between a set of points.
+   *  \param[in] points Matrix of points (num_points by num_variables).
+   *  \param[in] theta_values Vector of hyperparameters.
+   */
+  void compute_symmetric_Dbar2(const MatrixXd& points,
+                               const VectorXd& theta_values);
+
+  /**
+   *  \brief Apply the kernel function to the scaled squared distances in
+   *  Dbar2 (also setting Dbar, if needed).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] gram Gram matrix.
+   */
+  virtual void gram_from_Dbar2(const VectorXd& theta_values,
+                               MatrixXd& gram) = 0;
+
   MatrixXd Dbar, Dbar2;
 };
 
@@ -120,6 +177,13 @@ class SquaredExponentialKernel : public Kernel {
       const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
+
+  void compute_length_scale_factor(const MatrixXd& gram,
+                                   const VectorXd& theta_values,
+                                   MatrixXd& factor) override;
+
+ protected:
+  void gram_from_Dbar2(const VectorXd& theta_values, MatrixXd& gram) override;
 };
 
 /// Stationary kernel with C^1 smooth realizations.
@@ -146,6 +210,13 @@ class Matern32Kernel : public Kernel {
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
 
+  void compute_length_scale_factor(const MatrixXd& gram,
+                                   const VectorXd& theta_values,
+                                   MatrixXd& factor) override;
+
+ protected:
+  void gram_from_Dbar2(const VectorXd& theta_values, MatrixXd& gram) override;
+
  private:
   const double sqrt3 = sqrt(3.);
 };
@@ -174,6 +245,13 @@ class Matern52Kernel : public Kernel {
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
 
+  void compute_length_scale_factor(const MatrixXd& gram,
+                                   const VectorXd& theta_values,
+                                   MatrixXd& factor) override;
+
+ protected:
+  void gram_from_Dbar2(const VectorXd& theta_values, MatrixXd& gram) override;
+
  private:
   const double sqrt5 = sqrt(5.);
 };
@@ -33,9 +33,11 @@ class GP_Objective : public ROL::Objective<double> {
   /**
    *  \brief Constructor for GP_Objective.
    *  \param[in] gp_model Reference to the GaussianProcess surrogate.
+   *  \param[in] workspace Workspace used for the likelihood evaluations.
    *
    */
-  GP_Objective(GaussianProcess& gp_model);
+  GP_Objective(const GaussianProcess& gp_model,
+               GaussianProcess::MLEWorkspace& workspace);
   ~GP_Objective();
 
   // ------------------------------------------------------------
@@ -94,7 +96,9 @@ class GP_Objective : public ROL::Objective<double> {
   // Private member variables
 
   /// Pointer to the GaussianProcess surrogate.
-  GaussianProcess& gp;
+  const GaussianProcess& gp;
+  /// Hyperparameters and Gram matrix storage for this objective.
+  GaussianProcess::MLEWorkspace& ws;
   /// Number of optimization variables.
   int nopt;
   /// Previously computed value of the objective function.
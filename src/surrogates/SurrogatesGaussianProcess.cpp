@@ -15,6 +15,10 @@
 #include "SurrogatesGPObjective.hpp"
 #include "Teuchos_oblackholestream.hpp"
 #include "util_math_tools.hpp"
+#include "util_threads.hpp"
+
+#include <atomic>
+#include <exception>
 
 namespace dakota {
 namespace surrogates {
@@ -107,7 +111,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
                                  configOptions.get<std::string>("scaler name")),
                              samples));
   dataScaler.scale_samples(samples, scaledBuildPoints);
-  compute_build_dists();
 
   MatrixXd beta_bounds;
   estimateTrend = configOptions.sublist("Trend").get<bool>("estimate trend");
@@ -127,12 +130,7 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   bestThetaValues.resize(numVariables + 1);
   betaValues.resize(numPolyTerms);
   bestBetaValues.resize(numPolyTerms);
-  /* set the size of the GramMatrix and its derivatives */
   GramMatrix.resize(numSamples, numSamples);
-  GramMatrixDerivs.resize(numVariables + 1);
-  for (int k = 0; k < numVariables + 1; k++) {
-    GramMatrixDerivs[k].resize(numSamples, numSamples);
-  }
 
   /* DTS: if the nugget is being estimated, should the fixed value be set to
    * zero? */
@@ -146,13 +144,8 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
                            num_restarts, configOptions.get<int>("gp seed"),
                            initial_guesses);
 
-  ROL::Ptr<std::ostream> outStream;
-  Teuchos::oblackholestream bhs;
-  outStream = ROL::makePtrFromRef(bhs);
-
-  /* Uncomment if you'd like to print ROL's output to screen.
-   * Useful for debugging */
-  // outStream = ROL::makePtrFromRef(std::cout);
+  /* Uncomment the std::cout lines below if you'd like to print ROL's
+   * output to screen. Useful for debugging (with "num threads" = 1) */
 
   /* No more reading in rol_params from an xml file
    * Set defaults in here instead */
@@ -162,100 +155,123 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   Teuchos::updateParametersFromXmlFile(paramfile, rol_params.ptr());
   */
 
-  auto gp_mle_rol_params =
-      Teuchos::rcp(new ParameterList("GP_MLE_Optimization"));
-  setup_default_optimization_params(gp_mle_rol_params);
-
-  auto gp_objective = std::make_shared<GP_Objective>(*this);
-  int dim = numVariables + 1 + numPolyTerms + numNuggetTerms;
-
-  // Define algorithm
-  ROL::Ptr<ROL::Step<double>> step =
-      ROL::makePtr<ROL::LineSearchStep<double>>(*gp_mle_rol_params);
-  ROL::Ptr<ROL::StatusTest<double>> status =
-      ROL::makePtr<ROL::StatusTest<double>>(*gp_mle_rol_params);
-  ROL::Algorithm<double> algo(step, status, false);
-
-  /* set up parameter vectors and bounds */
-  ROL::Ptr<std::vector<double>> x_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::StdVector<double> x(x_ptr);
-  ROL::Ptr<ROL::Bounds<double>> bound;
-  ROL::Ptr<std::vector<double>> lo_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::Ptr<std::vector<double>> hi_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
+  ParameterList gp_mle_rol_params("GP_MLE_Optimization");
+  setup_default_optimization_params(Teuchos::rcpFromRef(gp_mle_rol_params));
+
+  const int dim = get_num_opt_variables();
+
+  /* set up parameter bounds */
+  std::vector<double> lo(dim, 0.0), hi(dim, 0.0);
   /* sigma bounds */
-  (*lo_ptr)[0] = log(sigma_bounds(0));
-  (*hi_ptr)[0] = log(sigma_bounds(1));
+  lo[0] = log(sigma_bounds(0));
+  hi[0] = log(sigma_bounds(1));
   /* length scale bounds */
   for (int i = 0; i < numVariables; i++) {
     if (length_scale_bounds.rows() > 1) {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(i, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(i, 1));
+      lo[i + 1] = log(length_scale_bounds(i, 0));
+      hi[i + 1] = log(length_scale_bounds(i, 1));
     } else {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(0, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(0, 1));
+      lo[i + 1] = log(length_scale_bounds(0, 0));
+      hi[i + 1] = log(length_scale_bounds(0, 1));
     }
   }
   if (estimateTrend) {
     for (int i = 0; i < numPolyTerms; i++) {
-      (*lo_ptr)[numVariables + 1 + i] = beta_bounds(i, 0);
-      (*hi_ptr)[numVariables + 1 + i] = beta_bounds(i, 1);
+      lo[numVariables + 1 + i] = beta_bounds(i, 0);
+      hi[numVariables + 1 + i] = beta_bounds(i, 1);
     }
   }
   if (estimateNugget) {
-    (*lo_ptr)[dim - 1] = log(nugget_bounds(0));
-    (*hi_ptr)[dim - 1] = log(nugget_bounds(1));
-  }
-
-  ROL::Ptr<ROL::Vector<double>> lop =
-      ROL::makePtr<ROL::StdVector<double>>(lo_ptr);
-  ROL::Ptr<ROL::Vector<double>> hip =
-      ROL::makePtr<ROL::StdVector<double>>(hi_ptr);
-  bound = ROL::makePtr<ROL::Bounds<double>>(lop, hip);
-
-  std::vector<std::string> output;
-
-  objectiveFunctionHistory.resize(num_restarts);
-  objectiveGradientHistory.resize(num_restarts, dim);
-  thetaHistory.resize(num_restarts, dim);
-
-  double final_obj_value;
-  VectorXd final_obj_gradient(dim);
-
-  for (int i = 0; i < num_restarts; i++) {
-    for (int j = 0; j < dim; ++j) {
-      (*x_ptr)[j] = initial_guesses(i, j);
-    }
-    output = algo.run(x, *gp_objective, *bound, true, *outStream);
-    for (int j = 0; j < thetaValues.size(); ++j) {
-      (thetaValues)(j) = (*x_ptr)[j];
-    }
-    if (estimateTrend) {
-      for (int j = 0; j < numPolyTerms; ++j) {
-        betaValues(j) = (*x_ptr)[numVariables + 1 + j];
+    lo[dim - 1] = log(nugget_bounds(0));
+    hi[dim - 1] = log(nugget_bounds(1));
+  }
+
+  /* The restarts are independent: each thread claims restarts in turn and
+   * runs them with its own workspace, ROL objects, and copy of the ROL
+   * options (Teuchos::ParameterList reads are not thread-safe). Each
+   * restart starts from a fresh optimizer state, so its result does not
+   * depend on the number of threads. */
+  const int num_threads = num_mle_threads(num_restarts);
+  std::vector<ParameterList> thread_rol_params(num_threads,
+                                               gp_mle_rol_params);
+  std::vector<MLEWorkspace> workspaces(num_threads);
+  for (auto& workspace : workspaces) initialize_mle_workspace(workspace);
+
+  VectorXd final_obj_values(num_restarts);
+  MatrixXd final_obj_gradients(num_restarts, dim);
+  MatrixXd final_params(num_restarts, dim);
+  std::vector<std::exception_ptr> thread_errors(num_threads);
+  std::atomic<int> next_restart(0);
+
+  auto run_restarts = [&](const int t) {
+    try {
+      Teuchos::oblackholestream bhs;
+      ROL::Ptr<std::ostream> outStream = ROL::makePtrFromRef(bhs);
+      // outStream = ROL::makePtrFromRef(std::cout);
+      ParameterList& rol_params = thread_rol_params[t];
+      MLEWorkspace& workspace = workspaces[t];
+
+      ROL::Ptr<ROL::Vector<double>> lop =
+          ROL::makePtr<ROL::StdVector<double>>(
+              ROL::makePtr<std::vector<double>>(lo));
+      ROL::Ptr<ROL::Vector<double>> hip =
+          ROL::makePtr<ROL::StdVector<double>>(
+              ROL::makePtr<std::vector<double>>(hi));
+      ROL::Bounds<double> bound(lop, hip);
+
+      ROL::Ptr<std::vector<double>> x_ptr =
+          ROL::makePtr<std::vector<double>>(dim, 0.0);
+      ROL::StdVector<double> x(x_ptr);
+      VectorXd final_obj_gradient(dim);
+
+      for (int i = next_restart++; i < num_restarts; i = next_restart++) {
+        // Define algorithm
+        ROL::Ptr<ROL::Step<double>> step =
+            ROL::makePtr<ROL::LineSearchStep<double>>(rol_params);
+        ROL::Ptr<ROL::StatusTest<double>> status =
+            ROL::makePtr<ROL::StatusTest<double>>(rol_params);
+        ROL::Algorithm<double> algo(step, status, false);
+        GP_Objective gp_objective(*this, workspace);
+
+        for (int j = 0; j < dim; ++j) {
+          (*x_ptr)[j] = initial_guesses(i, j);
+        }
+        algo.run(x, gp_objective, bound, true, *outStream);
+        set_opt_params(*x_ptr, workspace);
+        /* get the final objective function value and gradient */
+        negative_marginal_log_likelihood(true, true, final_obj_values(i),
+                                         final_obj_gradient, workspace);
+        final_obj_gradients.row(i) = final_obj_gradient;
+        for (int j = 0; j < dim; ++j) final_params(i, j) = (*x_ptr)[j];
       }
+    } catch (...) {
+      thread_errors[t] = std::current_exception();
+      /* stop the other threads from claiming further restarts */
+      next_restart = num_restarts;
     }
-    if (estimateNugget) {
-      estimatedNuggetValue = (*x_ptr)[numVariables + 1 + numPolyTerms];
-    }
-    /* get the final objective function value and gradient */
-    negative_marginal_log_likelihood(true, true, final_obj_value,
-                                     final_obj_gradient);
-    if (final_obj_value < bestObjFunValue) {
-      bestObjFunValue = final_obj_value;
-      bestThetaValues = thetaValues;
-      if (estimateTrend) bestBetaValues = betaValues;
-      if (estimateNugget) bestEstimatedNuggetValue = estimatedNuggetValue;
+  };
+
+  if (num_threads > 1) Eigen::initParallel();
+  util::run_threads(num_threads, run_restarts);
+  for (const auto& error : thread_errors)
+    if (error) std::rethrow_exception(error);
+
+  /* reduce over the restarts in order, so the best (first minimal)
+   * restart is independent of the thread scheduling */
+  objectiveFunctionHistory = final_obj_values;
+  objectiveGradientHistory = final_obj_gradients;
+  thetaHistory = final_params;
+  for (int i = 0; i < num_restarts; i++) {
+    if (final_obj_values(i) < bestObjFunValue) {
+      bestObjFunValue = final_obj_values(i);
+      bestThetaValues = final_params.row(i).head(numVariables + 1).transpose();
+      if (estimateTrend)
+        bestBetaValues = final_params.row(i)
+                             .segment(numVariables + 1, numPolyTerms)
+                             .transpose();
+      if (estimateNugget)
+        bestEstimatedNuggetValue = final_params(i, dim - 1);
     }
-    objectiveFunctionHistory(i) = final_obj_value;
-    objectiveGradientHistory.row(i) = final_obj_gradient;
-    thetaHistory.row(i).head(numVariables + 1) = thetaValues;
-    if (estimateTrend)
-      thetaHistory.row(i).segment(numVariables + 1, numPolyTerms) = betaValues;
-    if (estimateNugget) thetaHistory.row(i).tail(1)(0) = estimatedNuggetValue;
-    algo.reset();
   }
 
   thetaValues = bestThetaValues;
@@ -267,9 +283,7 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   if (estimateNugget) estimatedNuggetValue = bestEstimatedNuggetValue;
 
   /* compute and store best Cholesky factorization */
-  compute_gram(cwiseDists2, true, false, GramMatrix);
-  CholFact.compute(GramMatrix);
-  hasBestCholFact = true;
+  compute_best_chol_fact();
 
   /* Useful info for debugging */
   /*
@@ -295,34 +309,35 @@ VectorXd GaussianProcess::value(const MatrixXd& eval_points, const int qoi) {
                            "point and Gaussian Process do not match"));
   }
 
-  VectorXd approx_values;
+  /* compute the Gram matrix and its Cholesky factorization */
+  if (!hasBestCholFact) compute_best_chol_fact();
+
+  const int num_pred_pts = eval_points.rows();
+  const int block_size = prediction_block_size(num_pred_pts);
+  VectorXd approx_values(num_pred_pts);
 
   /* scale the eval_points (prediction points) */
   const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
-  compute_pred_dists(scaled_pred_points);
 
-  /* compute the Gram matrix and its Cholesky factorization */
-  if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
-    CholFact.compute(GramMatrix);
+  /* stream the prediction points through in blocks; only the
+   * (block_size by numSamples) mixed Gram matrix is formed */
+  std::vector<MatrixXd> block_dists2;
+  MatrixXd block_gram, block_basis;
+  for (int start = 0; start < num_pred_pts; start += block_size) {
+    const int num_block_pts = std::min(block_size, num_pred_pts - start);
+    const MatrixXd block_pts =
+        scaled_pred_points.middleRows(start, num_block_pts);
+    compute_mixed_dists2(block_pts, block_dists2);
+    compute_gram(block_dists2, false, block_gram);
+    approx_values.segment(start, num_block_pts).noalias() =
+        block_gram * alphaValues;
+    if (estimateTrend) {
+      polyRegression->compute_basis_matrix(block_pts, block_basis);
+      approx_values.segment(start, num_block_pts).noalias() +=
+          block_basis * betaValues;
+    }
   }
 
-  VectorXd resid, chol_solve_resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
-
-  if (estimateTrend) {
-    resid = targetValues - basisMatrix * betaValues;
-  } else
-    resid = targetValues;
-
-  chol_solve_resid = CholFact.solve(resid);
-  approx_values = predMixedGramMatrix * chol_solve_resid;
-
-  if (estimateTrend) {
-    polyRegression->compute_basis_matrix(scaled_pred_points, predBasisMatrix);
-    MatrixXd z = CholFact.solve(basisMatrix);
-    approx_values += predBasisMatrix * betaValues;
-  }
   return responseScaleFactor * approx_values.array() + responseOffset;
 }
 
@@ -348,22 +363,15 @@ MatrixXd GaussianProcess::gradient(const MatrixXd& eval_points, const int qoi) {
   compute_pred_dists(scaled_pred_pts);
 
   /* compute the Gram matrix and its Cholesky factorization */
-  if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
-    CholFact.compute(GramMatrix);
-  }
+  if (!hasBestCholFact) compute_best_chol_fact();
 
-  MatrixXd chol_solve_resid, first_deriv_pred_gram, grad_components, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
-  resid = targetValues;
-  if (estimateTrend) resid -= basisMatrix * betaValues;
-  chol_solve_resid = CholFact.solve(resid);
+  MatrixXd first_deriv_pred_gram;
+  compute_gram(cwiseMixedDists2, false, predMixedGramMatrix);
 
   for (int i = 0; i < numVariables; i++) {
     first_deriv_pred_gram = kernel->compute_first_deriv_pred_gram(
         predMixedGramMatrix, cwiseMixedDists, thetaValues, i);
-    grad_components = first_deriv_pred_gram * chol_solve_resid;
-    gradient.col(i) = grad_components.col(0);
+    gradient.col(i).noalias() = first_deriv_pred_gram * alphaValues;
   }
 
   /* extra terms for GP with a trend */
@@ -393,23 +401,17 @@ MatrixXd GaussianProcess::hessian(const MatrixXd& eval_point, const int qoi) {
   compute_pred_dists(scaled_pred_point);
 
   /* compute the Gram matrix and its Cholesky factorization */
-  if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
-    CholFact.compute(GramMatrix);
-  }
+  if (!hasBestCholFact) compute_best_chol_fact();
 
-  MatrixXd chol_solve_resid, second_deriv_pred_gram, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
-  resid = targetValues;
-  if (estimateTrend) resid -= basisMatrix * betaValues;
-  chol_solve_resid = CholFact.solve(resid);
+  MatrixXd second_deriv_pred_gram;
+  compute_gram(cwiseMixedDists2, false, predMixedGramMatrix);
 
   /* Hessian */
   for (int i = 0; i < numVariables; i++) {
     for (int j = i; j < numVariables; j++) {
       second_deriv_pred_gram = kernel->compute_second_deriv_pred_gram(
           predMixedGramMatrix, cwiseMixedDists, thetaValues, i, j);
-      hessian(i, j) = (second_deriv_pred_gram * chol_solve_resid)(0, 0);
+      hessian(i, j) = second_deriv_pred_gram.row(0).dot(alphaValues);
       if (i != j) hessian(j, i) = hessian(i, j);
     }
   }
@@ -441,27 +443,19 @@ MatrixXd GaussianProcess::covariance(const MatrixXd& eval_points,
   compute_pred_dists(scaled_pred_points);
 
   /* compute the Gram matrix and its Cholesky factorization */
-  if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
-    CholFact.compute(GramMatrix);
-  }
+  if (!hasBestCholFact) compute_best_chol_fact();
 
-  VectorXd resid;
   MatrixXd chol_solve_pred_mat;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
-
-  if (estimateTrend)
-    resid = targetValues - basisMatrix * betaValues;
-  else
-    resid = targetValues;
+  compute_gram(cwiseMixedDists2, false, predMixedGramMatrix);
 
   chol_solve_pred_mat = CholFact.solve(predMixedGramMatrix.transpose());
 
-  compute_gram(cwisePredDists2, true, false, predGramMatrix);
+  kernel->compute_symmetric_gram(scaled_pred_points, thetaValues,
+                                 predGramMatrix);
+  add_nugget_terms(estimatedNuggetValue, predGramMatrix);
   predCovariance = predGramMatrix - predMixedGramMatrix * chol_solve_pred_mat;
 
   if (estimateTrend) {
-    MatrixXd chol_solve_resid = CholFact.solve(resid);
     polyRegression->compute_basis_matrix(scaled_pred_points, predBasisMatrix);
     MatrixXd z = CholFact.solve(basisMatrix);
     MatrixXd R_mat = predBasisMatrix - predMixedGramMatrix * (z);
@@ -477,7 +471,60 @@ VectorXd GaussianProcess::variance(const MatrixXd& eval_points, const int qoi) {
   silence_unused_args(qoi);
   assert(qoi == 0);
 
-  VectorXd variance = covariance(eval_points).diagonal();
+  if (eval_points.cols() != numVariables) {
+    throw(std::runtime_error(
+        "Gaussian Process variance input has wrong dimension."
+        " Dimension of the feature space for the evaluation point and Gaussian "
+        "Process do not match"));
+  }
+
+  /* compute the Gram matrix and its Cholesky factorization */
+  if (!hasBestCholFact) compute_best_chol_fact();
+
+  const int num_pred_pts = eval_points.rows();
+  const int block_size = prediction_block_size(num_pred_pts);
+  VectorXd variance(num_pred_pts);
+
+  /* prior variance (with nugget) from a zero-distance kernel evaluation */
+  std::vector<MatrixXd> zero_dists2(numVariables, MatrixXd::Zero(1, 1));
+  MatrixXd prior_var;
+  compute_gram(zero_dists2, true, prior_var);
+
+  MatrixXd z, h_mat_fact_solve;
+  Eigen::LDLT<MatrixXd> h_mat_fact;
+  if (estimateTrend) {
+    z = CholFact.solve(basisMatrix);
+    h_mat_fact.compute(basisMatrix.transpose() * z);
+  }
+
+  const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
+
+  /* only the diagonal of the predictive covariance is formed, one block of
+   * prediction points at a time */
+  std::vector<MatrixXd> block_dists2;
+  MatrixXd block_gram, chol_solve_block, block_basis, R_mat;
+  for (int start = 0; start < num_pred_pts; start += block_size) {
+    const int num_block_pts = std::min(block_size, num_pred_pts - start);
+    const MatrixXd block_pts =
+        scaled_pred_points.middleRows(start, num_block_pts);
+    compute_mixed_dists2(block_pts, block_dists2);
+    compute_gram(block_dists2, false, block_gram);
+    chol_solve_block = CholFact.solve(block_gram.transpose());
+    variance.segment(start, num_block_pts) =
+        prior_var(0, 0) - (block_gram.cwiseProduct(chol_solve_block.transpose()))
+                              .rowwise()
+                              .sum()
+                              .array();
+    if (estimateTrend) {
+      polyRegression->compute_basis_matrix(block_pts, block_basis);
+      R_mat = block_basis - block_gram * z;
+      h_mat_fact_solve = h_mat_fact.solve(R_mat.transpose());
+      variance.segment(start, num_block_pts) +=
+          (R_mat.cwiseProduct(h_mat_fact_solve.transpose())).rowwise().sum();
+    }
+  }
+
+  variance *= pow(responseScaleFactor, 2);
 
   for (int i = 0; i < variance.size(); i++) {
     if (variance(i) < 0.0 || std::isnan(variance(i))) {
@@ -488,40 +535,52 @@ VectorXd GaussianProcess::variance(const MatrixXd& eval_points, const int qoi) {
   return variance;
 }
 
-void GaussianProcess::negative_marginal_log_likelihood(bool compute_grad,
-                                                       bool form_gram,
-                                                       double& obj_value,
-                                                       VectorXd& obj_gradient) {
+void GaussianProcess::negative_marginal_log_likelihood(
+    bool compute_grad, bool form_gram, double& obj_value,
+    VectorXd& obj_gradient, MLEWorkspace& workspace) const {
+  const Eigen::LDLT<MatrixXd>& chol_fact = workspace.CholFact;
+  const VectorXd& residual = workspace.trendTargetResidual;
+  const VectorXd& residual_solution = workspace.GramResidualSolution;
+
   if (form_gram) {
-    compute_gram(cwiseDists2, true, true, GramMatrix);
-    CholFact.compute(GramMatrix);
-    trendTargetResidual = targetValues;
-    if (estimateTrend) trendTargetResidual -= basisMatrix * betaValues;
-    GramResidualSolution = CholFact.solve(trendTargetResidual);
+    compute_build_gram(true, workspace);
+    workspace.CholFact.compute(workspace.GramMatrix);
+    workspace.trendTargetResidual = targetValues;
+    if (estimateTrend)
+      workspace.trendTargetResidual -= basisMatrix * workspace.betaValues;
+    workspace.GramResidualSolution = chol_fact.solve(residual);
   }
 
-  obj_value =
-      0.5 * log(CholFact.vectorD().array()).matrix().sum() +
-      0.5 * (trendTargetResidual.transpose() * GramResidualSolution)(0, 0) +
-      static_cast<double>(numSamples) / 2.0 * log(2.0 * PI);
+  obj_value = 0.5 * log(chol_fact.vectorD().array()).matrix().sum() +
+              0.5 * (residual.transpose() * residual_solution)(0, 0) +
+              static_cast<double>(numSamples) / 2.0 * log(2.0 * PI);
 
   if (compute_grad) {
     /* DTS: This Cholesky solve is much more expensive than the factorization!
      */
-    MatrixXd Q =
-        -0.5 * (GramResidualSolution * GramResidualSolution.transpose() -
-                CholFact.solve(eyeMatrix));
+    MatrixXd Q = -0.5 * (residual_solution * residual_solution.transpose() -
+                         chol_fact.solve(eyeMatrix));
     if (estimateTrend) {
       obj_gradient.segment(numVariables + 1, numPolyTerms) =
-          -basisMatrix.transpose() * GramResidualSolution;
+          -basisMatrix.transpose() * residual_solution;
     }
 
-    for (int k = 0; k < numVariables + 1; k++)
-      obj_gradient(k) = (GramMatrixDerivs[k].cwiseProduct(Q)).sum();
+    /* the derivative w.r.t. sigma is twice the Gram matrix (without
+     * nugget terms); those w.r.t. the length scales are contracted with Q
+     * directly from the build points */
+    double nugget = fixedNuggetValue;
+    if (estimateNugget) nugget += exp(2.0 * workspace.estimatedNuggetValue);
+    obj_gradient(0) = 2.0 * ((workspace.GramMatrix.cwiseProduct(Q)).sum() -
+                             nugget * Q.trace());
+    VectorXd length_scale_grad;
+    workspace.kernel->compute_length_scale_inner_products(
+        scaledBuildPoints, workspace.GramLengthScaleFactor.cwiseProduct(Q),
+        workspace.thetaValues, length_scale_grad);
+    obj_gradient.segment(1, numVariables) = length_scale_grad;
 
     if (estimateNugget) {
       obj_gradient(numVariables + 1 + numPolyTerms) =
-          2.0 * exp(2.0 * estimatedNuggetValue) * Q.trace();
+          2.0 * exp(2.0 * workspace.estimatedNuggetValue) * Q.trace();
     }
   }
 }
@@ -558,22 +617,58 @@ void GaussianProcess::setup_hyperparameter_bounds(VectorXd& sigma_bounds,
   }
 }
 
-int GaussianProcess::get_num_opt_variables() {
+int GaussianProcess::get_num_opt_variables() const {
   return numVariables + 1 + numPolyTerms + numNuggetTerms;
 }
 
 int GaussianProcess::get_num_variables() const { return numVariables; }
 
-void GaussianProcess::set_opt_params(const std::vector<double>& opt_params) {
-  for (int i = 0; i < numVariables + 1; i++) thetaValues(i) = opt_params[i];
+void GaussianProcess::set_opt_params(const std::vector<double>& opt_params,
+                                     MLEWorkspace& workspace) const {
+  for (int i = 0; i < numVariables + 1; i++)
+    workspace.thetaValues(i) = opt_params[i];
 
   if (estimateTrend) {
     for (int i = 0; i < numPolyTerms; i++)
-      betaValues(i) = opt_params[numVariables + 1 + i];
+      workspace.betaValues(i) = opt_params[numVariables + 1 + i];
   }
 
   if (estimateNugget)
-    estimatedNuggetValue = opt_params[numVariables + 1 + numPolyTerms];
+    workspace.estimatedNuggetValue =
+        opt_params[numVariables + 1 + numPolyTerms];
+}
+
+bool GaussianProcess::cross_validation_predictions(
+    const MatrixXd& samples, const MatrixXd& response,
+    const std::vector<VectorXi>& cv_folds,
+    std::vector<VectorXd>& fold_predictions) {
+  if (!configOptions.get<bool>("fixed hyperparameter cross validation"))
+    return false;
+
+  /* a separate instance so that the state of *this is unchanged */
+  GaussianProcess full_gp(configOptions);
+  full_gp.build(samples, response);
+
+  const int num_samples = samples.rows();
+  const MatrixXd gram_inverse =
+      full_gp.CholFact.solve(MatrixXd::Identity(num_samples, num_samples));
+  std::vector<VectorXd> fold_residuals;
+  if (!fold_block_residuals(gram_inverse, full_gp.alphaValues, cv_folds,
+                            fold_residuals))
+    return false;
+
+  /* the residuals are in the units of the (standardized) targetValues */
+  const int num_folds = cv_folds.size();
+  fold_predictions.resize(num_folds);
+  for (int i = 0; i < num_folds; i++) {
+    const VectorXi& fold_indices = cv_folds[i];
+    fold_predictions[i].resize(fold_indices.size());
+    for (int j = 0; j < fold_indices.size(); j++)
+      fold_predictions[i](j) =
+          response(fold_indices(j), 0) -
+          full_gp.responseScaleFactor * fold_residuals[i](j);
+  }
+  return true;
 }
 
 void GaussianProcess::default_options() {
@@ -625,8 +720,14 @@ void GaussianProcess::default_options() {
                            "local optimizer number of initial iterates");
   defaultConfigOptions.set("gp seed", 42,
                            "random seed for initial iterate generation");
+  defaultConfigOptions.set("num threads", 0,
+                           "threads for the optimizer restarts (0: the "
+                           "thread budget of the caller)");
   defaultConfigOptions.set("standardize response", true,
                            "Make the response zero mean and unit variance");
+  defaultConfigOptions.set("fixed hyperparameter cross validation", false,
+                           "cross-validate at the hyperparameters estimated "
+                           "from all samples instead of refitting each fold");
   /* Verbosity levels
      2 - maximum level: print out config options and building notification
      1 - minimum level: print out building notification
@@ -658,63 +759,95 @@ void GaussianProcess::default_options() {
       "verbosity", 1, "console output verbosity");
 }
 
-void GaussianProcess::compute_build_dists() {
-  cwiseDists2.resize(numVariables);
+void GaussianProcess::compute_build_gram(bool compute_derivs,
+                                         MLEWorkspace& workspace) const {
+  workspace.kernel->compute_symmetric_gram(
+      scaledBuildPoints, workspace.thetaValues, workspace.GramMatrix);
+  if (compute_derivs)
+    workspace.kernel->compute_length_scale_factor(
+        workspace.GramMatrix, workspace.thetaValues,
+        workspace.GramLengthScaleFactor);
+  add_nugget_terms(workspace.estimatedNuggetValue, workspace.GramMatrix);
+}
 
-  for (int k = 0; k < numVariables; k++) {
-    cwiseDists2[k].resize(numSamples, numSamples);
-    for (int i = 0; i < numSamples; i++) {
-      for (int j = i; j < numSamples; j++) {
-        cwiseDists2[k](i, j) =
-            pow(scaledBuildPoints(i, k) - scaledBuildPoints(j, k), 2);
-        if (i != j) cwiseDists2[k](j, i) = cwiseDists2[k](i, j);
-      }
-    }
-  }
+void GaussianProcess::initialize_mle_workspace(MLEWorkspace& workspace) const {
+  workspace.thetaValues.resize(numVariables + 1);
+  workspace.betaValues.resize(numPolyTerms);
+  workspace.estimatedNuggetValue = 0.0;
+  workspace.GramMatrix.resize(numSamples, numSamples);
+  workspace.GramLengthScaleFactor.resize(numSamples, numSamples);
+  workspace.kernel = kernel_factory(kernel_type);
+}
+
+int GaussianProcess::num_mle_threads(const int num_restarts) const {
+  int num_threads = configOptions.get<int>("num threads");
+  if (num_threads < 0)
+    throw(std::runtime_error(
+        "Gaussian Process \"num threads\" must be non-negative."));
+  if (num_threads == 0)
+    return util::num_threads(std::max(1, num_restarts), num_restarts, 1);
+  return std::max(1, std::min(num_threads, num_restarts));
 }
 
 void GaussianProcess::compute_pred_dists(const MatrixXd& scaled_pred_pts) {
   const int num_pred_pts = scaled_pred_pts.rows();
   cwiseMixedDists.resize(numVariables);
   cwiseMixedDists2.resize(numVariables);
-  cwisePredDists2.resize(numVariables);
 
   for (int k = 0; k < numVariables; k++) {
-    cwiseMixedDists[k].resize(num_pred_pts, numSamples);
-    cwisePredDists2[k].resize(num_pred_pts, num_pred_pts);
-    for (int i = 0; i < num_pred_pts; i++) {
-      for (int j = 0; j < numSamples; j++) {
-        cwiseMixedDists[k](i, j) =
-            scaled_pred_pts(i, k) - scaledBuildPoints(j, k);
-      }
-      for (int j = i; j < num_pred_pts; j++) {
-        cwisePredDists2[k](i, j) =
-            pow(scaled_pred_pts(i, k) - scaled_pred_pts(j, k), 2);
-        if (i != j) cwisePredDists2[k](j, i) = cwisePredDists2[k](i, j);
-      }
-    }
+    cwiseMixedDists[k] =
+        scaled_pred_pts.col(k).rowwise().replicate(numSamples) -
+        scaledBuildPoints.col(k).transpose().colwise().replicate(num_pred_pts);
     cwiseMixedDists2[k] = cwiseMixedDists[k].array().square();
   }
 }
 
+void GaussianProcess::compute_mixed_dists2(
+    const MatrixXd& scaled_pred_pts,
+    std::vector<MatrixXd>& mixed_dists2) const {
+  const int num_pred_pts = scaled_pred_pts.rows();
+  mixed_dists2.resize(numVariables);
+  for (int k = 0; k < numVariables; k++) {
+    mixed_dists2[k] =
+        (scaled_pred_pts.col(k).rowwise().replicate(numSamples) -
+         scaledBuildPoints.col(k).transpose().colwise().replicate(num_pred_pts))
+            .array()
+            .square();
+  }
+}
+
+int GaussianProcess::prediction_block_size(const int num_pred_pts) const {
+  const int block_size = std::max(1, predBlockEntries / std::max(1, numSamples));
+  return std::max(1, std::min(block_size, num_pred_pts));
+}
+
+void GaussianProcess::compute_best_chol_fact() {
+  kernel->compute_symmetric_gram(scaledBuildPoints, thetaValues, GramMatrix);
+  add_nugget_terms(estimatedNuggetValue, GramMatrix);
+  CholFact.compute(GramMatrix);
+  if (estimateTrend)
+    alphaValues = CholFact.solve(targetValues - basisMatrix * betaValues);
+  else
+    alphaValues = CholFact.solve(targetValues);
+  hasBestCholFact = true;
+}
+
 void GaussianProcess::compute_gram(const std::vector<MatrixXd>& dists2,
-                                   bool add_nugget, bool compute_derivs,
-                                   MatrixXd& gram) {
+                                   bool add_nugget, MatrixXd& gram) {
   const int num_rows = dists2[0].rows();
   const int num_cols = dists2[0].cols();
   gram.resize(num_rows, num_cols);
   kernel->compute_gram(dists2, thetaValues, gram);
 
-  if (compute_derivs)
-    kernel->compute_gram_derivs(gram, dists2, thetaValues, GramMatrixDerivs);
-
-  if (add_nugget) {
-    /* add in the fixed nugget */
-    gram.diagonal().array() += fixedNuggetValue;
-    /* add in the estimated nugget */
-    if (estimateNugget)
-      gram.diagonal().array() += exp(2.0 * estimatedNuggetValue);
-  }
+  if (add_nugget) add_nugget_terms(estimatedNuggetValue, gram);
+}
+
+void GaussianProcess::add_nugget_terms(const double estimated_nugget,
+                                       MatrixXd& gram) const {
+  /* add in the fixed nugget */
+  gram.diagonal().array() += fixedNuggetValue;
+  /* add in the estimated nugget */
+  if (estimateNugget) gram.diagonal().array() += exp(2.0 * estimated_nugget);
 }
 
 void GaussianProcess::generate_initial_guesses(
@@ -18,6 +18,7 @@
 
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 namespace dakota {
 
@@ -40,7 +41,12 @@ namespace surrogates {
  *  marginal log-likelihood function. ROL's implementation of
  *  L-BFGS-B is used to solve the optimization problem, and the
  *  algorithm may be run from multiple random initial guesses
- *  to increase the chance of finding the global minimum.
+ *  to increase the chance of finding the global minimum. The
+ *  restarts are independent and run concurrently on up to
+ *  "num threads" threads.  The default of 0 uses the calling
+ *  thread's budget from dakota::util::thread_budget(), which divides
+ *  the hardware threads among the MPI ranks on a node and among
+ *  enclosing threaded loops such as cross-validation folds.
  *
  *  Once the GP is constructed its mean, variance,
  *  and covariance matrix can be computed for a set of prediction
@@ -203,6 +209,34 @@ class GaussianProcess : public Surrogate {
     return variance(eval_points, 0);
   }
 
+  /**
+   *  \brief Hyperparameters and Gram matrix storage for evaluations of
+   *  the negative marginal log-likelihood. Each concurrent MLE restart
+   *  owns one, so the restarts share no mutable state.
+   */
+  struct MLEWorkspace {
+    /// Vector of log-space hyperparameters.
+    VectorXd thetaValues;
+    /// Vector of polynomial coefficients.
+    VectorXd betaValues;
+    /// Estimated nugget term.
+    double estimatedNuggetValue = 0.0;
+    /// Gram matrix for the build points.
+    MatrixXd GramMatrix;
+    /// Factor F of the Gram matrix derivatives w.r.t. the length-scale
+    /// hyperparameters, dK/dtheta_k = F .* D2_k exp(-2 theta_k); the
+    /// component-wise squared distances D2_k are not stored.
+    MatrixXd GramLengthScaleFactor;
+    /// Pivoted Cholesky factorization of GramMatrix.
+    Eigen::LDLT<MatrixXd> CholFact;
+    /// Difference between target values and trend predictions.
+    VectorXd trendTargetResidual;
+    /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
+    VectorXd GramResidualSolution;
+    /// Kernel (holds its own scaled distance storage).
+    std::shared_ptr<Kernel> kernel;
+  };
+
   /**
    *  \brief Evaluate the negative marginal loglikelihood and its
    *  gradient.
@@ -210,10 +244,12 @@ class GaussianProcess : public Surrogate {
    *  \param[in] compute_gram Flag for various Gram matrix calculations.
    *  \param[out] obj_value Value of the objection function.
    *  \param[out] obj_gradient Gradient of the objective function.
+   *  \param[in,out] workspace Hyperparameters and Gram matrix storage.
    */
   void negative_marginal_log_likelihood(bool compute_grad, bool compute_gram,
                                         double& obj_value,
-                                        VectorXd& obj_gradient);
+                                        VectorXd& obj_gradient,
+                                        MLEWorkspace& workspace) const;
 
   /**
    *  \brief Initialize the hyperparameter bounds for MLE from
@@ -235,7 +271,7 @@ class GaussianProcess : public Surrogate {
    *  \returns Number of total optimization variables (hyperparameters + trend
    * coefficients + nugget)
    */
-  int get_num_opt_variables();
+  int get_num_opt_variables() const;
 
   /**
    *  \brief Get the dimension of the feature space.
@@ -268,8 +304,10 @@ class GaussianProcess : public Surrogate {
   /**
    *  \brief Update the vector of optimization parameters.
    *  \param[in] opt_params Vector of optimization parameter values.
+   *  \param[out] workspace Workspace whose hyperparameters are set.
    */
-  void set_opt_params(const std::vector<double>& opt_params);
+  void set_opt_params(const std::vector<double>& opt_params,
+                      MLEWorkspace& workspace) const;
 
   std::shared_ptr<Surrogate> clone() const override {
     return std::make_shared<GaussianProcess>(configOptions);
@@ -281,27 +319,98 @@ class GaussianProcess : public Surrogate {
   /// Construct and populate the defaultConfigOptions.
   void default_options() override;
 
-  /// Compute squared distances between the scaled build points.
-  void compute_build_dists();
+  /**
+   *  \brief Held-out predictions of K-folds cross-validation at the
+   *  hyperparameters of the GP built on all samples, if the
+   *  "fixed hyperparameter cross validation" option is set.
+   *
+   *  With the hyperparameters (and trend coefficients) held fixed, the
+   *  residuals at fold F of the GP conditioned on the remaining folds are
+   *  [(K^{-1})_FF]^{-1} (K^{-1} (y - H beta))_F, so a single MLE fit
+   *  replaces the per-fold fits.
+   *  \param[in] samples Matrix of data for surrogate construction -
+   *  (num_samples by num_features).
+   *  \param[in] response Vector of targets - (num_samples by 1).
+   *  \param[in] cv_folds Sample indices of each fold.
+   *  \param[out] fold_predictions Predictions at the samples of each fold.
+   *  \returns Whether the closed form was used.
+   */
+  bool cross_validation_predictions(
+      const MatrixXd& samples, const MatrixXd& response,
+      const std::vector<VectorXi>& cv_folds,
+      std::vector<VectorXd>& fold_predictions) override;
+
+  /**
+   *  \brief Compute the Gram matrix (with nugget terms) of the scaled build
+   *  points directly from their coordinates, optionally with the factor
+   *  needed for its length-scale derivatives.
+   *  \param[in] compute_derivs Bool for whether or not to compute
+   *  GramLengthScaleFactor.
+   *  \param[in,out] workspace Hyperparameters and Gram matrix storage.
+   */
+  void compute_build_gram(bool compute_derivs, MLEWorkspace& workspace) const;
 
   /**
-   *  \brief Compute distances between build and prediction points. This
-   * includes build-prediction and prediction-prediction distance matrices.
+   *  \brief Size a workspace for the build data and give it its own
+   *  kernel instance.
+   *  \param[out] workspace Workspace to initialize.
+   */
+  void initialize_mle_workspace(MLEWorkspace& workspace) const;
+
+  /**
+   *  \brief Number of threads over which the MLE restarts are spread.
+   *  \param[in] num_restarts Number of restarts for the optimizer.
+   *  \returns Value of "num threads" (or the thread budget of the
+   *  calling thread if zero), limited to num_restarts.
+   */
+  int num_mle_threads(const int num_restarts) const;
+
+  /**
+   *  \brief Compute signed and squared component-wise distances between
+   *  prediction and build points.
    *  \param[in] scaled_pred_pts Matrix of scaled prediction points.
    */
   void compute_pred_dists(const MatrixXd& scaled_pred_pts);
 
+  /**
+   *  \brief Compute squared component-wise distances between a block of
+   *  prediction points and the build points.
+   *  \param[in] scaled_pred_pts Matrix of scaled prediction points.
+   *  \param[out] mixed_dists2 Vector of squared distance matrices.
+   */
+  void compute_mixed_dists2(const MatrixXd& scaled_pred_pts,
+                            std::vector<MatrixXd>& mixed_dists2) const;
+
+  /**
+   *  \brief Number of prediction points processed per block by the
+   *  streaming value and variance evaluations.
+   *  \param[in] num_pred_pts Total number of prediction points.
+   *  \returns Rows per block, sized so that one block of mixed Gram
+   *  entries stays cache resident.
+   */
+  int prediction_block_size(const int num_pred_pts) const;
+
+  /// Form the Gram matrix and Cholesky factorization for the best
+  /// hyperparameters and cache the prediction weights (alphaValues).
+  void compute_best_chol_fact();
+
   /**
    *  \brief Compute a Gram matrix given a vector of squared distances and
-   *  optionally compute its derivatives and/or adds nugget terms.
+   *  optionally add nugget terms.
    *  \param[in] dists2 Vector of squared distance matrices.
    *  \param[in] add_nugget Bool for whether or add nugget terms.
-   *  \param[in] compute_derivs Bool for whether or not to compute the
-   *  derivatives of the Gram matrix.
    *  \param[out] gram Gram matrix.
    */
   void compute_gram(const std::vector<MatrixXd>& dists2, bool add_nugget,
-                    bool compute_derivs, MatrixXd& gram);
+                    MatrixXd& gram);
+
+  /**
+   *  \brief Add the fixed and estimated nugget terms to the diagonal of a
+   *  Gram matrix.
+   *  \param[in] estimated_nugget Log-space estimated nugget value.
+   *  \param[in,out] gram Gram matrix.
+   */
+  void add_nugget_terms(const double estimated_nugget, MatrixXd& gram) const;
 
   /**
    *  \brief Randomly generate initial guesses for the optimization routine.
@@ -374,17 +483,8 @@ class GaussianProcess : public Surrogate {
   /// Gram matrix for the build points
   MatrixXd GramMatrix;
 
-  /// Difference between target values and trend predictions.
-  VectorXd trendTargetResidual;
-
-  /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
-  VectorXd GramResidualSolution;
-
-  /// Derivatives of the Gram matrix w.r.t. the hyperparameters.
-  std::vector<MatrixXd> GramMatrixDerivs;
-
-  /// Squared component-wise distances between points in the surrogate dataset.
-  std::vector<MatrixXd> cwiseDists2;
+  /// Prediction weights K^{-1} (y - H beta) for the best hyperparameters.
+  VectorXd alphaValues;
 
   /// Component-wise distances between prediction and build points.
   std::vector<MatrixXd> cwiseMixedDists;
@@ -392,9 +492,6 @@ class GaussianProcess : public Surrogate {
   /// Squared component-wise distances between prediction and build points.
   std::vector<MatrixXd> cwiseMixedDists2;
 
-  /// Component-wise distances between prediction points.
-  std::vector<MatrixXd> cwisePredDists2;
-
   /// Pivoted Cholesky factorization.
   Eigen::LDLT<MatrixXd> CholFact;
 
@@ -443,6 +540,9 @@ class GaussianProcess : public Surrogate {
   /// Final objective function value.
   double bestObjFunValue = std::numeric_limits<double>::max();
 
+  /// Target number of mixed Gram entries per prediction block.
+  const int predBlockEntries = 1 << 16;
+
   /// Numerical constant -- needed for negative marginal log-likelihood.
   const double PI = 3.14159265358979323846;
 
@@ -457,12 +557,15 @@ class GaussianProcess : public Surrogate {
 
 template <class Archive>
 void GaussianProcess::serialize(Archive& archive, const unsigned int version) {
-  silence_unused_args(version);
-
   archive& boost::serialization::base_object<Surrogate>(*this);
 
   // BMA: Initial cut is aggressive, serializing most members
-  archive& cwiseDists2;
+  // Version 0 stored the component-wise squared build distances, which
+  // are no longer needed
+  if (version < 1) {
+    std::vector<MatrixXd> cw_dists2;
+    archive& cw_dists2;
+  }
   archive& thetaValues;
   archive& fixedNuggetValue;
   archive& estimateNugget;
@@ -500,5 +603,6 @@ void GaussianProcess::serialize(Archive& archive, const unsigned int version) {
 }  // namespace dakota
 
 BOOST_CLASS_EXPORT_KEY(dakota::surrogates::GaussianProcess)
+BOOST_CLASS_VERSION(dakota::surrogates::GaussianProcess, 1)
 
 #endif  // include guard
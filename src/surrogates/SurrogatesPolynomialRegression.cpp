@@ -10,6 +10,11 @@
 #include "SurrogatesPolynomialRegression.hpp"
 
 #include "surrogates_tools.hpp"
+#include "util_threads.hpp"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
 
 namespace dakota {
 namespace surrogates {
@@ -59,18 +64,90 @@ PolynomialRegression::~PolynomialRegression() {}
 void PolynomialRegression::compute_basis_matrix(const MatrixXd& samples,
                                                 MatrixXd& basis_matrix) const {
   const int num_samples = samples.rows();
-  basis_matrix = MatrixXd::Zero(num_samples, numTerms);
-  double val;
+  basis_matrix.resize(num_samples, numTerms);
+  /* the recurrence is unavailable only if basisIndices was set without
+   * compute_basis_recurrence(); then every term is a product of powers */
+  const bool use_recurrence = (basisEvalOrder.size() == numTerms);
+  /* rows per cache block, and minimum rows per thread */
+  const int block_rows = 256, thread_rows = 4096;
+
+  /* Each term is its parent term (one degree lower) times one variable,
+   * so a block of rows costs one vectorized multiply per term. Terms
+   * without a parent are products of powers of the variables. */
+  auto fill_rows = [&](const int row_begin, const int row_end) {
+    for (int start = row_begin; start < row_end; start += block_rows) {
+      const int num_rows = std::min(block_rows, row_end - start);
+      for (int k = 0; k < numTerms; ++k) {
+        const int j = use_recurrence ? basisEvalOrder(k) : k;
+        auto term_block = basis_matrix.col(j).segment(start, num_rows);
+        auto term = term_block.array();
+        const int parent = use_recurrence ? basisParentTerms(j) : -1;
+        if (parent >= 0) {
+          const int d = basisParentDims(j);
+          term = basis_matrix.col(parent).segment(start, num_rows).array() *
+                 samples.col(d).segment(start, num_rows).array();
+        } else {
+          term.setOnes();
+          for (int d = 0; d < numVariables; ++d) {
+            const int exponent = basisIndices(d, j);
+            if (exponent == 1)
+              term *= samples.col(d).segment(start, num_rows).array();
+            else if (exponent > 1)
+              term *=
+                  samples.col(d).segment(start, num_rows).array().pow(exponent);
+          }
+        }
+      }
+    }
+  };
+
+  /* large sample sets are split into contiguous row ranges per thread */
+  const int num_threads = util::num_threads(num_samples, num_samples,
+                                            thread_rows);
+  util::run_threads(num_threads, [&](const int t) {
+    fill_rows(num_samples * t / num_threads,
+              num_samples * (t + 1) / num_threads);
+  });
+}
 
+void PolynomialRegression::compute_basis_recurrence() {
+  /* look up each term's multi-index to find the term with the exponent of
+   * one variable decremented */
+  std::map<std::vector<int>, int> term_map;
+  std::vector<int> term_index(numVariables);
   for (int j = 0; j < numTerms; ++j) {
-    for (int i = 0; i < num_samples; ++i) {
-      val = 1.0;
-      for (int d = 0; d < numVariables; ++d) {
-        val *= std::pow(samples(i, d), basisIndices(d, j));
+    for (int d = 0; d < numVariables; ++d) term_index[d] = basisIndices(d, j);
+    term_map.emplace(term_index, j);
+  }
+
+  basisParentTerms = VectorXi::Constant(numTerms, -1);
+  basisParentDims = VectorXi::Constant(numTerms, -1);
+  VectorXi degrees(numTerms);
+  for (int j = 0; j < numTerms; ++j) {
+    for (int d = 0; d < numVariables; ++d) term_index[d] = basisIndices(d, j);
+    degrees(j) = basisIndices.col(j).sum();
+    for (int d = numVariables - 1; d >= 0; --d) {
+      if (term_index[d] > 0) {
+        --term_index[d];
+        auto parent = term_map.find(term_index);
+        ++term_index[d];
+        if (parent != term_map.end()) {
+          basisParentTerms(j) = parent->second;
+          basisParentDims(j) = d;
+          break;
+        }
       }
-      basis_matrix(i, j) = val;
     }
   }
+
+  /* evaluate the terms by increasing degree so parents precede children */
+  std::vector<int> eval_order(numTerms);
+  std::iota(eval_order.begin(), eval_order.end(), 0);
+  std::stable_sort(eval_order.begin(), eval_order.end(),
+                   [&degrees](const int a, const int b) {
+                     return degrees(a) < degrees(b);
+                   });
+  basisEvalOrder = Eigen::Map<VectorXi>(eval_order.data(), numTerms);
 }
 
 void PolynomialRegression::build(const MatrixXd& samples,
@@ -93,15 +170,8 @@ void PolynomialRegression::build(const MatrixXd& samples,
   numSamples = samples.rows();
   numVariables = samples.cols();
 
-  int max_degree = configOptions.get<int>("max degree");
-  double p_norm = configOptions.get<double>("p-norm");
-  bool use_reduced_basis = configOptions.get<bool>("reduced basis");
   bool standardize_response = configOptions.get<bool>("standardize response");
-  if (use_reduced_basis)
-    compute_reduced_indices(numVariables, max_degree, basisIndices);
-  else
-    compute_hyperbolic_indices(numVariables, max_degree, p_norm, basisIndices);
-  numTerms = basisIndices.cols();
+  compute_basis_indices();
 
   /* Standardize the response */
   MatrixXd scaled_response;
@@ -138,6 +208,84 @@ void PolynomialRegression::build(const MatrixXd& samples,
       scaled_response.mean() - (scaled_basis_matrix * polynomialCoeffs).mean();
 }
 
+void PolynomialRegression::compute_basis_indices() {
+  int max_degree = configOptions.get<int>("max degree");
+  double p_norm = configOptions.get<double>("p-norm");
+  bool use_reduced_basis = configOptions.get<bool>("reduced basis");
+  if (use_reduced_basis)
+    compute_reduced_indices(numVariables, max_degree, basisIndices);
+  else
+    compute_hyperbolic_indices(numVariables, max_degree, p_norm, basisIndices);
+  numTerms = basisIndices.cols();
+  compute_basis_recurrence();
+}
+
+bool PolynomialRegression::cross_validation_predictions(
+    const MatrixXd& samples, const MatrixXd& response,
+    const std::vector<VectorXi>& cv_folds,
+    std::vector<VectorXd>& fold_predictions) {
+  configOptions.validateParametersAndSetDefaults(defaultConfigOptions);
+  SOLVER_TYPE solver_type = util::LinearSolverBase::solver_type(
+      configOptions.get<std::string>("regression solver type"));
+  SCALER_TYPE scaler_type = util::DataScaler::scaler_type(
+      configOptions.get<std::string>("scaler type"));
+  /* min-max normalization shifts the basis without fitting an intercept,
+   * so its fit is not a projection onto the span of the basis */
+  if ((solver_type != SOLVER_TYPE::SVD_LEAST_SQ_REGRESSION &&
+       solver_type != SOLVER_TYPE::QR_LEAST_SQ_REGRESSION &&
+       solver_type != SOLVER_TYPE::CHOLESKY) ||
+      scaler_type == SCALER_TYPE::MINMAX_NORMALIZATION)
+    return false;
+
+  /* basis matrix for all samples, from a separate instance so that the
+   * state of *this is unchanged */
+  PolynomialRegression cv_poly(configOptions);
+  cv_poly.numVariables = samples.cols();
+  cv_poly.compute_basis_indices();
+  MatrixXd basis_matrix;
+  cv_poly.compute_basis_matrix(samples, basis_matrix);
+
+  /* the fit is the projection onto the span of the basis and the constant;
+   * standardize the columns so that the rank is well determined */
+  const int num_samples = samples.rows();
+  const int num_terms = basis_matrix.cols();
+  MatrixXd design_matrix(num_samples, num_terms + 1);
+  design_matrix.col(0).setOnes();
+  for (int j = 0; j < num_terms; j++) {
+    VectorXd centered =
+        basis_matrix.col(j).array() - basis_matrix.col(j).mean();
+    const double col_norm = centered.norm();
+    design_matrix.col(j + 1) =
+        (col_norm > 1.0e-12 * basis_matrix.col(j).norm())
+            ? VectorXd(centered / col_norm)
+            : VectorXd::Zero(num_samples);
+  }
+  Eigen::ColPivHouseholderQR<MatrixXd> design_qr(design_matrix);
+  const int rank = design_qr.rank();
+  MatrixXd range_basis = design_qr.householderQ() *
+                         MatrixXd::Identity(num_samples, rank);
+  MatrixXd residual_maker = -range_basis * range_basis.transpose();
+  residual_maker.diagonal().array() += 1.0;
+
+  /* the hat matrix is invariant to the affine response standardization */
+  const VectorXd residuals = residual_maker * response.col(0);
+  std::vector<VectorXd> fold_residuals;
+  if (!fold_block_residuals(residual_maker, residuals, cv_folds,
+                            fold_residuals))
+    return false;
+
+  const int num_folds = cv_folds.size();
+  fold_predictions.resize(num_folds);
+  for (int i = 0; i < num_folds; i++) {
+    const VectorXi& fold_indices = cv_folds[i];
+    fold_predictions[i].resize(fold_indices.size());
+    for (int j = 0; j < fold_indices.size(); j++)
+      fold_predictions[i](j) =
+          response(fold_indices(j), 0) - fold_residuals[i](j);
+  }
+  return true;
+}
+
 VectorXd PolynomialRegression::value(const MatrixXd& eval_points,
                                      const int qoi) {
   /* Surrogate models don't yet support multiple responses */
@@ -186,9 +186,46 @@ class PolynomialRegression : public Surrogate {
   /// Construct and populate the defaultConfigOptions.
   void default_options() override;
 
+  /// Compute basisIndices and numTerms for numVariables variables from
+  /// the configuration options.
+  void compute_basis_indices();
+
+  /// Compute the parent terms and evaluation order used by
+  /// compute_basis_matrix from basisIndices.
+  void compute_basis_recurrence();
+
+  /**
+   *  \brief Held-out predictions of K-folds cross-validation from the
+   *  hat matrix H of the least-squares fit to all samples.
+   *
+   *  The residuals at fold F of the fit to the remaining folds are
+   *  (I - H_FF)^{-1} e_F, where e are the residuals of the full fit
+   *  (the PRESS residuals for leave-one-out). This is exact for the
+   *  least-squares solvers (SVD, QR, Cholesky) with the scaler types
+   *  that preserve the span of the basis and the constant, and is
+   *  skipped otherwise.
+   *  \param[in] samples Matrix of data for surrogate construction -
+   *  (num_samples by num_features).
+   *  \param[in] response Vector of targets - (num_samples by 1).
+   *  \param[in] cv_folds Sample indices of each fold.
+   *  \param[out] fold_predictions Predictions at the samples of each fold.
+   *  \returns Whether the closed form applies.
+   */
+  bool cross_validation_predictions(
+      const MatrixXd& samples, const MatrixXd& response,
+      const std::vector<VectorXi>& cv_folds,
+      std::vector<VectorXd>& fold_predictions) override;
+
   /// Matrix that specifies the powers of each variable for each term
   /// in the polynomial - (numVariables by numTerms).
   MatrixXi basisIndices;
+  /// Term whose product with one variable gives each term, or -1 if the
+  /// term is evaluated as a product of powers - (numTerms).
+  VectorXi basisParentTerms;
+  /// Variable multiplying the parent term of each term - (numTerms).
+  VectorXi basisParentDims;
+  /// Order of evaluation of the terms, by increasing degree - (numTerms).
+  VectorXi basisEvalOrder;
   /// Linear solver for the ordinary least squares problem.
   std::shared_ptr<util::LinearSolverBase> linearSolver;
 
@@ -216,6 +253,7 @@ void PolynomialRegression::serialize(Archive& archive,
   archive& boost::serialization::base_object<Surrogate>(*this);
   archive& numTerms;
   archive& basisIndices;
+  if (Archive::is_loading::value) compute_basis_recurrence();
   archive& polynomialCoeffs;
   archive& polynomialIntercept;
   archive& verbosity;
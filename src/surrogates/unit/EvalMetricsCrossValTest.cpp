@@ -9,6 +9,7 @@
 
 #include "SurrogatesGaussianProcess.hpp"
 #include "SurrogatesPolynomialRegression.hpp"
+#include "util_math_tools.hpp"
 
 #define BOOST_TEST_MODULE surrogates_EvalMetricsCrossValTest
 #include <boost/test/included/unit_test.hpp>
@@ -156,3 +157,144 @@ BOOST_AUTO_TEST_CASE(test_surrogates_cross_validate) {
   cv_diff = (cross_val_metrics - gold_gp_cv_metrics).norm();
   BOOST_CHECK(cv_diff < cv_norm_difftol);
 }
+
+BOOST_AUTO_TEST_CASE(test_surrogates_closed_form_cross_validate) {
+  /* The closed-form (hat matrix) cross-validation of a least-squares
+   * polynomial must match rebuilding the polynomial for each fold */
+  const double cv_difftol = 1.0e-10;
+  const int cv_seed = 33;
+  const int num_samples = 14;
+
+  MatrixXd build_pts(num_samples, 1);
+  MatrixXd target(num_samples, 1);
+
+  build_pts << 0.37454012, 0.95071431, 0.73199394, 0.59865848, 0.15601864,
+      0.15599452, 0.05808361, 0.86617615, 0.60111501, 0.70807258, 0.02058449,
+      0.96990985, 0.83244264, 0.21233911;
+
+  target << 0.38431047, 1.26568441, 0.97051622, 0.55068725, -0.00673642,
+      0.10949948, -0.04185002, 1.19770533, 0.65484831, 0.76738892, 0.16731886,
+      1.32362227, 1.11637976, 0.08789945;
+
+  ParameterList quad_poly_pl("Quadratic Test Parameters");
+  quad_poly_pl.set("max degree", 2);
+  quad_poly_pl.set("scaler type", "standardization");
+  quad_poly_pl.set("standardize response", true);
+  quad_poly_pl.set("verbosity", 0);
+  PolynomialRegression quad_poly(quad_poly_pl);
+
+  StringArray metrics_names = {"mean_squared", "mean_abs", "max_abs"};
+  /* 4-fold and leave-one-out */
+  for (const int num_folds : {4, num_samples}) {
+    VectorXd cross_val_metrics = quad_poly.cross_validate(
+        build_pts, target, metrics_names, num_folds, cv_seed);
+
+    std::vector<VectorXi> cv_folds;
+    create_cv_folds(num_folds, num_samples, cv_folds, cv_seed);
+    VectorXd rebuilt_metrics = VectorXd::Zero(metrics_names.size());
+    for (int i = 0; i < num_folds; i++) {
+      const int num_val = cv_folds[i].size();
+      MatrixXd val_pts(num_val, 1), val_target(num_val, 1);
+      MatrixXd train_pts(num_samples - num_val, 1),
+          train_target(num_samples - num_val, 1);
+      int val_index = 0, train_index = 0;
+      for (int j = 0; j < num_samples; j++) {
+        if ((cv_folds[i].array() == j).any()) {
+          val_pts(val_index, 0) = build_pts(j, 0);
+          val_target(val_index++, 0) = target(j, 0);
+        } else {
+          train_pts(train_index, 0) = build_pts(j, 0);
+          train_target(train_index++, 0) = target(j, 0);
+        }
+      }
+      PolynomialRegression fold_poly(train_pts, train_target, quad_poly_pl);
+      rebuilt_metrics +=
+          fold_poly.evaluate_metrics(metrics_names, val_pts, val_target);
+    }
+    rebuilt_metrics /= double(num_folds);
+
+    BOOST_CHECK((cross_val_metrics - rebuilt_metrics).norm() < cv_difftol);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_fixed_hyperparameter_cross_validate) {
+  /* The closed-form GP cross-validation at the hyperparameters of the full
+   * fit must match rebuilding the GP for each fold with the MLE pinned to
+   * those hyperparameters (bounds collapsed to them) */
+  const double cv_difftol = 1.0e-8;
+  const int cv_seed = 33;
+  const int num_samples = 14;
+
+  MatrixXd build_pts(num_samples, 1);
+  MatrixXd target(num_samples, 1);
+
+  build_pts << 0.37454012, 0.95071431, 0.73199394, 0.59865848, 0.15601864,
+      0.15599452, 0.05808361, 0.86617615, 0.60111501, 0.70807258, 0.02058449,
+      0.96990985, 0.83244264, 0.21233911;
+
+  target << 0.38431047, 1.26568441, 0.97051622, 0.55068725, -0.00673642,
+      0.10949948, -0.04185002, 1.19770533, 0.65484831, 0.76738892, 0.16731886,
+      1.32362227, 1.11637976, 0.08789945;
+
+  /* unscaled data, so the hyperparameters mean the same for every fold */
+  ParameterList gp_opts;
+  gp_opts.set("scaler name", "none");
+  gp_opts.set("standardize response", false);
+  gp_opts.sublist("Nugget").set("fixed nugget", 1.0e-8);
+  gp_opts.set("num restarts", 10);
+  gp_opts.set("verbosity", 0);
+
+  /* hyperparameters of the full fit: the first best restart */
+  GaussianProcess full_gp(build_pts, target, gp_opts);
+  const VectorXd obj_values = full_gp.get_objective_function_history();
+  int best_restart = 0;
+  for (int i = 1; i < obj_values.size(); i++)
+    if (obj_values(i) < obj_values(best_restart)) best_restart = i;
+  const VectorXd log_theta = full_gp.get_theta_history().row(best_restart);
+
+  ParameterList fixed_opts(gp_opts);
+  fixed_opts.set("num restarts", 1);
+  fixed_opts.sublist("Sigma Bounds").set("lower bound", std::exp(log_theta(0)));
+  fixed_opts.sublist("Sigma Bounds").set("upper bound", std::exp(log_theta(0)));
+  fixed_opts.sublist("Length-scale Bounds")
+      .set("lower bound", std::exp(log_theta(1)));
+  fixed_opts.sublist("Length-scale Bounds")
+      .set("upper bound", std::exp(log_theta(1)));
+
+  ParameterList cv_opts(gp_opts);
+  cv_opts.set("fixed hyperparameter cross validation", true);
+  GaussianProcess cv_gp(cv_opts);
+
+  StringArray metrics_names = {"mean_squared", "mean_abs", "max_abs"};
+  /* 4-fold and leave-one-out */
+  for (const int num_folds : {4, num_samples}) {
+    VectorXd cross_val_metrics = cv_gp.cross_validate(
+        build_pts, target, metrics_names, num_folds, cv_seed);
+
+    std::vector<VectorXi> cv_folds;
+    create_cv_folds(num_folds, num_samples, cv_folds, cv_seed);
+    VectorXd rebuilt_metrics = VectorXd::Zero(metrics_names.size());
+    for (int i = 0; i < num_folds; i++) {
+      const int num_val = cv_folds[i].size();
+      MatrixXd val_pts(num_val, 1), val_target(num_val, 1);
+      MatrixXd train_pts(num_samples - num_val, 1),
+          train_target(num_samples - num_val, 1);
+      int val_index = 0, train_index = 0;
+      for (int j = 0; j < num_samples; j++) {
+        if ((cv_folds[i].array() == j).any()) {
+          val_pts(val_index, 0) = build_pts(j, 0);
+          val_target(val_index++, 0) = target(j, 0);
+        } else {
+          train_pts(train_index, 0) = build_pts(j, 0);
+          train_target(train_index++, 0) = target(j, 0);
+        }
+      }
+      GaussianProcess fold_gp(train_pts, train_target, fixed_opts);
+      rebuilt_metrics +=
+          fold_gp.evaluate_metrics(metrics_names, val_pts, val_target);
+    }
+    rebuilt_metrics /= double(num_folds);
+
+    BOOST_CHECK((cross_val_metrics - rebuilt_metrics).norm() < cv_difftol);
+  }
+}
@@ -11,6 +11,7 @@
 #include "surrogates_tools.hpp"
 #include "util_common.hpp"
 #include "util_data_types.hpp"
+#include "util_math_tools.hpp"
 
 #define BOOST_TEST_MODULE surrogates_GaussianProcessTest
 #include <boost/test/included/unit_test.hpp>
@@ -431,6 +432,33 @@ BOOST_AUTO_TEST_CASE(test_surrogates_2D_gp_no_trend) {
   BOOST_CHECK(relative_allclose(cov, gold_cov, 100 * rel_float_tol));
 }
 
+BOOST_AUTO_TEST_CASE(test_surrogates_2D_gp_threaded_restarts) {
+  MatrixXd samples, length_scale_bounds, eval_pts;
+  VectorXd response, sigma_bounds;
+
+  get_2D_gp_test_data(samples, response, eval_pts);
+  get_gp_hyperparameter_bounds(2, sigma_bounds, length_scale_bounds);
+
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+  param_list.set("num restarts", 15);
+  param_list.sublist("Nugget").set("estimate nugget", true);
+  param_list.sublist("Trend").set("estimate trend", true);
+
+  /* each restart is independent of the thread it runs on, so the
+   * serial and threaded builds must agree exactly */
+  param_list.set("num threads", 1);
+  GaussianProcess gp_serial(samples, response, param_list);
+  param_list.set("num threads", 4);
+  GaussianProcess gp_threaded(samples, response, param_list);
+
+  BOOST_CHECK(gp_serial.get_objective_function_history() ==
+              gp_threaded.get_objective_function_history());
+  BOOST_CHECK(gp_serial.get_theta_history() ==
+              gp_threaded.get_theta_history());
+  BOOST_CHECK(gp_serial.value(eval_pts) == gp_threaded.value(eval_pts));
+}
+
 BOOST_AUTO_TEST_CASE(test_surrogates_2D_gp_with_trend_values_derivs_and_save_load) {
   bool print_output = false;
 
@@ -873,6 +901,41 @@ BOOST_AUTO_TEST_CASE(test_surrogates_matern_52_gp) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_blocked_prediction) {
+  MatrixXd samples, length_scale_bounds, eval_pts;
+  VectorXd response, sigma_bounds;
+
+  get_2D_gp_test_data(samples, response, eval_pts);
+  get_gp_hyperparameter_bounds(2, sigma_bounds, length_scale_bounds);
+
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+  param_list.set("num restarts", 5);
+  param_list.sublist("Trend").set("estimate trend", true);
+
+  GaussianProcess gp(samples, response, param_list);
+
+  /* enough prediction points to span several prediction blocks */
+  const int num_pred_pts = 5000;
+  MatrixXd pred_pts =
+      create_uniform_random_double_matrix(num_pred_pts, 2, 1337, true, -1.0, 1.0);
+
+  const double rel_float_tol = 1.0e-10;
+
+  /* batched mean matches point-by-point evaluation */
+  VectorXd mean = gp.value(pred_pts);
+  const int stride = 997;
+  for (int i = 0; i < num_pred_pts; i += stride)
+    BOOST_CHECK_CLOSE(mean(i), gp.value(pred_pts.row(i))(0),
+                      100.0 * rel_float_tol);
+
+  /* streamed variance matches the diagonal of the full covariance */
+  MatrixXd sub_pts = pred_pts.topRows(50);
+  VectorXd variance = gp.variance(sub_pts);
+  VectorXd cov_diag = gp.covariance(sub_pts).diagonal().cwiseMax(0.0);
+  BOOST_CHECK_SMALL((variance - cov_diag).lpNorm<Eigen::Infinity>(), 1.0e-10);
+}
+
 BOOST_AUTO_TEST_CASE(test_surrogates_gp_read_from_parameterlist) {
   std::string test_parameterlist_file =
       "gp_test_data/GP_test_parameterlist.yaml";
@@ -350,6 +350,46 @@ void PolynomialRegressionSurrogate_parameter_list_import() {
   BOOST_CHECK(matrix_equals(gold_hessian, hessian, 1.0e-9));
 }
 
+void PolynomialRegressionSurrogate_basis_matrix() {
+  /* enough samples to span several row blocks of the basis evaluation */
+  int num_vars = 4, num_samples = 9000, degree = 4;
+
+  MatrixXd samples, responses;
+  get_samples(num_vars, num_samples, samples);
+  another_additive_quadratic_function(samples, responses);
+
+  /* the recurrence-based basis matrix matches direct evaluation of the
+   * monomials for full, hyperbolic cross, and reduced bases */
+  for (int b = 0; b < 3; ++b) {
+    const double p_norm = (b == 1) ? 0.6 : 1.0;
+    const bool reduced_basis = (b == 2);
+    Teuchos::ParameterList config_options("Polynomial Test Parameters");
+    config_options.set("max degree", degree);
+    config_options.set("p-norm", p_norm);
+    config_options.set("reduced basis", reduced_basis);
+    PolynomialRegression pr(samples, responses, config_options);
+
+    MatrixXi basis_indices;
+    if (reduced_basis)
+      compute_reduced_indices(num_vars, degree, basis_indices);
+    else
+      compute_hyperbolic_indices(num_vars, degree, p_norm, basis_indices);
+    MatrixXd gold_basis_matrix(num_samples, basis_indices.cols());
+    for (int j = 0; j < basis_indices.cols(); ++j) {
+      for (int i = 0; i < num_samples; ++i) {
+        double val = 1.0;
+        for (int d = 0; d < num_vars; ++d)
+          val *= std::pow(samples(i, d), basis_indices(d, j));
+        gold_basis_matrix(i, j) = val;
+      }
+    }
+
+    MatrixXd basis_matrix;
+    pr.compute_basis_matrix(samples, basis_matrix);
+    BOOST_CHECK(matrix_equals(gold_basis_matrix, basis_matrix, 1.0e-14));
+  }
+}
+
 /// Create, evaluate, and save a basic polynomial; load and verify
 /// same evals (based on multivariate_regression_builder test)
 void PolynomialRegression_SaveLoad() {
@@ -428,6 +468,7 @@ int test_main(int argc, char* argv[])  // note the name!
   // Multivariate tests
   PolynomialRegressionSurrogate_multivariate_regression_builder();
   PolynomialRegressionSurrogate_gradient_and_hessian();
+  PolynomialRegressionSurrogate_basis_matrix();
 
   // ParameterList import test
   PolynomialRegressionSurrogate_parameter_list_import();
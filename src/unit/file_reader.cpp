@@ -10,7 +10,10 @@
 
 #include "dakota_data_io.hpp"
 #include "dakota_tabular_io.hpp"
+#include "util_threads.hpp"
 
+#include <limits>
+#include <sstream>
 #include <string>
 
 #define BOOST_TEST_MODULE dakota_file_reader
@@ -322,3 +325,134 @@ BOOST_AUTO_TEST_CASE(test_read_bad_data1)
 }
 
 //----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_read_annotated_matrix)
+{
+  const int NUM_ROW = 6;
+  const int NUM_COL = 3;
+  const std::string filename("test_annotated_matrix");
+  RealVectorArray field_data = create_test_array(NUM_ROW, NUM_COL, true);
+
+  // header and eval ID column; well-formed rows take the concurrent
+  // read, which must agree with the stream read of the same data
+  std::ofstream out_file;
+  TabularIO::open_file(out_file, filename, "unit test write");
+  out_file << "%eval_id x1 x2 x3\n" << std::setprecision(17);
+  for( int i=0; i<NUM_ROW; ++i ) {
+    out_file << i+1;
+    for( int j=0; j<NUM_COL; ++j )
+      out_file << "\t" << field_data[i][j];
+    out_file << (i % 2 ? "\r\n" : "\n\n");
+  }
+  out_file.close();
+  used_filenames.push_back(filename);
+
+  RealMatrix test_matrix;
+  TabularIO::read_data_tabular(filename, "unit test annotated_matrix",
+			       test_matrix, NUM_ROW, NUM_COL,
+			       TABULAR_ANNOTATED, false);
+  for( int i=0; i<NUM_ROW; ++i )
+    for( int j=0; j<NUM_COL; ++j )
+      BOOST_CHECK_EQUAL( field_data[i][j], test_matrix(i,j) );
+
+  // a row split over lines is read by the (free-form) stream read
+  const std::string split_filename("test_split_matrix");
+  TabularIO::open_file(out_file, split_filename, "unit test write");
+  out_file << "%eval_id x1 x2 x3\n" << std::setprecision(17);
+  for( int i=0; i<NUM_ROW; ++i ) {
+    out_file << i+1;
+    for( int j=0; j<NUM_COL; ++j )
+      out_file << (j == 1 ? "\n" : " ") << field_data[i][j];
+    out_file << "\n";
+  }
+  out_file.close();
+  used_filenames.push_back(split_filename);
+
+  RealMatrix split_matrix;
+  TabularIO::read_data_tabular(split_filename, "unit test split_matrix",
+			       split_matrix, NUM_ROW, NUM_COL,
+			       TABULAR_ANNOTATED, false);
+  for( int i=0; i<NUM_ROW; ++i )
+    for( int j=0; j<NUM_COL; ++j )
+      BOOST_CHECK_EQUAL( field_data[i][j], split_matrix(i,j) );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_read_matrix_concurrent)
+{
+  // fixed-width rows, with 17 significant digits so values round trip
+  const int NUM_COL = 3;
+  const int ROW_BYTES = 8 + NUM_COL*25 + 1;
+  const size_t BLOCK_BYTES = 1 << 20;  // min_bytes_per_thread
+  const int NUM_THREADS = 4;
+  const int NUM_ROW = 4*13000 + 2;
+  RealVectorArray field_data = create_test_array(NUM_ROW, NUM_COL, true);
+
+  // enough data for NUM_THREADS blocks, with block boundaries falling
+  // within rows rather than at line starts
+  size_t num_bytes = (size_t)NUM_ROW * ROW_BYTES;
+  BOOST_REQUIRE( num_bytes / BLOCK_BYTES >= NUM_THREADS );
+  BOOST_REQUIRE( (num_bytes / NUM_THREADS) % ROW_BYTES != 0 );
+
+  // the second file splits its last row over two lines, so the whole
+  // file is read by the stream reader
+  const std::string filename("test_concurrent_matrix"),
+    split_filename("test_concurrent_split_matrix");
+  for( const std::string& fname : {filename, split_filename} ) {
+    std::ofstream out_file;
+    TabularIO::open_file(out_file, fname, "unit test write");
+    out_file << "%eval_id x1 x2 x3\n"
+	     << std::scientific << std::setprecision(16);
+    for( int i=0; i<NUM_ROW; ++i ) {
+      out_file << std::setw(8) << i+1;
+      for( int j=0; j<NUM_COL; ++j ) {
+	if( fname == split_filename && i == NUM_ROW-1 && j == 1 )
+	  out_file << "\n";
+	out_file << std::setw(25) << field_data[i][j];
+      }
+      out_file << "\n";
+    }
+    out_file.close();
+    used_filenames.push_back(fname);
+  }
+
+  // guarantee the concurrent read regardless of the machine
+  dakota::util::ThreadBudgetScope budget_scope(NUM_THREADS);
+  RealMatrix concurrent_matrix, stream_matrix;
+  TabularIO::read_data_tabular(filename, "unit test concurrent_matrix",
+			       concurrent_matrix, NUM_ROW, NUM_COL,
+			       TABULAR_ANNOTATED, false);
+  TabularIO::read_data_tabular(split_filename, "unit test split_matrix",
+			       stream_matrix, NUM_ROW, NUM_COL,
+			       TABULAR_ANNOTATED, false);
+  int num_mismatches = 0;
+  for( int i=0; i<NUM_ROW; ++i )
+    for( int j=0; j<NUM_COL; ++j )
+      if( concurrent_matrix(i,j) != stream_matrix(i,j) ||
+	  concurrent_matrix(i,j) != field_data[i][j] )
+	++num_mismatches;
+  BOOST_CHECK_EQUAL( num_mismatches, 0 );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_write_tabular_values)
+{
+  RealVector test_vec(8);
+  test_vec.random();
+  test_vec[5] = 1.e+300;
+  test_vec[6] = -2.5e-300;
+  test_vec[7] = std::numeric_limits<Real>::quiet_NaN();
+
+  // buffered formatting must match per-value stream insertion
+  std::ostringstream buffered, inserted;
+  write_data_tabular(buffered, test_vec);
+  inserted << std::setprecision(write_precision)
+	   << std::resetiosflags(std::ios::floatfield);
+  for( int i=0; i<test_vec.length(); ++i )
+    inserted << std::setw(write_precision+4) << test_vec[i] << ' ';
+  BOOST_CHECK_EQUAL( buffered.str(), inserted.str() );
+}
+
+//----------------------------------------------------------------
@@ -0,0 +1,215 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+/** \file model_eval_overhead.cpp Micro-benchmark of the per-evaluation
+    overhead of Model::evaluate() for each model type, using a direct
+    text_book simulation, a global polynomial surrogate, and identity
+    RecastModel chains over each.  Reports timings and verifies that
+    recast chains reproduce the sub-model responses and evaluation ids. */
+
+#include "opt_tpl_test.hpp"
+#include "LibraryEnvironment.hpp"
+#include "RecastModel.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#define BOOST_TEST_MODULE dakota_model_eval_overhead
+#include <boost/test/included/unit_test.hpp>
+
+namespace btt = boost::test_tools;
+
+std::string model_eval_overhead_input = R"(
+environment
+  method_pointer 'SAMP'
+
+method
+  id_method 'SAMP'
+  output silent
+  sampling
+    samples 20
+    seed 5
+  model_pointer 'SURR'
+
+method
+  id_method 'DACE'
+  output silent
+  sampling
+    samples 20
+    seed 7
+  model_pointer 'SIM'
+
+model
+  id_model 'SURR'
+  surrogate global
+    polynomial quadratic
+    dace_method_pointer 'DACE'
+
+model
+  id_model 'SIM'
+  single
+    interface_pointer 'I'
+
+variables
+  uniform_uncertain 2
+    lower_bounds  0.5  0.5
+    upper_bounds  1.5  1.5
+
+interface
+  id_interface 'I'
+  direct
+    analysis_driver = 'text_book'
+  deactivate evaluation_cache restart_file
+
+responses
+  response_functions 3
+  no_gradients
+  no_hessians
+)";
+
+
+/// number of timed evaluations per model
+const size_t num_timed_evals = 5000;
+
+
+/// wrap sub_model in a RecastModel with one-to-one variable and response
+/// mappings, such that only the Model/RecastModel overhead is added
+Dakota::Model identity_recast(const Dakota::Model& sub_model)
+{
+  size_t i, num_cv = sub_model.cv(), num_fns = sub_model.response_size();
+  Dakota::Sizet2DArray vars_map_indices(num_cv),
+    primary_resp_map_indices(num_fns), secondary_resp_map_indices;
+  Dakota::BoolDequeArray nonlinear_resp_mapping(num_fns,
+						Dakota::BoolDeque(1, false));
+  for (i=0; i<num_cv; ++i)
+    vars_map_indices[i].assign(1, i);
+  for (i=0; i<num_fns; ++i)
+    primary_resp_map_indices[i].assign(1, i);
+
+  Dakota::Model recast_model;
+  recast_model.assign_rep(std::make_shared<Dakota::RecastModel>(sub_model,
+    vars_map_indices, Dakota::SizetArray(), Dakota::BitArray(),
+    Dakota::BitArray(), false, sub_model.current_variables().view(), nullptr,
+    nullptr, primary_resp_map_indices, secondary_resp_map_indices, 0, 1,
+    nonlinear_resp_mapping, nullptr, nullptr));
+  return recast_model;
+}
+
+
+/// perform num_timed_evals synchronous evaluations of model at varying
+/// points, returning the mean wall time per evaluation in microseconds
+double time_evaluations(Dakota::Model& model)
+{
+  Dakota::ActiveSet set = model.current_response().active_set();
+  set.request_values(1);
+  Dakota::RealVector x0 = model.continuous_variables(); // copy
+  size_t i, j, num_cv = x0.length();
+
+  model.evaluate(set); // warm up: lazy initializations and allocations
+
+  auto start = std::chrono::steady_clock::now();
+  for (i=0; i<num_timed_evals; ++i) {
+    // vary the point to defeat any duplicate detection
+    for (j=0; j<num_cv; ++j)
+      model.continuous_variable(x0[j] + 1.e-6 * (i % 1000), j);
+    model.evaluate(set);
+  }
+  std::chrono::duration<double, std::micro> elapsed
+    = std::chrono::steady_clock::now() - start;
+  model.continuous_variables(x0);
+
+  return elapsed.count() / num_timed_evals;
+}
+
+
+void report(const std::string& label, double usec_per_eval,
+	    double sub_usec_per_eval = 0.)
+{
+  std::cout << std::setw(36) << std::left << label << std::right
+	    << std::fixed << std::setprecision(3) << std::setw(10)
+	    << usec_per_eval << " us/eval";
+  if (sub_usec_per_eval > 0.)
+    std::cout << "  (+" << usec_per_eval - sub_usec_per_eval
+	      << " us over sub-model)";
+  std::cout << std::endl;
+}
+
+
+/// evaluate recast_model and sub_model at the same point and verify the
+/// recast response and the evaluation id bookkeeping of both
+void check_recast(Dakota::Model& recast_model, Dakota::Model& sub_model)
+{
+  Dakota::ActiveSet set = recast_model.current_response().active_set();
+  set.request_values(1);
+  int recast_id = recast_model.evaluation_id(),
+    sub_id = sub_model.evaluation_id();
+
+  recast_model.evaluate(set);
+  Dakota::RealVector recast_fns = recast_model.current_response().
+    function_values(); // copy
+  BOOST_TEST(recast_model.evaluation_id() == recast_id + 1);
+  BOOST_TEST(sub_model.evaluation_id() == sub_id + 1);
+
+  sub_model.continuous_variables(recast_model.continuous_variables());
+  sub_model.evaluate(set);
+  const Dakota::RealVector& sub_fns
+    = sub_model.current_response().function_values();
+  BOOST_REQUIRE(recast_fns.length() == sub_fns.length());
+  for (int i=0; i<sub_fns.length(); ++i)
+    BOOST_TEST(recast_fns[i] == sub_fns[i], btt::tolerance(1.e-15));
+}
+
+
+BOOST_AUTO_TEST_CASE(test_model_eval_overhead)
+{
+  std::shared_ptr<Dakota::LibraryEnvironment> p_env(
+    Dakota::Opt_TPL_Test::create_env(model_eval_overhead_input));
+  Dakota::LibraryEnvironment& env = *p_env;
+  if (env.parallel_library().mpirun_flag())
+    return; // timings are only meaningful for serial runs
+
+  // builds the surrogate and exercises each model once
+  env.execute();
+
+  Dakota::Model sim_model, surr_model;
+  Dakota::ModelList& models = env.problem_description_db().model_list();
+  for (Dakota::ModelLIter ml_it=models.begin(); ml_it!=models.end(); ++ml_it)
+    if (ml_it->model_id() == "SIM")
+      sim_model = *ml_it;
+    else if (ml_it->model_id() == "SURR")
+      surr_model = *ml_it;
+  BOOST_REQUIRE(!sim_model.is_null());
+  BOOST_REQUIRE(!surr_model.is_null());
+
+  Dakota::Model sim_recast = identity_recast(sim_model),
+    sim_recast2 = identity_recast(sim_recast),
+    surr_recast = identity_recast(surr_model);
+
+  check_recast(sim_recast,  sim_model);
+  check_recast(sim_recast2, sim_recast);
+  check_recast(surr_recast, surr_model);
+
+  std::cout << "\nModel::evaluate() overhead (" << num_timed_evals
+	    << " evaluations per model):\n";
+  double sim_usec = time_evaluations(sim_model),
+    sim_recast_usec   = time_evaluations(sim_recast),
+    sim_recast2_usec  = time_evaluations(sim_recast2),
+    surr_usec         = time_evaluations(surr_model),
+    surr_recast_usec  = time_evaluations(surr_recast);
+  report("simulation (direct text_book)", sim_usec);
+  report("recast(simulation)",            sim_recast_usec,  sim_usec);
+  report("recast(recast(simulation))",    sim_recast2_usec, sim_recast_usec);
+  report("surrogate (global polynomial)", surr_usec);
+  report("recast(surrogate)",             surr_recast_usec, surr_usec);
+
+  BOOST_TEST(sim_usec > 0.);
+  BOOST_TEST(surr_usec > 0.);
+}
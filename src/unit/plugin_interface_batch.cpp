@@ -0,0 +1,124 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+/** \file plugin_interface_batch.cpp Runs a parameter study through the
+    identity map plugin (f_i(x) = x_i) with and without batch
+    evaluation, and asynchronously on threads, and verifies the cached
+    responses.  The batch study runs
+    both with a plugin exporting the columnar batch API and with one
+    that does not, for which PluginInterface falls back to per-request
+    evaluations. */
+
+#include "opt_tpl_test.hpp"
+#include "LibraryEnvironment.hpp"
+#include "PRPMultiIndex.hpp"
+
+#include <boost/algorithm/string/replace.hpp>
+
+#define BOOST_TEST_MODULE dakota_plugin_interface_batch
+#include <boost/test/included/unit_test.hpp>
+
+namespace Dakota {
+  extern PRPCache data_pairs;
+}
+
+std::string plugin_batch_input = R"(
+method
+  list_parameter_study
+    list_of_points
+      0.5  1.5
+     -1.0  2.0
+      3.0 -0.25
+      1.0  1.0
+      2.5  0.0
+
+variables
+  continuous_design 2
+    descriptors 'x1' 'x2'
+
+interface
+  analysis_drivers 'f_of_x_equals_x'
+    plugin
+      library_path 'PLUGIN_PATH'
+  BATCH_SPEC
+
+responses
+  response_functions 2
+  analytic_gradients
+  analytic_hessians
+)";
+
+
+/// run the parameter study with the plugin and verify the cached
+/// evaluations against the identity map
+void check_identity_map(const std::string& plugin_path,
+			const std::string& batch_spec)
+{
+  std::string input(plugin_batch_input);
+  boost::replace_all(input, "PLUGIN_PATH", plugin_path);
+  boost::replace_all(input, "BATCH_SPEC", batch_spec);
+
+  Dakota::data_pairs.clear();
+  {
+    std::shared_ptr<Dakota::LibraryEnvironment> p_env(
+      Dakota::Opt_TPL_Test::create_env(input));
+    p_env->execute();
+  }
+
+  BOOST_REQUIRE(Dakota::data_pairs.size() == 5);
+  for (const Dakota::ParamResponsePair& prp : Dakota::data_pairs) {
+    const Dakota::RealVector& x
+      = prp.variables().continuous_variables();
+    const Dakota::Response& resp = prp.response();
+    const Dakota::RealVector& fns = resp.function_values();
+    const Dakota::RealMatrix& grads = resp.function_gradients();
+    const Dakota::RealSymMatrixArray& hessians = resp.function_hessians();
+    BOOST_REQUIRE(fns.length() == 2);
+    for (int i=0; i<2; ++i) {
+      BOOST_CHECK(fns[i] == x[i]);
+      for (int j=0; j<2; ++j) {
+	BOOST_CHECK(grads(j,i) == ((i == j) ? 1. : 0.));
+	for (int k=0; k<=j; ++k)
+	  BOOST_CHECK(hessians[i](j,k) == 0.);
+      }
+    }
+  }
+  Dakota::data_pairs.clear();
+}
+
+
+// one plugin evaluate() per evaluation
+BOOST_AUTO_TEST_CASE(test_plugin_interface_serial)
+{
+  check_identity_map(IDENTITY_MAP_PLUGIN, "");
+}
+
+
+// one DakotaInterfaceBatchAPI::evaluate_batch() per batch
+BOOST_AUTO_TEST_CASE(test_plugin_interface_batch_api)
+{
+  check_identity_map(IDENTITY_MAP_PLUGIN, "batch");
+}
+
+
+// no dakota_interface_batch_plugin symbol: one DakotaInterfaceAPI::evaluate()
+// of the vector of per-point requests
+BOOST_AUTO_TEST_CASE(test_plugin_interface_batch_fallback)
+{
+  check_identity_map(IDENTITY_MAP_NO_BATCH_PLUGIN, "batch");
+}
+
+
+// dakota_interface_thread_safe() is exported: evaluate() on a thread pool
+BOOST_AUTO_TEST_CASE(test_plugin_interface_threaded)
+{
+  check_identity_map(IDENTITY_MAP_PLUGIN,
+		     "asynchronous evaluation_concurrency 3");
+}
@@ -8,6 +8,7 @@
     _______________________________________________________________________ */
 
 #include "OutputManager.hpp"
+#include "IndexedRestart.hpp"
 #include "ParamResponsePair.hpp"
 #include "RestartVersion.hpp"
 #include "SimulationResponse.hpp"
@@ -336,3 +337,80 @@ BOOST_AUTO_TEST_CASE(test_io_restart_read_newfile)
 
   boost::filesystem::remove(rst_filename);
 }
+
+
+/** Indexed restart: random access, raw record copy, and recovery of
+    a file missing its index */
+BOOST_AUTO_TEST_CASE(test_io_restart_indexed)
+{
+  std::string rst_filename("indexed.rstx"), copy_filename("indexed_copy.rstx");
+  boost::filesystem::remove(rst_filename);
+  boost::filesystem::remove(copy_filename);
+
+  const int num_evals = 10;
+  PRPArray prps_out, prps_in;
+  // scope to force destruction of writers and close the file
+  {
+    std::stringstream rst_stream;
+    RestartWriter rst_writer(rst_stream);
+    prps_out = generate_and_write_prps(num_evals, rst_writer);
+
+    RestartVersion rst_ver("6.16.0+", "a1b2c3d4e5f6");
+    IndexedRestartWriter indexed_writer(rst_filename, rst_ver);
+    for (const ParamResponsePair& prp : prps_out)
+      indexed_writer.append_prp(prp);
+  }
+
+  BOOST_CHECK(IndexedRestartReader::is_indexed(rst_filename));
+  {
+    IndexedRestartReader rst_reader(rst_filename);
+    BOOST_CHECK(!rst_reader.recovered());
+    BOOST_CHECK(rst_reader.version().dakotaRelease == "6.16.0+");
+    BOOST_REQUIRE_EQUAL(rst_reader.size(), num_evals);
+
+    // random access, last record first
+    ParamResponsePair prp_last;
+    rst_reader.read_prp(num_evals-1, prp_last);
+    BOOST_CHECK(prp_last == prps_out.back());
+    BOOST_CHECK_EQUAL(rst_reader.eval_id(num_evals-1), num_evals);
+
+    rst_reader.read_prps(num_evals, prps_in);
+    BOOST_CHECK(prps_in == prps_out);
+
+    // copy odd eval ids without decoding
+    IndexedRestartWriter copy_writer(copy_filename, rst_reader.version());
+    for (size_t i=0; i<rst_reader.size(); ++i)
+      if (rst_reader.eval_id(i) % 2) {
+	std::pair<const char*, size_t> record = rst_reader.record_data(i);
+	copy_writer.append_record(record.first, record.second,
+				  rst_reader.eval_id(i));
+      }
+  }
+  {
+    IndexedRestartReader copy_reader(copy_filename);
+    BOOST_REQUIRE_EQUAL(copy_reader.size(), num_evals/2);
+    ParamResponsePair prp_in;
+    copy_reader.read_prp(1, prp_in);
+    BOOST_CHECK(prp_in == prps_out[2]);
+  }
+
+  // drop the index and part of the last record, as if Dakota were killed
+  boost::filesystem::resize_file(copy_filename,
+    boost::filesystem::file_size(copy_filename) - 24 - 16*num_evals/2 - 8);
+  {
+    IndexedRestartReader copy_reader(copy_filename);
+    BOOST_CHECK(copy_reader.recovered());
+    BOOST_REQUIRE_EQUAL(copy_reader.size(), num_evals/2 - 1);
+    BOOST_CHECK_EQUAL(copy_reader.eval_id(3), 7);
+  }
+
+  // a sequential restart file is not indexed
+  {
+    RestartWriter rst_writer(copy_filename);
+    generate_minimal_prps(1, rst_writer);
+  }
+  BOOST_CHECK(!IndexedRestartReader::is_indexed(copy_filename));
+
+  boost::filesystem::remove(rst_filename);
+  boost::filesystem::remove(copy_filename);
+}
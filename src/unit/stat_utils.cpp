@@ -9,10 +9,15 @@
 
 
 #include "NonDBayesCalibration.hpp"
+#include "NonDSampling.hpp"
 #include "dakota_data_io.hpp"
 #include "dakota_tabular_io.hpp"
 #include "bayes_calibration_utils.hpp"
 #include "dakota_stat_util.hpp"
+#include "NearestNeighborIndex.hpp"
+#include "SensAnalysisGlobal.hpp"
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <thread>
 
@@ -173,3 +178,409 @@ BOOST_AUTO_TEST_CASE(test_stat_utils_batch_means_percentile)
 }
 
 //------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_moment_accumulator)
+{
+  // two merged accumulators over a skewed sample, including a failure
+  std::mt19937 gen(1234);
+  std::lognormal_distribution<> dist(0., 0.5);
+  int i, num_samples = 1001;
+  RealMatrix samples(1, num_samples);
+  MomentAccumulator acc_a, acc_b;
+  for (i=0; i<num_samples; ++i) {
+    samples(0,i) = (i == 500) ? std::numeric_limits<Real>::quiet_NaN()
+                              : dist(gen);
+    if (i < 300) acc_a.push(samples(0,i));
+    else         acc_b.push(samples(0,i));
+  }
+  acc_a.merge(acc_b);
+  BOOST_CHECK(acc_a.count() == num_samples - 1);
+  BOOST_CHECK(acc_a.num_omitted() == 1);
+
+  for (short moments_type=Pecos::STANDARD_MOMENTS;
+       moments_type<=Pecos::CENTRAL_MOMENTS; ++moments_type) {
+    RealMatrix gold_moments;
+    NonDSampling::compute_moments(samples, gold_moments, moments_type);
+    Real moments[4];
+    acc_a.moments(moments_type == Pecos::CENTRAL_MOMENTS, moments);
+    for (i=0; i<4; ++i)
+      BOOST_CHECK_CLOSE(moments[i], gold_moments(i,0), 1.e-8);
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_quantile_sketch)
+{
+  std::mt19937 gen(5678);
+  std::normal_distribution<> dist(0., 1.);
+
+  // exact order statistic interpolation for a small sample
+  RealArray small(100);
+  QuantileSketch small_sketch;
+  for (Real& s : small)
+    { s = dist(gen); small_sketch.push(s); }
+  std::sort(small.begin(), small.end());
+  BOOST_CHECK_CLOSE(small_sketch.value_at_rank(0.), small[0], 1.e-12);
+  BOOST_CHECK_CLOSE(small_sketch.value_at_rank(49.5),
+                    (small[49] + small[50]) / 2., 1.e-12);
+  BOOST_CHECK_CLOSE(small_sketch.value_at_rank(99.), small[99], 1.e-12);
+
+  // merged sketches of a large sample: the empirical CDF at each
+  // estimated quantile is close to the requested probability
+  size_t i, num_samples = 200000;
+  RealArray large(num_samples);
+  QuantileSketch sketch_a, sketch_b;
+  for (i=0; i<num_samples; ++i) {
+    large[i] = dist(gen);
+    if (i % 3) sketch_a.push(large[i]);
+    else       sketch_b.push(large[i]);
+  }
+  sketch_a.merge(sketch_b);
+  BOOST_CHECK(sketch_a.count() == num_samples);
+  std::sort(large.begin(), large.end());
+  RealArray probs = { 0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.999 };
+  for (Real p : probs) {
+    Real z = sketch_a.value_at_rank(p * num_samples - 1.);
+    Real cdf = (Real)(std::upper_bound(large.begin(), large.end(), z)
+		      - large.begin()) / (Real)num_samples;
+    BOOST_CHECK_SMALL(cdf - p, 0.05 * std::min(p, 1. - p) + 1.e-4);
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_covariance_accumulator)
+{
+  std::mt19937 gen(91011);
+  std::normal_distribution<> dist(1., 2.);
+  int i, j, k, num_factors = 3, num_samples = 250;
+  RealMatrix samples(num_factors, num_samples);
+  for (j=0; j<num_samples; ++j) {
+    samples(0,j) = dist(gen);
+    samples(1,j) = dist(gen) + samples(0,j);
+    samples(2,j) = dist(gen) * samples(1,j);
+  }
+
+  // unequal blocks, one through a merged accumulator
+  CovarianceAccumulator acc(num_factors), acc_b(num_factors);
+  acc.push(RealMatrix(Teuchos::View, samples, num_factors, 100, 0, 0));
+  acc_b.push(RealMatrix(Teuchos::View, samples, num_factors, 1, 0, 100));
+  acc_b.push(RealMatrix(Teuchos::View, samples, num_factors, 149, 0, 101));
+  acc.merge(acc_b);
+  BOOST_CHECK(acc.count() == num_samples);
+
+  RealVector means(num_factors);
+  for (j=0; j<num_samples; ++j)
+    for (i=0; i<num_factors; ++i)
+      means[i] += samples(i,j) / num_samples;
+  for (i=0; i<num_factors; ++i) {
+    BOOST_CHECK_CLOSE(acc.means()[i], means[i], 1.e-10);
+    for (k=0; k<num_factors; ++k) {
+      Real comoment = 0.;
+      for (j=0; j<num_samples; ++j)
+	comoment += (samples(i,j) - means[i]) * (samples(k,j) - means[k]);
+      BOOST_CHECK_CLOSE(acc.comoments()(i,k), comoment, 1.e-10);
+    }
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_comoment_correlations)
+{
+  // correlated inputs and outputs, accumulated in blocks as in streaming
+  // sampling; the correlations must match those of the sample matrix
+  std::mt19937 gen(1357);
+  std::normal_distribution<> dist(0., 1.);
+  int i, j, num_vars = 3, num_fns = 2, num_corr = num_vars + num_fns,
+    num_samples = 500;
+  RealMatrix vars_samples(num_vars, num_samples),
+    all_samples(num_corr, num_samples);
+  IntResponseMap resp_samples;
+  for (j=0; j<num_samples; ++j) {
+    vars_samples(0,j) = dist(gen);
+    vars_samples(1,j) = dist(gen) + 0.5 * vars_samples(0,j);
+    vars_samples(2,j) = dist(gen) - 0.3 * vars_samples(1,j);
+    Response resp(SIMULATION_RESPONSE, ActiveSet(num_fns));
+    resp.function_value(vars_samples(0,j) + 2. * vars_samples(2,j)
+			+ 0.2 * dist(gen), 0);
+    resp.function_value(std::exp(0.5 * vars_samples(1,j))
+			- vars_samples(0,j) * vars_samples(2,j), 1);
+    resp_samples[j+1] = resp;
+    for (i=0; i<num_vars; ++i)
+      all_samples(i,j) = vars_samples(i,j);
+    for (i=0; i<num_fns; ++i)
+      all_samples(num_vars+i,j) = resp.function_value(i);
+  }
+
+  SensAnalysisGlobal sa_matrix;
+  sa_matrix.compute_correlations(vars_samples, resp_samples);
+
+  CovarianceAccumulator acc(num_corr);
+  acc.push(RealMatrix(Teuchos::View, all_samples, num_corr, 200, 0, 0));
+  acc.push(RealMatrix(Teuchos::View, all_samples, num_corr, 300, 0, 200));
+  SensAnalysisGlobal sa_stream;
+  sa_stream.compute_correlations(acc.comoments(), num_vars, acc.count());
+
+  const RealMatrix& simple_m = sa_matrix.simple_correlations();
+  const RealMatrix& simple_s = sa_stream.simple_correlations();
+  BOOST_REQUIRE(simple_s.numRows() == simple_m.numRows() &&
+		simple_s.numCols() == simple_m.numCols());
+  for (j=0; j<simple_m.numCols(); ++j)
+    for (i=0; i<simple_m.numRows(); ++i)
+      BOOST_CHECK_SMALL(simple_s(i,j) - simple_m(i,j), 1.e-10);
+
+  const RealMatrix& partial_m = sa_matrix.partial_correlations();
+  const RealMatrix& partial_s = sa_stream.partial_correlations();
+  BOOST_REQUIRE(partial_s.numRows() == num_vars &&
+		partial_s.numCols() == num_fns);
+  BOOST_REQUIRE(partial_m.numRows() == num_vars &&
+		partial_m.numCols() == num_fns);
+  for (j=0; j<num_fns; ++j)
+    for (i=0; i<num_vars; ++i)
+      BOOST_CHECK_SMALL(partial_s(i,j) - partial_m(i,j), 1.e-10);
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_average_ranks)
+{
+  // enough samples to rank the rows concurrently; coarse values for ties
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<> dist(0, 999);
+  int i, j, num_rows = 5, num_cols = 20000;
+  RealMatrix data(num_rows + 1, num_cols);
+  for (j=0; j<num_cols; ++j)
+    for (i=0; i<=num_rows; ++i)
+      data(i,j) = (i == 0) ? (Real)j : dist(gen) / 10.;
+
+  // reference: tied values get the average of their 0-based ranks
+  RealMatrix ranks(num_rows, num_cols);
+  for (i=0; i<num_rows; ++i) {
+    RealIntMultiMap vals_inds;
+    for (j=0; j<num_cols; ++j)
+      vals_inds.insert(std::make_pair(data(i+1,j), j));
+    RealIntMultiMap::const_iterator vi_it = vals_inds.begin();
+    for (int rank=0; vi_it != vals_inds.end(); ) {
+      auto tied_range = vals_inds.equal_range(vi_it->first);
+      int num_ties = std::distance(tied_range.first, tied_range.second);
+      for ( ; tied_range.first != tied_range.second; ++tied_range.first)
+	ranks(i, tied_range.first->second) = (rank + rank+num_ties-1) / 2.0;
+      vi_it = tied_range.second;
+      rank += num_ties;
+    }
+  }
+
+  // rank a strided view, leaving the excluded leading row untouched
+  RealMatrix data_view(Teuchos::View, data, num_rows, num_cols, 1, 0);
+  rows_to_average_ranks(data_view);
+  for (j=0; j<num_cols; ++j) {
+    BOOST_CHECK(data(0,j) == (Real)j);
+    for (i=0; i<num_rows; ++i)
+      BOOST_CHECK(data_view(i,j) == ranks(i,j));
+  }
+
+  // ordinal ranks break ties in order of appearance
+  Real values[] = { 3., 1., 2., 1., 3. };
+  SizetArray ord_ranks;
+  ordinal_ranks(values, 5, ord_ranks);
+  size_t ord_gold[] = { 3, 0, 2, 1, 4 };
+  for (j=0; j<5; ++j)
+    BOOST_CHECK(ord_ranks[j] == ord_gold[j]);
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_nearest_neighbor_index)
+{
+  // coarse coordinates for ties and coincident points; enough points
+  // that the batched queries run concurrently
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<> dist(0, 20);
+  size_t i, j, r, num_dims = 3, num_pts = 600, k = 5;
+  RealMatrix points(num_dims + 1, num_pts);
+  for (j=0; j<num_pts; ++j)
+    for (i=0; i<=num_dims; ++i)
+      points(i,j) = dist(gen) / 4.;
+
+  short metrics[] = { NearestNeighborIndex::L2_NORM,
+		      NearestNeighborIndex::LINF_NORM };
+  for (short metric : metrics) {
+    // index rows 1..num_dims: half in bulk, half incrementally
+    RealMatrix first_half(Teuchos::View, points, num_dims + 1, num_pts/2);
+    NearestNeighborIndex index(first_half, 1, num_dims, metric);
+    for (j=num_pts/2; j<num_pts; ++j)
+      index.insert(points[j] + 1);
+    BOOST_CHECK(index.size() == num_pts);
+
+    SizetArray indices, counts;
+    RealArray distances;
+    index.search(index.points(), k, indices, distances);
+    RealVector radii(num_pts);
+    for (j=0; j<num_pts; ++j)
+      radii[j] = distances[j*k + 2];
+    index.count_within(index.points(), radii, counts);
+
+    // brute force, ordered by (distance, index)
+    for (j=0; j<num_pts; ++j) {
+      std::vector<std::pair<Real, size_t> > all(num_pts);
+      size_t count = 0;
+      for (i=0; i<num_pts; ++i) {
+	all[i] = std::make_pair(index.distance(points[j]+1, points[i]+1), i);
+	if (all[i].first <= radii[j]) ++count;
+      }
+      std::sort(all.begin(), all.end());
+      for (r=0; r<k; ++r) {
+	BOOST_CHECK(indices[j*k + r] == all[r].second);
+	BOOST_CHECK(distances[j*k + r] == all[r].first);
+      }
+      BOOST_CHECK(counts[j] == count);
+    }
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_nearest_neighbor_within)
+{
+  // coarse coordinates so points land on the radius and box faces
+  std::mt19937 gen(5678);
+  std::uniform_int_distribution<> dist(0, 20);
+  size_t i, j, d, num_dims = 3, num_pts = 400;
+  RealMatrix points(num_dims, num_pts);
+  for (j=0; j<num_pts; ++j)
+    for (i=0; i<num_dims; ++i)
+      points(i,j) = dist(gen) / 4.;
+
+  const Real inf = std::numeric_limits<Real>::infinity();
+  Real radii[] = { 0., 0.5, 1.25, 3. };
+  short metrics[] = { NearestNeighborIndex::L2_NORM,
+		      NearestNeighborIndex::LINF_NORM };
+  for (short metric : metrics) {
+    NearestNeighborIndex index(points, 0, num_dims, metric);
+
+    SizetArray indices, expected;
+    for (j=0; j<num_pts; j+=7) {
+      const Real* query = points[j];
+      for (Real radius : radii) {
+	index.within(query, radius, indices);
+	expected.clear();
+	for (i=0; i<num_pts; ++i)
+	  if (index.distance(query, points[i]) <= radius)
+	    expected.push_back(i);
+	BOOST_CHECK(indices == expected);
+	BOOST_CHECK(index.count_within(query, radius) == expected.size());
+      }
+
+      // box spanned by two indexed points, then opened to infinity
+      // along the first dimension
+      const Real* other = points[(j*13 + 5) % num_pts];
+      RealArray lower(num_dims), upper(num_dims);
+      for (d=0; d<num_dims; ++d) {
+	lower[d] = std::min(query[d], other[d]);
+	upper[d] = std::max(query[d], other[d]);
+      }
+      for (size_t open=0; open<2; ++open) {
+	if (open)
+	  { lower[0] = -inf; upper[0] = inf; }
+	index.within_box(lower.data(), upper.data(), indices);
+	expected.clear();
+	for (i=0; i<num_pts; ++i) {
+	  for (d=0; d<num_dims; ++d)
+	    if (points(d,i) < lower[d] || points(d,i) > upper[d])
+	      break;
+	  if (d == num_dims)
+	    expected.push_back(i);
+	}
+	BOOST_CHECK(indices == expected);
+      }
+    }
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_vbd_indices)
+{
+  // Saltelli replicates A, B, and A_B^i (B with row i from A) over
+  // U(-pi, pi)^3, ordered as Analyzer::get_vbd_parameter_sets(); enough
+  // samples to accumulate the replicates concurrently
+  const size_t num_vars = 3, num_fns = 2, num_samples = 25000,
+    num_reps = num_vars + 2;
+  std::mt19937 gen(2468);
+  const Real pi = std::acos(-1.);
+  std::uniform_real_distribution<> dist(-pi, pi);
+  RealMatrix samp_A(num_vars, num_samples), samp_B(num_vars, num_samples);
+  size_t i, j, k;
+  for (j=0; j<num_samples; ++j)
+    for (i=0; i<num_vars; ++i)
+      { samp_A(i,j) = dist(gen); samp_B(i,j) = dist(gen); }
+
+  // Ishigami (a = 7, b = 0.1) and a linear function x1 + 2 x2
+  IntResponseMap resp_samples;
+  RealVector x(num_vars);
+  int eval_id = 1;
+  for (size_t r=0; r<num_reps; ++r)
+    for (j=0; j<num_samples; ++j, ++eval_id) {
+      for (i=0; i<num_vars; ++i)
+	x[i] = (r == 0 || (r >= 2 && i == r-2)) ? samp_A(i,j) : samp_B(i,j);
+      Response resp(SIMULATION_RESPONSE, ActiveSet(num_fns));
+      resp.function_value(std::sin(x[0]) + 7. * std::pow(std::sin(x[1]), 2)
+			  + 0.1 * std::pow(x[2], 4) * std::sin(x[0]), 0);
+      resp.function_value(x[0] + 2. * x[1], 1);
+      resp_samples[eval_id] = resp;
+    }
+
+  SensAnalysisGlobal sa;
+  sa.compute_vbd_stats(num_fns, num_vars, num_samples, resp_samples);
+  const RealVectorArray& S = sa.vbd_main_effects();
+  const RealVectorArray& T = sa.vbd_total_effects();
+  BOOST_REQUIRE(S.size() == num_fns && T.size() == num_fns);
+
+  // reference: the estimators as formulated prior to fusing the passes,
+  // with the replicates centered on the overall mean
+  std::vector<RealMatrix> fn_vals(num_fns, RealMatrix(num_reps, num_samples));
+  IntRespMCIter r_it = resp_samples.begin();
+  for (size_t r=0; r<num_reps; ++r)
+    for (j=0; j<num_samples; ++j, ++r_it)
+      for (k=0; k<num_fns; ++k)
+	fn_vals[k](r,j) = r_it->second.function_value(k);
+  for (k=0; k<num_fns; ++k) {
+    RealMatrix& y = fn_vals[k];
+    Real mean_A = 0., mean_B = 0., overall_mean = 0., var_C = 0.;
+    for (j=0; j<num_samples; ++j) {
+      mean_A += y(0,j); mean_B += y(1,j);
+      var_C  += y(0,j) * y(0,j) + y(1,j) * y(1,j);
+      for (size_t r=0; r<num_reps; ++r)
+	overall_mean += y(r,j);
+    }
+    mean_A /= num_samples; mean_B /= num_samples;
+    overall_mean /= num_samples * num_reps;
+    Real mean_C = (mean_A + mean_B) / 2.;
+    var_C = var_C / (2. * num_samples) - mean_C * mean_C;
+    for (i=0; i<num_vars; ++i) {
+      Real sum_S = 0., sum_T = 0.;
+      for (j=0; j<num_samples; ++j) {
+	Real diff = y(i+2,j) - y(1,j);
+	sum_S += (y(0,j) - overall_mean) * diff;
+	sum_T += diff * diff;
+      }
+      BOOST_CHECK_SMALL(S[k][i] - sum_S / num_samples / var_C, 1.e-8);
+      BOOST_CHECK_SMALL(T[k][i] - sum_T / (2. * num_samples) / var_C, 1.e-8);
+    }
+  }
+
+  // closed-form indices, to within the sampling error of the estimators
+  Real ishigami_S[] = { 0.3139, 0.4424, 0. },
+       ishigami_T[] = { 0.5576, 0.4424, 0.2437 },
+       linear_S[]   = { 0.2, 0.8, 0. };
+  for (i=0; i<num_vars; ++i) {
+    BOOST_CHECK_SMALL(S[0][i] - ishigami_S[i], 0.05);
+    BOOST_CHECK_SMALL(T[0][i] - ishigami_T[i], 0.05);
+    BOOST_CHECK_SMALL(S[1][i] - linear_S[i], 0.05);
+    BOOST_CHECK_SMALL(T[1][i] - linear_S[i], 0.05);
+  }
+}
+
+//------------------------------------
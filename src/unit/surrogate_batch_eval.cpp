@@ -0,0 +1,164 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+/** \file surrogate_batch_eval.cpp Verifies that a batch of queued
+    DataFitSurrModel evaluations (evaluate_nowait() + synchronize(), as
+    used by sampling) reproduces the function values and gradients of
+    synchronous per-point evaluations, both for an Approximation using
+    the default per-point batch and for a surrogates module
+    Approximation with matrix-valued batch evaluations. */
+
+#include "opt_tpl_test.hpp"
+#include "LibraryEnvironment.hpp"
+
+#include <boost/algorithm/string/replace.hpp>
+
+#define BOOST_TEST_MODULE dakota_surrogate_batch_eval
+#include <boost/test/included/unit_test.hpp>
+
+namespace btt = boost::test_tools;
+
+std::string surrogate_batch_eval_input = R"(
+environment
+  method_pointer 'SAMP'
+
+method
+  id_method 'SAMP'
+  output silent
+  sampling
+    samples 10
+    seed 11
+  model_pointer 'SURR'
+
+method
+  id_method 'DACE'
+  output silent
+  sampling
+    samples 30
+    seed 7
+  model_pointer 'SIM'
+
+model
+  id_model 'SURR'
+  surrogate global
+    SURROGATE_SPEC
+    dace_method_pointer 'DACE'
+
+model
+  id_model 'SIM'
+  single
+    interface_pointer 'I'
+
+variables
+  uniform_uncertain 2
+    lower_bounds  0.5  0.5
+    upper_bounds  1.5  1.5
+
+interface
+  id_interface 'I'
+  direct
+    analysis_driver = 'text_book'
+
+responses
+  response_functions 3
+  analytic_gradients
+  no_hessians
+)";
+
+
+/// number of points evaluated by each path
+const size_t num_batch_evals = 25;
+
+
+/// set the continuous variables of model to the i-th test point
+void set_point(Dakota::Model& model, size_t i)
+{
+  size_t j, num_cv = model.cv();
+  for (j=0; j<num_cv; ++j)
+    model.continuous_variable(
+      0.5 + (double)((i * (j + 1)) % num_batch_evals) / num_batch_evals, j);
+}
+
+
+/// build the surrogate specified by surrogate_spec and compare its
+/// batched values and gradients against synchronous evaluations
+void check_batch_evaluations(const std::string& surrogate_spec)
+{
+  std::string input(surrogate_batch_eval_input);
+  boost::replace_all(input, "SURROGATE_SPEC", surrogate_spec);
+  std::shared_ptr<Dakota::LibraryEnvironment> p_env(
+    Dakota::Opt_TPL_Test::create_env(input));
+  Dakota::LibraryEnvironment& env = *p_env;
+
+  // builds the surrogate and samples it once
+  env.execute();
+
+  Dakota::Model surr_model;
+  Dakota::ModelList& models = env.problem_description_db().model_list();
+  for (Dakota::ModelLIter ml_it=models.begin(); ml_it!=models.end(); ++ml_it)
+    if (ml_it->model_id() == "SURR")
+      surr_model = *ml_it;
+  BOOST_REQUIRE(!surr_model.is_null());
+  BOOST_REQUIRE(surr_model.batch_evaluation_available());
+
+  Dakota::ActiveSet set = surr_model.current_response().active_set();
+  set.request_values(3); // values and gradients
+  Dakota::RealVector x0 = surr_model.continuous_variables(); // copy
+  size_t i;
+
+  // synchronous evaluations, point by point
+  std::vector<Dakota::Response> sync_responses;
+  for (i=0; i<num_batch_evals; ++i) {
+    set_point(surr_model, i);
+    surr_model.evaluate(set);
+    sync_responses.push_back(surr_model.current_response().copy());
+  }
+
+  // the same points queued and evaluated as one batch
+  for (i=0; i<num_batch_evals; ++i) {
+    set_point(surr_model, i);
+    surr_model.evaluate_nowait(set);
+  }
+  const Dakota::IntResponseMap& batch_responses = surr_model.synchronize();
+  BOOST_REQUIRE(batch_responses.size() == num_batch_evals);
+  surr_model.continuous_variables(x0);
+
+  Dakota::IntRespMCIter r_it = batch_responses.begin();
+  for (i=0; i<num_batch_evals; ++i, ++r_it) {
+    const Dakota::RealVector& sync_fns = sync_responses[i].function_values();
+    const Dakota::RealVector& batch_fns = r_it->second.function_values();
+    const Dakota::RealMatrix& sync_grads
+      = sync_responses[i].function_gradients();
+    const Dakota::RealMatrix& batch_grads
+      = r_it->second.function_gradients();
+    BOOST_REQUIRE(batch_fns.length() == sync_fns.length());
+    BOOST_REQUIRE(batch_grads.numCols() == sync_grads.numCols());
+    BOOST_REQUIRE(batch_grads.numRows() == sync_grads.numRows());
+    for (int k=0; k<sync_fns.length(); ++k) {
+      BOOST_TEST(batch_fns[k] == sync_fns[k], btt::tolerance(1.e-12));
+      for (int l=0; l<sync_grads.numRows(); ++l)
+	BOOST_TEST(batch_grads(l,k) == sync_grads(l,k), btt::tolerance(1.e-12));
+    }
+  }
+}
+
+
+// Approximation::values()/gradients() defaults: per-point batches
+BOOST_AUTO_TEST_CASE(test_surrogate_batch_eval_default)
+{
+  check_batch_evaluations("polynomial quadratic");
+}
+
+
+// SurrogatesBaseApprox overrides: one matrix-valued call per batch
+BOOST_AUTO_TEST_CASE(test_surrogate_batch_eval_module)
+{
+  check_batch_evaluations("experimental_polynomial basis_order 2");
+}
@@ -17,6 +17,7 @@
 #include <boost/foreach.hpp>
 
 #include <cassert>
+#include <fstream>
 #include <iostream>
 
 
@@ -251,6 +252,76 @@ void test_create_and_remove_tmpdir(bool copy=false)
 }
 
 
+void test_clone_file()
+{
+  bfs::path tmp_dir( WorkdirHelper::system_tmp_path() );
+  bfs::path wd( tmp_dir/bfs::unique_path("daktst_%%%%%%%%") );
+  WorkdirHelper::create_directory(wd, DIR_CLEAN);
+
+  bfs::path src(wd/"template.dat");
+  {
+    std::ofstream src_out(src.string().c_str());
+    src_out << "mesh data\n";
+  }
+  WorkdirHelper::clone_file(src, wd/"copy.dat");
+  std::ifstream copy_in((wd/"copy.dat").string().c_str());
+  std::string line;
+  std::getline(copy_in, line);
+  BOOST_CHECK( line == "mesh data" );
+  copy_in.close();
+
+  // a read-only template is copied, not linked: restoring write
+  // permission on the copy and writing it leaves the template intact
+  bfs::permissions(src, bfs::owner_read | bfs::group_read | bfs::others_read);
+  WorkdirHelper::clone_file(src, wd/"readonly.dat");
+  BOOST_CHECK( !bfs::equivalent(src, wd/"readonly.dat") );
+  BOOST_CHECK( !(bfs::status(wd/"readonly.dat").permissions() &
+		 bfs::owner_write) );
+#if !defined(_WIN32)
+  BOOST_CHECK( bfs::hard_link_count(src) == 1 );
+#endif
+  bfs::permissions(wd/"readonly.dat", bfs::add_perms | bfs::owner_write);
+  {
+    std::ofstream copy_out((wd/"readonly.dat").string().c_str());
+    copy_out << "modified\n";
+  }
+  std::ifstream src_in(src.string().c_str());
+  std::getline(src_in, line);
+  BOOST_CHECK( line == "mesh data" );
+  src_in.close();
+
+  bfs::permissions(src, bfs::add_perms | bfs::owner_write);
+  test_rmdir(wd);
+}
+
+
+void test_remove_async()
+{
+  bfs::path tmp_dir( WorkdirHelper::system_tmp_path() );
+  bfs::path temp_name = bfs::unique_path("daktst_%%%%%%%%");
+  bfs::path wd( tmp_dir/temp_name );
+  WorkdirHelper::create_directory(wd/"subdir", DIR_CLEAN);
+  std::ofstream((wd/"subdir"/"file.dat").string().c_str()) << "data\n";
+
+  // the directory is renamed out of the way immediately and may be
+  // recreated while its contents are removed
+  WorkdirHelper::recursive_remove_async(wd, FILEOP_ERROR);
+  BOOST_CHECK( !bfs::exists(wd) );
+  WorkdirHelper::create_directory(wd, DIR_ERROR);
+  WorkdirHelper::wait_async_removals();
+
+  // no renamed remnants are left behind
+  size_t remnants = 0;
+  std::string prefix = temp_name.string() + ".dakota_remove_";
+  for (bfs::directory_iterator it(tmp_dir), eod; it != eod; ++it)
+    if (it->path().filename().string().compare(0, prefix.size(), prefix) == 0)
+      ++remnants;
+  BOOST_CHECK( remnants == 0 );
+
+  test_rmdir(wd);
+}
+
+
 void test_create_and_remove_wd_in_rundir(const std::string& dir_name,
   bool copy=false)
 {
@@ -321,6 +392,9 @@ int test_main( int argc, char* argv[] )      // note the name!
   test_create_and_remove_tmpdir(do_copy);
   test_create_and_remove_wd_in_rundir("workdir", do_copy);
 
+  test_clone_file();
+  test_remove_async();
+
   /* WJB: consider refactor count_driver_scripts test -- bfs::path fq_search(argv[1]);
   std::string fq_search(rundir_str);
   fq_search += "/../test/d*.sh";
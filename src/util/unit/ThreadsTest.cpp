@@ -0,0 +1,95 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "util_threads.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE dakota_ThreadsTest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace dakota::util;
+
+// ------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(util_num_threads) {
+  const std::size_t budget = thread_budget();
+  BOOST_CHECK(budget >= 1);
+  auto capped = [budget](std::size_t n) { return std::min(budget, n); };
+
+  // at least one thread, at most one per task, within the budget
+  BOOST_CHECK(num_threads(0, 0, 1) == 1);
+  BOOST_CHECK(num_threads(1, 1000, 1) == 1);
+  BOOST_CHECK(num_threads(1000, 1000, 1) == capped(1000));
+  BOOST_CHECK(num_threads(1000, 1000, 1, 2) == capped(2));
+
+  // too little work for a second thread
+  BOOST_CHECK(num_threads(1000, 999, 1000) == 1);
+  BOOST_CHECK(num_threads(1000, 2000, 1000) == capped(2));
+}
+
+// ------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(util_thread_shares) {
+  if (std::getenv("DAKOTA_NUM_THREADS")) return;  // overrides the shares
+
+  const std::size_t budget = thread_budget();
+  set_thread_shares(budget);
+  BOOST_CHECK(thread_budget() == 1);
+  set_thread_shares(2 * budget);
+  BOOST_CHECK(thread_budget() == 1);
+  set_thread_shares(1);
+  BOOST_CHECK(thread_budget() == budget);
+}
+
+// ------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(util_run_threads) {
+  const std::size_t num_calls = 4;
+  std::vector<int> calls(num_calls, 0);
+  std::vector<std::size_t> budgets(num_calls, 0);
+  std::atomic<std::size_t> nested_calls(0);
+  const std::size_t budget = thread_budget();
+
+  run_threads(num_calls, [&](std::size_t t) {
+    ++calls[t];
+    budgets[t] = thread_budget();
+    // a nested loop is limited to this call's share of the budget
+    std::size_t num_nested = num_threads(1000, 1000, 1);
+    BOOST_CHECK(num_nested <= budgets[t]);
+    run_threads(num_nested, [&](std::size_t) { ++nested_calls; });
+  });
+
+  std::size_t total_nested = 0;
+  for (std::size_t t = 0; t < num_calls; ++t) {
+    BOOST_CHECK(calls[t] == 1);
+    BOOST_CHECK(budgets[t] == std::max<std::size_t>(1, budget / num_calls));
+    total_nested += std::min<std::size_t>(budgets[t], 1000);
+  }
+  BOOST_CHECK(nested_calls == total_nested);
+
+  // the calling thread's budget is restored
+  BOOST_CHECK(thread_budget() == budget);
+}
+
+// ------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(util_run_threads_exception) {
+  std::atomic<int> num_calls(0);
+  BOOST_CHECK_THROW(run_threads(3,
+                                [&](std::size_t t) {
+                                  ++num_calls;
+                                  if (t == 2) throw std::runtime_error("t=2");
+                                }),
+                    std::runtime_error);
+  // the other calls complete before the exception propagates
+  BOOST_CHECK(num_calls == 3);
+}
@@ -0,0 +1,74 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "util_threads.hpp"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace dakota {
+namespace util {
+
+/// processes sharing the node, per set_thread_shares()
+static std::atomic<std::size_t> nodeShares(1);
+
+/// budget of a run_threads() worker; 0 on threads not started by it
+static thread_local std::size_t workerBudget = 0;
+
+/// positive integer value of DAKOTA_NUM_THREADS, otherwise 0
+static std::size_t env_num_threads() {
+  const char* env_threads = std::getenv("DAKOTA_NUM_THREADS");
+  if (!env_threads) return 0;
+  char* end;
+  long num_threads = std::strtol(env_threads, &end, 10);
+  return (end != env_threads && *end == '\0' && num_threads > 0)
+             ? (std::size_t)num_threads
+             : 0;
+}
+
+// ------------------------------------------------------------
+
+void set_thread_shares(std::size_t num_shares) {
+  nodeShares = std::max<std::size_t>(1, num_shares);
+}
+
+// ------------------------------------------------------------
+
+std::size_t thread_budget() {
+  if (workerBudget) return workerBudget;
+  static const std::size_t user_threads = env_num_threads();
+  if (user_threads) return user_threads;
+  std::size_t hardware_threads =
+      std::max(1u, std::thread::hardware_concurrency());
+  return std::max<std::size_t>(1, hardware_threads / nodeShares);
+}
+
+// ------------------------------------------------------------
+
+std::size_t num_threads(std::size_t num_tasks, std::size_t work,
+                        std::size_t min_work_per_thread,
+                        std::size_t max_threads) {
+  std::size_t threads = std::min(thread_budget(), num_tasks);
+  if (max_threads) threads = std::min(threads, max_threads);
+  if (min_work_per_thread)
+    threads = std::min(threads, work / min_work_per_thread);
+  return std::max<std::size_t>(1, threads);
+}
+
+// ------------------------------------------------------------
+
+ThreadBudgetScope::ThreadBudgetScope(std::size_t num_threads)
+    : prevBudget(workerBudget) {
+  workerBudget = std::max<std::size_t>(1, num_threads);
+}
+
+ThreadBudgetScope::~ThreadBudgetScope() { workerBudget = prevBudget; }
+
+}  // namespace util
+}  // namespace dakota
@@ -0,0 +1,115 @@
+/*  _______________________________________________________________________
+
+    DAKOTA: Design Analysis Kit for Optimization and Terascale Applications
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef DAKOTA_UTIL_THREADS_HPP
+#define DAKOTA_UTIL_THREADS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace dakota {
+namespace util {
+
+/**
+ *  \brief Divide the hardware threads of the node among the processes
+ *  sharing it, e.g., the MPI ranks placed on the node
+ *  \param[in] num_shares Number of processes sharing the node
+ */
+void set_thread_shares(std::size_t num_shares);
+
+/**
+ *  \brief Maximum number of threads, including the calling thread, that a
+ *  data-parallel loop on the calling thread may use
+ *  \returns The DAKOTA_NUM_THREADS environment variable if set to a positive
+ *  integer, otherwise the hardware threads divided among the processes
+ *  sharing the node (see set_thread_shares()).  Within a worker of
+ *  run_threads(), the worker's share of the enclosing loop's budget.
+ */
+std::size_t thread_budget();
+
+/**
+ *  \brief Number of threads for a loop over independent tasks
+ *  \param[in] num_tasks Number of tasks that can run concurrently
+ *  \param[in] work Estimate of the total work of the loop, in any unit
+ *  \param[in] min_work_per_thread Work per thread below which starting
+ *  the thread costs more than it saves, in the unit of work
+ *  \param[in] max_threads Further cap on the threads (0 for none)
+ *  \returns Number of threads within [1, num_tasks] and thread_budget()
+ */
+std::size_t num_threads(std::size_t num_tasks, std::size_t work,
+                        std::size_t min_work_per_thread,
+                        std::size_t max_threads = 0);
+
+/**
+ *  \brief Sets the thread_budget() of the calling thread while in scope
+ */
+class ThreadBudgetScope {
+ public:
+  /// set the budget of the calling thread to num_threads
+  explicit ThreadBudgetScope(std::size_t num_threads);
+  /// restore the previous budget
+  ~ThreadBudgetScope();
+
+ private:
+  /// budget of the calling thread on construction
+  std::size_t prevBudget;
+};
+
+/**
+ *  \brief Call f(t) for t = 0, ..., num_threads-1 concurrently, with f(0)
+ *  on the calling thread
+ *
+ *  Each call gets an equal share of the calling thread's thread_budget(),
+ *  so loops nested within f do not oversubscribe the cores.  The first
+ *  exception thrown by any call is rethrown once all calls are done.
+ *  \param[in] num_threads Number of calls, e.g., from num_threads()
+ *  \param[in] f Callable taking the thread index
+ */
+template <typename Function>
+void run_threads(std::size_t num_threads, Function&& f) {
+  if (num_threads <= 1) {
+    f(std::size_t(0));
+    return;
+  }
+
+  const std::size_t worker_budget =
+      std::max<std::size_t>(1, thread_budget() / num_threads);
+  std::vector<std::exception_ptr> errors(num_threads);
+  auto run_worker = [&](std::size_t t) {
+    ThreadBudgetScope budget_scope(worker_budget);
+    try {
+      f(t);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  try {
+    for (std::size_t t = 1; t < num_threads; ++t)
+      workers.emplace_back(run_worker, t);
+  } catch (...) {
+    for (auto& worker : workers) worker.join();
+    throw;
+  }
+  run_worker(0);
+  for (auto& worker : workers) worker.join();
+
+  for (auto& error : errors)
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace util
+}  // namespace dakota
+
+#endif  // DAKOTA_UTIL_THREADS_HPP
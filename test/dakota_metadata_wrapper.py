@@ -10,7 +10,7 @@ import time
 def insert_metadata(start, outfile):
     # TODO: generate metadata for each MD request in params file
     elapsed = time.time() - start
-    res_out.write("                     {0:20.16e} seconds\n".format(elapsed))
+    outfile.write("                     {0:20.16e} seconds\n".format(elapsed))
 
 
 def wrapped_driver(params_name):
@@ -22,13 +22,10 @@ def wrapped_driver(params_name):
     raise RuntimeError("{0} requires 1 analysis_component specifying the wrapped driver".format(sys.argv[0]))
 
 
-if __name__ == "__main__":
+def evaluate(params_name, results_name):
 
     start = time.time()
 
-    params_name = sys.argv[1]
-    results_name = sys.argv[2]
-
     # Leave any file tag to support concurrent evaluations
     tmp_results = results_name + ".tmp"
 
@@ -41,3 +38,14 @@ if __name__ == "__main__":
         insert_metadata(start, res_out)
 
     os.remove(tmp_results)
+
+
+if __name__ == "__main__":
+
+    if "DAKOTA_PERSISTENT_DRIVER_FD" in os.environ:
+        # fork persistent_driver: serve evaluations until Dakota closes
+        # the connection
+        import dakota.interfacing as di
+        di.run_persistent_driver(evaluate)
+    else:
+        evaluate(sys.argv[1], sys.argv[2])
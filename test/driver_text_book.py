@@ -208,3 +208,41 @@ def text_book_batch(list_of_params):
         else:
             retvals.append(text_book_numpy(param_dict))
     return retvals
+
+
+def text_book_columnar(params):
+    # one call for the whole batch; variables and ASVs have one row per
+    # evaluation and the responses are returned stacked the same way
+    num_evals = params["evaluations"]
+    x = np.asarray(params["cv"])
+    num_vars = x.shape[1]
+    ASV = params["asv"]
+
+    assert(x.shape == (num_evals, 3))
+    assert(ASV.shape == (num_evals, 3))
+    assert(len(params["eval_ids"]) == num_evals)
+    assert(params["cv_labels"] == ["x1", "x2", "x3"])
+    assert(params["function_labels"] == ["f1", "c1", "c2"])
+
+    fns = np.zeros((num_evals, 3))
+    fns[:, 0] = np.sum((x - 1.)**4, axis=1)
+    fns[:, 1] = x[:, 0] * x[:, 0] - x[:, 1] / 2.0
+    fns[:, 2] = x[:, 1] * x[:, 1] - x[:, 0] / 2.0
+
+    grads = np.zeros((num_evals, 3, num_vars))
+    grads[:, 0, :] = 4. * (x - 1.)**3
+    grads[:, 1, 0] = 2.0 * x[:, 0]
+    grads[:, 1, 1] = -0.5
+    grads[:, 2, 0] = -0.5
+    grads[:, 2, 1] = 2.0 * x[:, 1]
+
+    hessians = np.zeros((num_evals, 3, num_vars, num_vars))
+    for i in range(num_vars):
+        hessians[:, 0, i, i] = 12. * (x[:, i] - 1.)**2
+    hessians[:, 1, 0, 0] = 2.0
+    hessians[:, 2, 1, 1] = 2.0
+
+    metadata = np.tile([5., 10.], (num_evals, 1))
+
+    return {"fns": fns, "fnGrads": grads, "fnHessians": hessians,
+            "metadata": metadata}